@@ -82,6 +82,8 @@ namespace zs {
   /// @ref vittorio romeo, sy brand
   template <class Signature> struct function;
   template <class Signature> struct function_ref;
+  template <class Signature, size_t Capacity, size_t Alignment, bool Copyable, bool AllowHeap>
+  struct basic_function;
   namespace detail {
     struct function_ref_dummy {
       void foo();
@@ -210,6 +212,7 @@ namespace zs {
     }
     function &operator=(const function &o) {
       if (this != &o) {
+        if (_manageFn) (*_manageFn)(_storage.data(), nullptr, manage_op_e::destruct);
         if (o)
           o._manageFn(const_cast<void *>(o._storage.data()), _storage.data(), manage_op_e::clone);
         _erasedFn = o._erasedFn;
@@ -218,9 +221,12 @@ namespace zs {
       return *this;
     }
 
-    function(function &&o) noexcept { operator=(zs::move(o)); }
+    function(function &&o) noexcept : _storage{}, _erasedFn{nullptr}, _manageFn{nullptr} {
+      operator=(zs::move(o));
+    }
     function &operator=(function &&o) noexcept {
       if (this != &o) {
+        if (_manageFn) (*_manageFn)(_storage.data(), nullptr, manage_op_e::destruct);
         memcpy(_storage.data(), o._storage.data(), function_storage::capacity);
         _erasedFn = o._erasedFn;
         _manageFn = o._manageFn;
@@ -251,6 +257,175 @@ namespace zs {
     manager_fn *_manageFn = nullptr;
   };
 
+  namespace detail {
+    enum class callable_op_e { destruct = 0, copy, move };
+    /// 48 bytes hold a handful of views or scalars, the whole object spans one cache line
+    constexpr size_t function_default_capacity = 6 * sizeof(void *);
+    constexpr size_t function_default_alignment = alignof(long double);
+  }  // namespace detail
+
+  /// @brief type-erased callable kept in an inline buffer of [Capacity] bytes
+  /// @note [Copyable] false admits move-only callables. Callables that do not fit are not
+  /// accepted by the constructor unless [AllowHeap], in which case they are the only ones
+  /// allocated.
+  /// Relocation goes through the callable's move constructor, never memcpy.
+  template <class R, class... Args, size_t Capacity, size_t Alignment, bool Copyable,
+            bool AllowHeap>
+  struct basic_function<R(Args...), Capacity, Alignment, Copyable, AllowHeap> {
+    static_assert(Capacity >= sizeof(void *) && Alignment >= alignof(void *),
+                  "the inline buffer should at least hold a pointer");
+    static constexpr size_t capacity = Capacity;
+    static constexpr size_t alignment = Alignment;
+
+    using storage_type = InplaceStorage<Capacity, Alignment>;
+    using invoker_type = R(const void *, Args...);
+    using manager_type = void(void *dst, void *src, detail::callable_op_e);
+
+    struct noncopyable_tag {};
+
+    template <typename F> static constexpr bool fits_inline
+        = sizeof(F) <= Capacity && alignof(F) <= Alignment && is_nothrow_move_constructible_v<F>;
+
+    basic_function() noexcept = default;
+    basic_function(decltype(nullptr)) noexcept {}
+    ~basic_function() { reset(); }
+
+    template <typename F, typename Fd = decay_t<F>,
+              enable_if_t<!is_same_v<Fd, basic_function> && is_invocable_r_v<R, Fd &, Args...>
+                          && (!Copyable || is_copy_constructible_v<Fd>)
+                          && (AllowHeap || fits_inline<Fd>)>
+              = 0>
+    basic_function(F &&f) {
+      emplace(FWD(f));
+    }
+    template <typename F, typename Fd = decay_t<F>,
+              enable_if_t<!is_same_v<Fd, basic_function> && is_invocable_r_v<R, Fd &, Args...>
+                          && (!Copyable || is_copy_constructible_v<Fd>)
+                          && (AllowHeap || fits_inline<Fd>)>
+              = 0>
+    basic_function &operator=(F &&f) {
+      reset();
+      emplace(FWD(f));
+      return *this;
+    }
+
+    /// a copy constructor only when [Copyable], otherwise the copy operations stay deleted
+    basic_function(const conditional_t<Copyable, basic_function, noncopyable_tag> &o) {
+      if (o._manageFn) {
+        o._manageFn(_storage.data(), const_cast<void *>(o._storage.data()),
+                    detail::callable_op_e::copy);
+        _invokeFn = o._invokeFn;
+        _manageFn = o._manageFn;
+      }
+    }
+    basic_function &operator=(const conditional_t<Copyable, basic_function, noncopyable_tag> &o) {
+      if (this != &o) {
+        basic_function tmp{o};
+        *this = zs::move(tmp);
+      }
+      return *this;
+    }
+    basic_function(basic_function &&o) noexcept { take(o); }
+    basic_function &operator=(basic_function &&o) noexcept {
+      if (this != &o) {
+        reset();
+        take(o);
+      }
+      return *this;
+    }
+    basic_function &operator=(decltype(nullptr)) noexcept {
+      reset();
+      return *this;
+    }
+
+    void reset() noexcept {
+      if (_manageFn) _manageFn(_storage.data(), nullptr, detail::callable_op_e::destruct);
+      _invokeFn = nullptr;
+      _manageFn = nullptr;
+    }
+    void swap(basic_function &o) noexcept {
+      basic_function tmp{zs::move(o)};
+      o = zs::move(*this);
+      *this = zs::move(tmp);
+    }
+
+    explicit operator bool() const noexcept { return _invokeFn != nullptr; }
+
+    R operator()(Args... args) const {
+      if (!_invokeFn) throw StaticException();
+      return _invokeFn(_storage.data(), zs::forward<Args>(args)...);
+    }
+
+  private:
+    void take(basic_function &o) noexcept {
+      if (o._manageFn) {
+        o._manageFn(_storage.data(), o._storage.data(), detail::callable_op_e::move);
+        _invokeFn = o._invokeFn;
+        _manageFn = o._manageFn;
+        o._invokeFn = nullptr;
+        o._manageFn = nullptr;
+      }
+    }
+    template <typename F> void emplace(F &&f) {
+      using Fd = decay_t<F>;
+      if constexpr (fits_inline<Fd>) {
+        _storage.template create<Fd>(FWD(f));
+        _invokeFn = [](const void *self, Args... args) -> R {
+          return zs::invoke(*const_cast<Fd *>(static_cast<const Fd *>(self)),
+                            zs::forward<Args>(args)...);
+        };
+        _manageFn = [](void *dst, void *src, detail::callable_op_e op) {
+          switch (op) {
+            case detail::callable_op_e::destruct:
+              zs::destroy_at(static_cast<Fd *>(dst));
+              break;
+            case detail::callable_op_e::copy:
+              if constexpr (Copyable) ::new (dst) Fd(*static_cast<const Fd *>(src));
+              break;
+            case detail::callable_op_e::move:
+              ::new (dst) Fd(zs::move(*static_cast<Fd *>(src)));
+              zs::destroy_at(static_cast<Fd *>(src));
+              break;
+          }
+        };
+      } else {
+        static_assert(AllowHeap,
+                      "the callable does not fit the inline buffer or may throw when moved");
+        _storage.template create<Fd *>(::new Fd(FWD(f)));
+        _invokeFn = [](const void *self, Args... args) -> R {
+          return zs::invoke(**static_cast<Fd *const *>(self), zs::forward<Args>(args)...);
+        };
+        _manageFn = [](void *dst, void *src, detail::callable_op_e op) {
+          switch (op) {
+            case detail::callable_op_e::destruct:
+              ::delete *static_cast<Fd **>(dst);
+              break;
+            case detail::callable_op_e::copy:
+              if constexpr (Copyable)
+                ::new (dst) Fd *(::new Fd(**static_cast<Fd *const *>(src)));
+              break;
+            case detail::callable_op_e::move:
+              ::new (dst) Fd *(*static_cast<Fd **>(src));
+              break;
+          }
+        };
+      }
+    }
+
+    storage_type _storage{};
+    invoker_type *_invokeFn = nullptr;
+    manager_type *_manageFn = nullptr;
+  };
+
+  /// copyable, never allocates, oversized callables fail to compile
+  template <class Signature, size_t Capacity = detail::function_default_capacity,
+            size_t Alignment = detail::function_default_alignment>
+  using inplace_function = basic_function<Signature, Capacity, Alignment, true, false>;
+  /// move-only, only callables exceeding the inline buffer are allocated
+  template <class Signature, size_t Capacity = detail::function_default_capacity,
+            size_t Alignment = detail::function_default_alignment>
+  using unique_function = basic_function<Signature, Capacity, Alignment, false, true>;
+
   /// @note function_ref is assumed to always hold a valid reference
   template <class R, class... Args> struct function_ref<R(Args...)> {
     using non_member_callable_signature = R(Args...);
@@ -875,8 +875,10 @@ namespace zs {
   }  // namespace detail
   // template <typename T, typename... Args> struct is_nothrow_constructible
   //     : decltype(detail::is_nothrow_constructible_impl(declval<type_seq<T, Args...>>())) {};
+  /// the noexcept probes are only evaluated for constructible types
   template <typename T, typename... Args> struct is_nothrow_constructible
-      : detail::is_nothrow_constructible_impl<T, Args...> {};
+      : conditional_t<is_constructible_v<T, Args...>,
+                      detail::is_nothrow_constructible_impl<type_seq<T, Args...>>, false_type> {};
   template <typename T, typename... Args> constexpr bool is_nothrow_constructible_v
       = is_nothrow_constructible<T, Args...>::value;
 
@@ -492,6 +492,10 @@ namespace zs {
     template <typename Policy> void reset(Policy &&policy, value_type val);
     template <typename Policy, typename MapRange, bool Scatter = true>
     void reorderTiles(Policy &&pol, MapRange &&mapR, wrapv<Scatter> = {});
+    /// element-wise counterpart of reorderTiles, all channels are moved in a single pass
+    /// @note scatter: element i moves to map[i]; gather: element i is taken from map[i]
+    template <typename Policy, typename MapRange, bool Scatter = true>
+    void reorder(Policy &&pol, MapRange &&mapR, wrapv<Scatter> = {});
 
     constexpr channel_counter_type numProperties() const noexcept { return _tags.size(); }
 
@@ -533,6 +537,20 @@ namespace zs {
       }
       return -1;
     }
+    /// @brief resolve property [str] once, the handle is invalid if it does not exist
+    PropertyHandle resolve(const SmallString &str) const {
+      channel_counter_type offset = 0;
+      for (auto &&tag : _tags) {
+        if (str == tag.name) return PropertyHandle{(int)offset, (int)tag.numChannels};
+        offset += tag.numChannels;
+      }
+      return PropertyHandle{};
+    }
+    /// @brief auto [hx, hv] = tv.resolve("x", "v");
+    template <typename... Ts, enable_if_t<(sizeof...(Ts) > 1)> = 0>
+    auto resolve(const Ts &...strs) const {
+      return zs::make_tuple(resolve(SmallString{strs})...);
+    }
     constexpr PropertyTag getPropertyTag(size_t i = 0) const { return _tags[i]; }
     constexpr const auto &getPropertyTags() const { return _tags; }
 
@@ -690,6 +708,51 @@ namespace zs {
     *this = zs::move(orderedTiles);
   }
 
+  template <typename TileVectorView, typename MapIter, bool Scatter>
+  struct TileVectorElementReorder {
+    using size_type = typename TileVectorView::size_type;
+    using channel_counter_type = typename TileVectorView::channel_counter_type;
+    TileVectorElementReorder(TileVectorView elements, TileVectorView orderedElements, MapIter map)
+        : elements{elements}, orderedElements{orderedElements}, map{map} {}
+    constexpr void operator()(size_type i) {
+      const auto nchns = elements.numChannels();
+      const size_type j = map[i];
+      if constexpr (Scatter) {
+        for (channel_counter_type d = 0; d != nchns; ++d)
+          orderedElements(d, j) = elements(d, i);
+      } else {
+        for (channel_counter_type d = 0; d != nchns; ++d)
+          orderedElements(d, i) = elements(d, j);
+      }
+    }
+    TileVectorView elements, orderedElements;
+    MapIter map;
+  };
+  template <typename T, size_t Length, typename Allocator>
+  template <typename Policy, typename MapRange, bool Scatter>
+  void TileVector<T, Length, Allocator>::reorder(Policy &&pol, MapRange &&mapR, wrapv<Scatter>) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using Ti = RM_CVREF_T(*zs::begin(mapR));
+    static_assert(is_integral_v<Ti>,
+                  "index mapping range\'s dereferenced type is not an integral.");
+
+    const size_type sz = size();
+    if ((size_type)range_size(mapR) != sz)
+      throw std::runtime_error("index mapping range size mismatch");
+    if (!valid_memspace_for_execution(pol, get_allocator()))
+      throw std::runtime_error("current memory location not compatible with the execution policy");
+
+    TileVector orderedElements{get_allocator(), getPropertyTags(), sz};
+    {
+      auto elements = view<space>(*this);
+      auto oElements = view<space>(orderedElements);
+      auto mapIter = zs::begin(mapR);
+      pol(range(sz), TileVectorElementReorder<RM_CVREF_T(elements), RM_CVREF_T(mapIter), Scatter>{
+                         elements, oElements, mapIter});
+    }
+    *this = zs::move(orderedElements);
+  }
+
   template <execspace_e Space, typename TileVectorT, bool WithinTile, bool Base = false,
             typename = void>
   struct TileVectorUnnamedView {
@@ -1035,6 +1098,21 @@ namespace zs {
                               const size_type i, wrapt<TT>, index_sequence<Is...>) const noexcept {
       // using R = zs::vec<const value_type *, (int)Ns...>;
       using R = zs::vec<TT *, (int)Ns...>;
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      constexpr channel_counter_type d = sizeof...(Is);
+      if (chnOffset + d > _dims._numChannels) {
+        printf("tilevector [%s] ofb! mounting chn [%d, %d) out of [0, %d)\n", _nameTag.asChars(),
+               (int)chnOffset, (int)(chnOffset + d), (int)_dims._numChannels);
+        return R{
+            *(TT *)(detail::deduce_numeric_max<std::uintptr_t>() - sizeof(TT) * (Is + 1) + 1)...};
+      }
+      if (i >= (WithinTile ? (size_type)lane_width : _dims.size())) {
+        printf("tilevector [%s] ofb! mounting ele [%lld] out of [0, %lld)\n", _nameTag.asChars(),
+               (long long)i, (long long)(WithinTile ? (size_type)lane_width : _dims.size()));
+        return R{
+            *(TT *)(detail::deduce_numeric_max<std::uintptr_t>() - sizeof(TT) * (Is + 1) + 1)...};
+      }
+#endif
       if constexpr (WithinTile)
         return R{*((TT *)_vector + ((size_type)chnOffset + (size_type)Is) * (size_type)lane_width
                    + i)...};
@@ -1222,6 +1300,17 @@ namespace zs {
     constexpr bool hasProperty(const SmallString &propName) const noexcept {
       return propertyIndex(propName) != _N;
     }
+    /// @brief resolve [propName] once, then access through the returned handle
+    /// @note the name lookup reads the property names, only call where they are accessible
+    constexpr PropertyHandle resolve(const SmallString &propName) const noexcept {
+      auto propNo = propertyIndex(propName);
+      if (propNo == _N) return PropertyHandle{};
+      return PropertyHandle{(int)_tagOffsets[propNo], (int)_tagSizes[propNo]};
+    }
+    template <typename... Ts, enable_if_t<(sizeof...(Ts) > 1)> = 0>
+    constexpr auto resolve(const Ts &...propNames) const noexcept {
+      return zs::make_tuple(resolve(SmallString{propNames})...);
+    }
 
     using base_t::operator();
     using base_t::mount;
@@ -1235,6 +1324,7 @@ namespace zs {
               enable_if_all<!V, sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr std::add_lvalue_reference_t<TT> operator()(const SmallString &propName,
                                                          const channel_counter_type chn,
                                                          const size_type i,
@@ -1256,6 +1346,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr TT operator()(const SmallString &propName, const channel_counter_type chn,
                             const size_type i, wrapt<TT> = {}) const noexcept {
       auto propNo = propertyIndex(propName);
@@ -1275,6 +1366,7 @@ namespace zs {
               enable_if_all<!V, sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr std::add_lvalue_reference_t<TT> operator()(const SmallString &propName,
                                                          const size_type i,
                                                          wrapt<TT> = {}) noexcept {
@@ -1295,6 +1387,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr TT operator()(const SmallString &propName, const size_type i,
                             wrapt<TT> = {}) const noexcept {
       auto propNo = propertyIndex(propName);
@@ -1349,6 +1442,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto pack(value_seq<Ns...>, const SmallString &propName, const size_type i,
                         wrapt<TT> = {}) const noexcept {
       auto propNo = propertyIndex(propName);
@@ -1373,6 +1467,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto pack(const SmallString &propName, const size_type i,
                         wrapt<TT> = {}) const noexcept {
       return pack(dim_c<Ns...>, propName, i, wrapt<TT>{});
@@ -1382,6 +1477,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto pack(value_seq<Ns...>, const SmallString &propName,
                         const channel_counter_type chn, const size_type i,
                         wrapt<TT> = {}) const noexcept {
@@ -1408,12 +1504,14 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto pack(const SmallString &propName, const channel_counter_type chn,
                         const size_type i, wrapt<TT> = {}) const noexcept {
       return pack(dim_c<Ns...>, propName, chn, i, wrapt<TT>{});
     }
 
     template <channel_counter_type N, typename VT = value_type>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto array(const SmallString &propName, const size_type i) const noexcept {
       auto propNo = propertyIndex(propName);
 #if ZS_ENABLE_OFB_ACCESS_CHECK
@@ -1434,6 +1532,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto tuple(value_seq<Ns...>, const SmallString &propName, const size_type i,
                          wrapt<TT> = {}) const noexcept {
       auto propNo = propertyIndex(propName);
@@ -1455,6 +1554,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto tuple(const SmallString &propName, const size_type i,
                          wrapt<TT> = {}) const noexcept {
       return tuple(dim_c<d>, propName, i, wrapt<TT>{});
@@ -1464,6 +1564,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto tuple(value_seq<Ns...>, const SmallString &propName,
                          const channel_counter_type chn, const size_type i,
                          wrapt<TT> = {}) const noexcept {
@@ -1486,6 +1587,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto tuple(const SmallString &propName, const channel_counter_type chn,
                          const size_type i, wrapt<TT> = {}) const noexcept {
       return tuple(dim_c<d>, propName, chn, i, wrapt<TT>{});
@@ -1495,6 +1597,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto mount(value_seq<Ns...>, const SmallString &propName, const size_type i,
                          wrapt<TT> = {}) const noexcept {
       auto propNo = propertyIndex(propName);
@@ -1505,6 +1608,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto mount(const SmallString &propName, const size_type i,
                          wrapt<TT> = {}) const noexcept {
       return mount(dim_c<d>, propName, i, wrapt<TT>{});
@@ -1514,6 +1618,7 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto mount(value_seq<Ns...>, const SmallString &propName,
                          const channel_counter_type chn, const size_type i,
                          wrapt<TT> = {}) const noexcept {
@@ -1525,11 +1630,167 @@ namespace zs {
               enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
                             (alignof(TT) == alignof(value_type))>
               = 0>
+    ZS_NAMED_PROPERTY_ACCESS
     constexpr auto mount(const SmallString &propName, const channel_counter_type chn,
                          const size_type i, wrapt<TT> = {}) const noexcept {
       return mount(dim_c<d>, propName, chn, i, wrapt<TT>{});
     }
 
+    /// property handle access (see resolve), no name lookup
+    template <bool V = is_const_structure, typename TT = value_type,
+              enable_if_all<!V, sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr std::add_lvalue_reference_t<TT> operator()(const PropertyHandle &prop,
+                                                         const channel_counter_type chn,
+                                                         const size_type i,
+                                                         wrapt<TT> = {}) noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "operator()"))
+        return static_cast<base_t &>(*this)(_dims._numChannels, i, wrapt<TT>{});
+#endif
+      return static_cast<base_t &>(*this)(prop.offset + chn, i, wrapt<TT>{});
+    }
+    template <typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr TT operator()(const PropertyHandle &prop, const channel_counter_type chn,
+                            const size_type i, wrapt<TT> = {}) const noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "operator()"))
+        return static_cast<const base_t &>(*this)(_dims._numChannels, i, wrapt<TT>{});
+#endif
+      return static_cast<const base_t &>(*this)(prop.offset + chn, i, wrapt<TT>{});
+    }
+    template <bool V = is_const_structure, typename TT = value_type,
+              enable_if_all<!V, sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr std::add_lvalue_reference_t<TT> operator()(const PropertyHandle &prop,
+                                                         const size_type i,
+                                                         wrapt<TT> = {}) noexcept {
+      return operator()(prop, 0, i, wrapt<TT>{});
+    }
+    template <typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr TT operator()(const PropertyHandle &prop, const size_type i,
+                            wrapt<TT> = {}) const noexcept {
+      return operator()(prop, 0, i, wrapt<TT>{});
+    }
+
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(value_seq<Ns...>, const PropertyHandle &prop,
+                        const channel_counter_type chn, const size_type i,
+                        wrapt<TT> = {}) const noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn + (channel_counter_type)(Ns * ...) - 1, "pack"))
+        return static_cast<const base_t &>(*this).pack(dim_c<Ns...>, _dims._numChannels, i,
+                                                       wrapt<TT>{});
+#endif
+      return static_cast<const base_t &>(*this).pack(dim_c<Ns...>, prop.offset + chn, i,
+                                                     wrapt<TT>{});
+    }
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(value_seq<Ns...>, const PropertyHandle &prop, const size_type i,
+                        wrapt<TT> = {}) const noexcept {
+      return pack(dim_c<Ns...>, prop, 0, i, wrapt<TT>{});
+    }
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto pack(const PropertyHandle &prop, const size_type i,
+                        wrapt<TT> = {}) const noexcept {
+      return pack(dim_c<Ns...>, prop, 0, i, wrapt<TT>{});
+    }
+
+    template <channel_counter_type N, typename VT = value_type>
+    constexpr auto array(const PropertyHandle &prop, const size_type i) const noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, N - 1, "array"))
+        return static_cast<const base_t &>(*this).template array<N, VT>(_dims._numChannels, i);
+#endif
+      return static_cast<const base_t &>(*this).template array<N, VT>(prop.offset, i);
+    }
+
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(value_seq<Ns...>, const PropertyHandle &prop,
+                         const channel_counter_type chn, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn + (channel_counter_type)(Ns * ...) - 1, "tuple"))
+        return static_cast<const base_t &>(*this).tuple(dim_c<Ns...>, _dims._numChannels, i,
+                                                        wrapt<TT>{});
+#endif
+      return static_cast<const base_t &>(*this).tuple(dim_c<Ns...>, prop.offset + chn, i,
+                                                      wrapt<TT>{});
+    }
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(value_seq<Ns...>, const PropertyHandle &prop, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+      return tuple(dim_c<Ns...>, prop, 0, i, wrapt<TT>{});
+    }
+    template <auto d, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto tuple(const PropertyHandle &prop, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+      return tuple(dim_c<d>, prop, 0, i, wrapt<TT>{});
+    }
+
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto mount(value_seq<Ns...>, const PropertyHandle &prop,
+                         const channel_counter_type chn, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn + (channel_counter_type)(Ns * ...) - 1, "mount"))
+        return static_cast<const base_t &>(*this).mount(dim_c<Ns...>, _dims._numChannels, i,
+                                                        wrapt<TT>{});
+#endif
+      return static_cast<const base_t &>(*this).mount(dim_c<Ns...>, prop.offset + chn, i,
+                                                      wrapt<TT>{});
+    }
+    template <auto... Ns, typename TT = value_type,
+              enable_if_all<sizeof(TT) == sizeof(value_type), is_same_v<TT, remove_cvref_t<TT>>,
+                            (alignof(TT) == alignof(value_type))>
+              = 0>
+    constexpr auto mount(value_seq<Ns...>, const PropertyHandle &prop, const size_type i,
+                         wrapt<TT> = {}) const noexcept {
+      return mount(dim_c<Ns...>, prop, 0, i, wrapt<TT>{});
+    }
+
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+    constexpr bool handle_ofb(const PropertyHandle &prop, channel_counter_type lastChn,
+                              const char *op) const noexcept {
+      if (prop.valid() && lastChn < prop.size) return false;
+      printf(
+          "tilevector [%s] ofb! (%s) accessing channel %d of property handle (offset %d, size %d) "
+          "(%d chns, %lld eles) in total\n",
+          _nameTag.asChars(), op, (int)lastChn, prop.offset, prop.size, (int)_dims._numChannels,
+          (long long int)_dims.size());
+      return true;
+    }
+#endif
+
     const SmallString *_tagNames{nullptr};
     const channel_counter_type *_tagOffsets{nullptr};
     const channel_counter_type *_tagSizes{nullptr};
@@ -0,0 +1,401 @@
+#pragma once
+#include <cstring>
+#include <thread>
+#include <vector>
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include "TileVector.hpp"
+#include "Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/Vec.h"
+#include "zensim/memory/BulkMemOps.hpp"
+
+namespace zs {
+
+  /// @brief raw channel-strided buffer, channel [chn] of element [i] is stored at
+  /// data[(i / laneWidth * numChannels + chn) * laneWidth + i % laneWidth]
+  /// @note AoS (e.g. Vector<vec<T, N>>) is the case laneWidth == 1, SoA (one array per channel)
+  /// the case laneWidth == element count, i.e. a single tile
+  template <typename T> struct AoSoALayout {
+    using value_type = remove_const_t<T>;
+    using size_type = size_t;
+
+    constexpr T *address(int chn, size_type i) const noexcept {
+      return data + ((i / laneWidth * numChannels + chn) * laneWidth + i % laneWidth);
+    }
+
+    T *data{nullptr};
+    size_type laneWidth{1};
+    int numChannels{1};
+  };
+
+  template <typename T> constexpr AoSoALayout<T> make_aos_layout(T *data, int numChannels) {
+    return AoSoALayout<T>{data, (size_t)1, numChannels};
+  }
+  template <typename T>
+  constexpr AoSoALayout<T> make_soa_layout(T *data, int numChannels, size_t count) {
+    return AoSoALayout<T>{data, count > 0 ? count : (size_t)1, numChannels};
+  }
+  template <typename T>
+  constexpr AoSoALayout<T> make_aosoa_layout(T *data, size_t laneWidth, int numChannels) {
+    return AoSoALayout<T>{data, laneWidth, numChannels};
+  }
+
+  template <typename T, size_t Length, typename Allocator>
+  AoSoALayout<T> layout_of(TileVector<T, Length, Allocator> &tv) {
+    return AoSoALayout<T>{tv.data(), Length, tv.numChannels()};
+  }
+  template <typename T, size_t Length, typename Allocator>
+  AoSoALayout<const T> layout_of(const TileVector<T, Length, Allocator> &tv) {
+    return AoSoALayout<const T>{tv.data(), Length, tv.numChannels()};
+  }
+  template <typename T, typename Allocator> auto layout_of(Vector<T, Allocator> &vs) {
+    if constexpr (is_vec_v<T>) {
+      using value_type = typename T::value_type;
+      static_assert(sizeof(T) == sizeof(value_type) * T::extent, "vec is not tightly packed");
+      return make_aos_layout((value_type *)vs.data(), (int)T::extent);
+    } else
+      return make_aos_layout(vs.data(), 1);
+  }
+  template <typename T, typename Allocator> auto layout_of(const Vector<T, Allocator> &vs) {
+    if constexpr (is_vec_v<T>) {
+      using value_type = typename T::value_type;
+      static_assert(sizeof(T) == sizeof(value_type) * T::extent, "vec is not tightly packed");
+      return make_aos_layout((const value_type *)vs.data(), (int)T::extent);
+    } else
+      return make_aos_layout(vs.data(), 1);
+  }
+
+  namespace detail {
+    /// elements x channels moved per task, the staging tile stays within L1
+    constexpr size_t layout_block_elements = 256;
+    constexpr int layout_block_channels = 16;
+    /// lane widths below this are accessed element-wise (all channels of an element at once)
+    constexpr size_t layout_narrow_lane_width = 8;
+    /// destinations larger than this (roughly the last level cache) bypass the cache, provided
+    /// that a destination run spans several whole cache lines
+    constexpr size_t layout_streaming_bytes = (size_t)1 << 25;
+    constexpr size_t layout_streaming_run_bytes = 256;
+
+    template <bool Stream, typename Ti, typename To>
+    inline void layout_copy_run(const Ti *__restrict src, To *__restrict dst, size_t cnt) {
+      if constexpr (Stream) {
+#if defined(__SSE2__)
+        constexpr size_t chunk = 64;
+        for (size_t k0 = 0; k0 < cnt; k0 += chunk) {
+          const size_t m = cnt - k0 < chunk ? cnt - k0 : chunk;
+          alignas(16) To tmp[chunk];
+#  if defined(_OPENMP)
+#    pragma omp simd
+#  endif
+          for (size_t k = 0; k < m; ++k) tmp[k] = static_cast<To>(src[k0 + k]);
+          stream_copy_bytes(dst + k0, tmp, m * sizeof(To));
+        }
+#else
+#  if defined(_OPENMP) && _OPENMP >= 201811
+#    pragma omp simd nontemporal(dst)
+#  elif defined(_OPENMP)
+#    pragma omp simd
+#  endif
+        for (size_t k = 0; k < cnt; ++k) dst[k] = static_cast<To>(src[k]);
+#endif
+      } else {
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+        for (size_t k = 0; k < cnt; ++k) dst[k] = static_cast<To>(src[k]);
+      }
+    }
+
+    /// @brief moves channels [srcChn, srcChn + numChns) of elements [i0, i1) of [src] to the
+    /// channels starting at [dstChn] of [dst]
+    /// @note contiguous runs (bounded by the tiles of both sides) are copied directly, a narrow
+    /// side is transposed through a small staging tile instead (i1 - i0 <= layout_block_elements)
+    template <bool Stream, typename Ti, typename To>
+    void transpose_layout_block(const AoSoALayout<const Ti> &src, int srcChn,
+                                const AoSoALayout<To> &dst, int dstChn, int numChns, size_t i0,
+                                size_t i1) {
+      const size_t ls = src.laneWidth, ld = dst.laneWidth;
+      // tile strides, the (tile, lane) position of i0 is advanced incrementally from here on
+      const size_t ss = ls * src.numChannels, sd = ld * dst.numChannels;
+      const size_t ts0 = i0 / ls, os0 = i0 % ls, td0 = i0 / ld, od0 = i0 % ld;
+      const bool srcNarrow = ls < layout_narrow_lane_width;
+      const bool dstNarrow = ld < layout_narrow_lane_width;
+      if (!srcNarrow && !dstNarrow && !Stream) {
+        for (int c = 0; c != numChns; ++c) {
+          const Ti *s = src.data + (srcChn + c) * ls;
+          To *d = dst.data + (dstChn + c) * ld;
+          for (size_t i = i0, ts = ts0, os = os0, td = td0, od = od0; i < i1;) {
+            size_t cnt = i1 - i;
+            if (ls - os < cnt) cnt = ls - os;
+            if (ld - od < cnt) cnt = ld - od;
+            layout_copy_run<Stream>(s + ts * ss + os, d + td * sd + od, cnt);
+            i += cnt;
+            if ((os += cnt) == ls) os = 0, ++ts;
+            if ((od += cnt) == ld) od = 0, ++td;
+          }
+        }
+        return;
+      }
+      To buf[layout_block_channels][layout_block_elements];
+      const size_t cnt = i1 - i0;
+      for (int c0 = 0; c0 < numChns; c0 += layout_block_channels) {
+        const int cb = numChns - c0 < layout_block_channels ? numChns - c0 : layout_block_channels;
+        // gather into the staging tile
+        if (srcNarrow) {
+          const Ti *s = src.data + (srcChn + c0) * ls;
+          for (size_t k = 0, ts = ts0, os = os0; k != cnt; ++k) {
+            const Ti *e = s + ts * ss + os;
+            for (int c = 0; c != cb; ++c) buf[c][k] = static_cast<To>(e[c * ls]);
+            if (++os == ls) os = 0, ++ts;
+          }
+        } else {
+          for (int c = 0; c != cb; ++c) {
+            const Ti *s = src.data + (srcChn + c0 + c) * ls;
+            for (size_t k = 0, ts = ts0, os = os0; k < cnt;) {
+              const size_t run = cnt - k < ls - os ? cnt - k : ls - os;
+              layout_copy_run<false>(s + ts * ss + os, buf[c] + k, run);
+              k += run;
+              os = 0, ++ts;
+            }
+          }
+        }
+        // scatter to the destination
+        if (dstNarrow) {
+          To *d = dst.data + (dstChn + c0) * ld;
+          for (size_t k = 0, td = td0, od = od0; k != cnt; ++k) {
+            To *e = d + td * sd + od;
+            for (int c = 0; c != cb; ++c) e[c * ld] = buf[c][k];
+            if (++od == ld) od = 0, ++td;
+          }
+        } else {
+          for (int c = 0; c != cb; ++c) {
+            To *d = dst.data + (dstChn + c0 + c) * ld;
+            for (size_t k = 0, td = td0, od = od0; k < cnt;) {
+              const size_t run = cnt - k < ld - od ? cnt - k : ld - od;
+              layout_copy_run<Stream>(buf[c] + k, d + td * sd + od, run);
+              k += run;
+              od = 0, ++td;
+            }
+          }
+        }
+      }
+    }
+  }  // namespace detail
+
+  /// @brief copies (and converts) channels [srcChn, srcChn + numChns) of the first [n] elements
+  /// of [src] to channels [dstChn, dstChn + numChns) of [dst], the two layouts may differ in
+  /// lane width (AoS, SoA or AoSoA) and value type
+  /// @note both buffers must be accessible from [pol] and must not overlap. On host the elements
+  /// are moved in cache-sized blocks in parallel, destinations that do not fit in cache are
+  /// written with non-temporal stores.
+  template <typename ExecPol, typename Ti, typename To>
+  void transpose_layout(ExecPol &&pol, AoSoALayout<const Ti> src, int srcChn, AoSoALayout<To> dst,
+                        int dstChn, int numChns, size_t n) {
+    static_assert(!is_const_v<To>, "destination layout should be writable");
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = size_t;
+    if (srcChn < 0 || dstChn < 0 || numChns < 0 || srcChn + numChns > src.numChannels
+        || dstChn + numChns > dst.numChannels)
+      throw std::runtime_error(fmt::format(
+          "[transpose_layout] channel range [{}, {}) -> [{}, {}) out of bound ({} -> {} channels)",
+          srcChn, srcChn + numChns, dstChn, dstChn + numChns, src.numChannels, dst.numChannels));
+    if (n == 0 || numChns == 0) return;
+
+    if constexpr (is_host_execution<space>()) {
+      constexpr size_type block = detail::layout_block_elements;
+      const bool stream = dst.laneWidth * sizeof(To) >= detail::layout_streaming_run_bytes
+                          && n * numChns * sizeof(To) >= detail::layout_streaming_bytes;
+      auto blockKernel = [=](auto stream_c) {
+        return [=](size_type b) {
+          const size_type i0 = b * block, i1 = i0 + block < n ? i0 + block : n;
+          detail::transpose_layout_block<RM_CVREF_T(stream_c)::value>(src, srcChn, dst, dstChn,
+                                                                       numChns, i0, i1);
+#if defined(__SSE2__)
+          if constexpr (RM_CVREF_T(stream_c)::value) _mm_sfence();
+#endif
+        };
+      };
+      if (stream)
+        pol(range((n + block - 1) / block), blockKernel(true_c));
+      else
+        pol(range((n + block - 1) / block), blockKernel(false_c));
+    } else {
+      pol(range(n), [src, srcChn, dst, dstChn, numChns] ZS_LAMBDA(size_type i) mutable {
+        for (int c = 0; c != numChns; ++c)
+          *dst.address(dstChn + c, i) = static_cast<To>(*src.address(srcChn + c, i));
+      });
+    }
+  }
+  template <typename ExecPol, typename Ti, typename To>
+  void transpose_layout(ExecPol &&pol, AoSoALayout<Ti> src, int srcChn, AoSoALayout<To> dst,
+                        int dstChn, int numChns, size_t n) {
+    transpose_layout(FWD(pol), AoSoALayout<const Ti>{src.data, src.laneWidth, src.numChannels},
+                     srcChn, dst, dstChn, numChns, n);
+  }
+
+  namespace detail {
+    template <typename TileVectorT>
+    PropertyHandle resolve_layout_property(const TileVectorT &tv, const SmallString &tag,
+                                           const char *fn) {
+      const auto handle = tv.resolve(tag);
+      if (!handle)
+        throw std::runtime_error(
+            fmt::format("[{}] property \"{}\" does not exist", fn, tag.asChars()));
+      return handle;
+    }
+  }  // namespace detail
+
+  /// @brief copies properties [tags] of [src] to the same-named properties of [dst], which may
+  /// differ in lane width and value type (e.g. double, 8 lanes -> float, 32 lanes)
+  /// @note [dst] is resized to the size of [src] (its other properties are left untouched)
+  template <typename ExecPol, typename Ti, size_t Ls, typename AllocatorS, typename To, size_t Ld,
+            typename AllocatorD>
+  void copy_properties(ExecPol &&pol, const TileVector<Ti, Ls, AllocatorS> &src,
+                       TileVector<To, Ld, AllocatorD> &dst, const std::vector<SmallString> &tags) {
+    if (!valid_memspace_for_execution(pol, src.get_allocator())
+        || !valid_memspace_for_execution(pol, dst.get_allocator()))
+      throw std::runtime_error(
+          "[copy_properties] current memory location not compatible with the execution policy");
+    const auto n = src.size();
+    if (dst.size() != n) dst.resize(n);
+    for (const auto &tag : tags) {
+      const auto hs = detail::resolve_layout_property(src, tag, "copy_properties");
+      const auto hd = detail::resolve_layout_property(dst, tag, "copy_properties");
+      if (hs.size != hd.size)
+        throw std::runtime_error(
+            fmt::format("[copy_properties] property \"{}\" has {} channels in src but {} in dst",
+                        tag.asChars(), hs.size, hd.size));
+      transpose_layout(pol, layout_of(src), hs.offset, layout_of(dst), hd.offset, hs.size, n);
+    }
+  }
+
+  /// @brief property [tag] of [src] to the AoS array [dst] (resized to the size of [src])
+  template <typename ExecPol, typename Ti, size_t Length, typename AllocatorS, typename VecT,
+            typename AllocatorD>
+  void copy_property(ExecPol &&pol, const TileVector<Ti, Length, AllocatorS> &src,
+                     const SmallString &tag, Vector<VecT, AllocatorD> &dst) {
+    if (!valid_memspace_for_execution(pol, src.get_allocator())
+        || !valid_memspace_for_execution(pol, dst.get_allocator()))
+      throw std::runtime_error(
+          "[copy_property] current memory location not compatible with the execution policy");
+    const auto h = detail::resolve_layout_property(src, tag, "copy_property");
+    const auto n = src.size();
+    if (dst.size() != n) dst.resize(n);
+    transpose_layout(pol, layout_of(src), h.offset, layout_of(dst), 0, h.size, n);
+  }
+  /// @brief the AoS array [src] to property [tag] of [dst] (resized to the size of [src])
+  template <typename ExecPol, typename VecT, typename AllocatorS, typename To, size_t Length,
+            typename AllocatorD>
+  void copy_property(ExecPol &&pol, const Vector<VecT, AllocatorS> &src,
+                     TileVector<To, Length, AllocatorD> &dst, const SmallString &tag) {
+    if (!valid_memspace_for_execution(pol, src.get_allocator())
+        || !valid_memspace_for_execution(pol, dst.get_allocator()))
+      throw std::runtime_error(
+          "[copy_property] current memory location not compatible with the execution policy");
+    const auto h = detail::resolve_layout_property(dst, tag, "copy_property");
+    const auto n = src.size();
+    if (dst.size() != n) dst.resize(n);
+    transpose_layout(pol, layout_of(src), 0, layout_of(dst), h.offset, h.size, n);
+  }
+  /// @brief property [tag] of [src] to an external buffer (e.g. make_soa_layout(ptr, 3, n)),
+  /// starting at channel [dstChn]
+  template <typename ExecPol, typename Ti, size_t Length, typename Allocator, typename To>
+  void copy_property(ExecPol &&pol, const TileVector<Ti, Length, Allocator> &src,
+                     const SmallString &tag, AoSoALayout<To> dst, int dstChn = 0) {
+    if (!valid_memspace_for_execution(pol, src.get_allocator()))
+      throw std::runtime_error(
+          "[copy_property] current memory location not compatible with the execution policy");
+    const auto h = detail::resolve_layout_property(src, tag, "copy_property");
+    transpose_layout(pol, layout_of(src), h.offset, dst, dstChn, h.size, src.size());
+  }
+  /// @brief the first dst.size() elements of an external buffer, starting at channel [srcChn],
+  /// to property [tag] of [dst]
+  template <typename ExecPol, typename Ti, typename To, size_t Length, typename Allocator>
+  void copy_property(ExecPol &&pol, AoSoALayout<Ti> src, int srcChn,
+                     TileVector<To, Length, Allocator> &dst, const SmallString &tag) {
+    if (!valid_memspace_for_execution(pol, dst.get_allocator()))
+      throw std::runtime_error(
+          "[copy_property] current memory location not compatible with the execution policy");
+    const auto h = detail::resolve_layout_property(dst, tag, "copy_property");
+    transpose_layout(pol, src, srcChn, layout_of(dst), h.offset, h.size, dst.size());
+  }
+
+  /// @brief converts [tv] to a tile vector of [NewLength] lanes (and value type [To] if given)
+  template <size_t NewLength, typename To = void, typename ExecPol, typename T, size_t Length,
+            typename Allocator>
+  auto retile(ExecPol &&pol, const TileVector<T, Length, Allocator> &tv) {
+    using value_type = conditional_t<is_void_v<To>, T, To>;
+    if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+      throw std::runtime_error(
+          "[retile] current memory location not compatible with the execution policy");
+    TileVector<value_type, NewLength, Allocator> ret{tv.get_allocator(), tv.getPropertyTags(),
+                                                     tv.size()};
+    transpose_layout(pol, layout_of(tv), 0, layout_of(ret), 0, tv.numChannels(), tv.size());
+    return ret;
+  }
+  /// @brief in-place variant, the buffer of [tv] is transposed and taken over by the result
+  /// @note elements [k * B, (k + 1) * B) (B = lcm(Length, NewLength)) occupy the same span of
+  /// the buffer in both layouts, so every such block is transposed independently. Blocks are
+  /// processed in batches staged in a temporary buffer of a fraction of the size, no second
+  /// full-size buffer is needed. Only on host, other execution spaces fall back to the copying
+  /// variant.
+  template <size_t NewLength, typename ExecPol, typename T, size_t Length, typename Allocator>
+  TileVector<T, NewLength, Allocator> retile(ExecPol &&pol,
+                                             TileVector<T, Length, Allocator> &&tv) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = size_t;
+    if constexpr (!is_host_execution<space>()) {
+      auto ret = retile<NewLength>(pol, static_cast<const TileVector<T, Length, Allocator> &>(tv));
+      tv = TileVector<T, Length, Allocator>{tv.get_allocator(), tv.getPropertyTags(), 0};
+      return ret;
+    } else {
+      if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+        throw std::runtime_error(
+            "[retile] current memory location not compatible with the execution policy");
+      constexpr size_type block = math::lcm(Length, NewLength);
+      const size_type n = tv.size();
+      const int nchns = tv.numChannels();
+      const size_type blockValues = block * nchns;
+      const size_type numBlocks = (n + block - 1) / block;
+
+      auto &buffer = tv.refBuffer();
+      if (buffer.size() < numBlocks * blockValues) buffer.resize(numBlocks * blockValues);
+      if constexpr (Length != NewLength) {
+        // at most 1/16 of the blocks per batch, but enough to keep every thread busy
+        const size_type minBatch = ((size_type)std::thread::hardware_concurrency() + 1) * 16;
+        size_type batch = numBlocks / 16 > minBatch ? numBlocks / 16 : minBatch;
+        if (batch > numBlocks) batch = numBlocks;
+        Vector<T> scratch{get_temporary_memory_source(pol), batch * blockValues};
+        for (size_type st = 0; st < numBlocks; st += batch)
+          pol(range(numBlocks - st < batch ? numBlocks - st : batch),
+              [data = buffer.data(), stage = scratch.data(), st, n, nchns,
+               blockValues](size_type k) {
+                const size_type b = st + k;
+                T *base = data + b * blockValues;
+                T *staged = stage + k * blockValues;
+                std::memcpy(staged, base, sizeof(T) * blockValues);
+                const size_type cnt = n - b * block < block ? n - b * block : block;
+                for (size_type i = 0; i < cnt; i += detail::layout_block_elements)
+                  detail::transpose_layout_block<false>(
+                      AoSoALayout<const T>{staged, Length, nchns}, 0,
+                      AoSoALayout<T>{base, NewLength, nchns}, 0, nchns, i,
+                      cnt - i < detail::layout_block_elements
+                          ? cnt
+                          : i + detail::layout_block_elements);
+              });
+      }
+
+      TileVector<T, NewLength, Allocator> ret{tv.get_allocator(), tv.getPropertyTags(), 0};
+      ret.refBuffer() = zs::move(buffer);
+      ret.refSize() = n;
+      ret.refBuffer().resize(TileVector<T, NewLength, Allocator>::count_tiles(n) * NewLength
+                             * nchns);
+      tv = TileVector<T, Length, Allocator>{tv.get_allocator(), tv.getPropertyTags(), 0};
+      return ret;
+    }
+  }
+
+}  // namespace zs
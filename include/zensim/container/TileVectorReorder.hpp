@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+
+#include "TileVector.hpp"
+#include "Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/bit/Bits.h"
+
+namespace zs {
+
+  enum class sfc_e : int { morton = 0, hilbert };
+
+  /// @brief space-filling curve keys of the 3d positions stored in property [posTag]
+  /// @note positions are binned into cells of size [dx] starting at [origin] (at most 2^21 per
+  /// axis), pass the grid block size as [dx] to order the elements by grid block
+  template <typename ExecPol, typename T, size_t Length, typename Allocator, typename VecT,
+            typename KeyAllocator>
+  void compute_sfc_keys(ExecPol &&pol, const TileVector<T, Length, Allocator> &tv,
+                        const SmallString &posTag, const VecT &origin, T dx,
+                        Vector<u64, KeyAllocator> &keys, sfc_e curve = sfc_e::morton) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    if (!valid_memspace_for_execution(pol, tv.get_allocator())
+        || !valid_memspace_for_execution(pol, keys.get_allocator()))
+      throw std::runtime_error(
+          "[compute_sfc_keys] current memory location not compatible with the execution policy");
+    const auto h = tv.resolve(posTag);
+    if (!h || h.size != 3)
+      throw std::runtime_error(fmt::format(
+          "[compute_sfc_keys] property \"{}\" does not exist or is not 3-dimensional",
+          posTag.asChars()));
+    const auto n = tv.size();
+    if (keys.size() != n) keys.resize(n);
+    const vec<T, 3> o{(T)origin[0], (T)origin[1], (T)origin[2]};
+    pol(range(n), [tvv = view<space>(tv), ks = view<space>(keys), offset = h.offset, o,
+                   dxInv = (T)1 / dx, curve] ZS_LAMBDA(size_t i) mutable {
+      constexpr T maxCoord = (T)(((u32)1 << 21) - 1);
+      const auto x = tvv.pack(dim_c<3>, offset, i);
+      u32 c[3];
+      for (int d = 0; d != 3; ++d) {
+        T v = (x[d] - o[d]) * dxInv;
+        v = v < 0 ? (T)0 : (v > maxCoord ? maxCoord : v);
+        c[d] = (u32)v;
+      }
+      ks[i] = curve == sfc_e::hilbert ? hilbert_3d_index_64(c[0], c[1], c[2])
+                                      : morton_3d_index_64(c[0], c[1], c[2]);
+    });
+  }
+
+  namespace detail {
+    /// nearly sorted input is merged instead of sorted once at most this share is out of order
+    constexpr size_t reorder_max_displaced_ratio = 8;
+
+    /// splits [keys] into a non-decreasing subsequence [kept] and the rest [displaced], an
+    /// out-of-order pair drops both elements (at most twice the minimal number of removals)
+    /// @return false once more than [maxDisplaced] elements are displaced
+    template <typename KeyT, typename IndexT>
+    bool split_sorted_subsequence(const KeyT *keys, size_t n, IndexT *kept, size_t &numKept,
+                                  IndexT *displaced, size_t &numDisplaced, size_t maxDisplaced) {
+      numKept = numDisplaced = 0;
+      for (size_t i = 0; i != n; ++i) {
+        if (numKept == 0 || !(keys[i] < keys[kept[numKept - 1]]))
+          kept[numKept++] = (IndexT)i;
+        else {
+          if (numDisplaced + 2 > maxDisplaced) return false;
+          displaced[numDisplaced++] = kept[--numKept];
+          displaced[numDisplaced++] = (IndexT)i;
+        }
+      }
+      return true;
+    }
+  }  // namespace detail
+
+  /// @brief stable reorder of the elements of [tv] (and of [keys]) by ascending [keys], all
+  /// channels are moved out-of-place in a single pass
+  /// @note [newToOld][i] is the previous index of the element now at i, [oldToNew] its inverse.
+  /// Containers indexing the elements are remapped through these, e.g.
+  /// other.reorder(pol, range(newToOld), false_c) for another tile vector of the same size.
+  /// With [incremental] and a sequential policy, keys still close to the previous order (e.g.
+  /// those of the last frame) are merged in linear time instead of being fully sorted. Parallel
+  /// policies always take the radix sort, the serial merge would only idle their threads.
+  /// @return false if the elements were left in place (keys found in order, sequential
+  /// incremental only)
+  template <typename ExecPol, typename T, size_t Length, typename Allocator, typename KeyT,
+            typename KeyAllocator, typename IndexT, typename IndexAllocator>
+  bool reorder_by_keys(ExecPol &&pol, TileVector<T, Length, Allocator> &tv,
+                       Vector<KeyT, KeyAllocator> &keys, Vector<IndexT, IndexAllocator> &newToOld,
+                       Vector<IndexT, IndexAllocator> &oldToNew, bool incremental = true) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_integral_v<KeyT> && is_integral_v<IndexT>,
+                  "keys and indices should both be integral");
+    if (!valid_memspace_for_execution(pol, tv.get_allocator())
+        || !valid_memspace_for_execution(pol, keys.get_allocator())
+        || !valid_memspace_for_execution(pol, newToOld.get_allocator()))
+      throw std::runtime_error(
+          "[reorder_by_keys] current memory location not compatible with the execution policy");
+    const size_t n = tv.size();
+    if (keys.size() != n)
+      throw std::runtime_error(fmt::format(
+          "[reorder_by_keys] {} keys provided for {} elements", keys.size(), n));
+    if (newToOld.size() != n) newToOld.resize(n);
+    if (oldToNew.size() != n) oldToNew.resize(n);
+
+    bool sorted = false;
+    if constexpr (space == execspace_e::host) {
+      if (incremental) {
+        const size_t maxDisplaced = n / detail::reorder_max_displaced_ratio + 2;
+        Vector<IndexT, IndexAllocator> displaced{newToOld.get_allocator(), maxDisplaced};
+        size_t numKept = 0, numDisplaced = 0;
+        if (detail::split_sorted_subsequence(keys.data(), n, oldToNew.data(), numKept,
+                                             displaced.data(), numDisplaced, maxDisplaced)) {
+          if (numDisplaced == 0) {
+            pol(range(n), [n2o = view<space>(newToOld), o2n = view<space>(oldToNew)] ZS_LAMBDA(
+                              size_t i) mutable { n2o[i] = o2n[i] = (IndexT)i; });
+            return false;
+          }
+          // (key, index) is a total order, which keeps the merge stable
+          const KeyT *ks = keys.data();
+          auto byKey = [ks](IndexT a, IndexT b) {
+            return ks[a] < ks[b] || (!(ks[b] < ks[a]) && a < b);
+          };
+          std::sort(displaced.data(), displaced.data() + numDisplaced, byKey);
+          std::merge(oldToNew.data(), oldToNew.data() + numKept, displaced.data(),
+                     displaced.data() + numDisplaced, newToOld.data(), byKey);
+          sorted = true;
+        }
+      }
+    }
+    Vector<KeyT, KeyAllocator> sortedKeys{keys.get_allocator(), n};
+    if (!sorted) {
+      pol(range(n), [o2n = view<space>(oldToNew)] ZS_LAMBDA(size_t i) mutable {
+        o2n[i] = (IndexT)i;
+      });
+      radix_sort_pair(pol, keys.begin(), oldToNew.begin(), sortedKeys.begin(), newToOld.begin(),
+                      n);
+    } else
+      pol(range(n), [ks = view<space>(keys), sks = view<space>(sortedKeys),
+                     n2o = view<space>(newToOld)] ZS_LAMBDA(size_t i) mutable {
+        sks[i] = ks[n2o[i]];
+      });
+    keys = zs::move(sortedKeys);
+
+    pol(range(n), [n2o = view<space>(newToOld), o2n = view<space>(oldToNew)] ZS_LAMBDA(
+                      size_t i) mutable { o2n[n2o[i]] = (IndexT)i; });
+    tv.reorder(pol, range(newToOld), false_c);
+    return true;
+  }
+
+}  // namespace zs
@@ -9,8 +9,10 @@
 #include <queue>
 #include <shared_mutex>
 #include <thread>
+#include <vector>
 
 #include "zensim/TypeAlias.hpp"
+#include "zensim/execution/ConcurrencyPrimitive.hpp"
 #include "zensim/types/Optional.h"
 
 namespace zs {
@@ -19,78 +21,287 @@ namespace zs {
     return std::async(std::launch::async, forward<F>(f), forward<Ts>(params)...);
   }
 
-  /// <<C++ concurrency in action>>
-  template <typename T> class threadsafe_queue {
-  private:
-    mutable std::mutex mut;
-    std::queue<T> data_queue;
-    std::condition_variable data_cond;
+  namespace detail {
+    /// futex-backed event, waiters re-evaluate their predicate after every notification
+    struct queue_wait_event {
+      void notify(int count = 1) noexcept {
+        // pairs with the fence in wait(), either the waiter sees the new state or this thread
+        // sees the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_numWaiters.load(std::memory_order_relaxed) == 0) return;
+        _epoch.fetch_add(1, std::memory_order_release);
+        Futex::wake(&_epoch, count);
+      }
+      template <typename Pred> void wait(Pred &&pred) {
+        for (int i = 0; i != 64; ++i) {
+          if (pred()) return;
+          std::this_thread::yield();
+        }
+        for (;;) {
+          const u32 epoch = _epoch.load(std::memory_order_acquire);
+          _numWaiters.fetch_add(1, std::memory_order_seq_cst);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (pred()) {
+            _numWaiters.fetch_sub(1, std::memory_order_relaxed);
+            return;
+          }
+          Futex::wait(&_epoch, epoch);
+          _numWaiters.fetch_sub(1, std::memory_order_relaxed);
+          if (pred()) return;
+        }
+      }
 
+      std::atomic<u32> _epoch{0};
+      std::atomic<u32> _numWaiters{0};
+    };
+
+    /// @note ref: Dmitry Vyukov, bounded MPMC queue
+    /// every cell carries a sequence number telling producers and consumers whose turn it is
+    template <typename T> struct mpmc_ring {
+      struct Cell {
+        std::atomic<size_t> _seq;
+        alignas(T) unsigned char _storage[sizeof(T)];
+      };
+
+      explicit mpmc_ring(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        _mask = cap - 1;
+        _cells = std::make_unique<Cell[]>(cap);
+        for (size_t i = 0; i != cap; ++i) _cells[i]._seq.store(i, std::memory_order_relaxed);
+      }
+      ~mpmc_ring() {
+        for (size_t pos = _deqPos.load(std::memory_order_relaxed),
+                    ed = _enqPos.load(std::memory_order_relaxed);
+             pos != ed; ++pos)
+          reinterpret_cast<T *>(_cells[pos & _mask]._storage)->~T();
+      }
+      mpmc_ring(const mpmc_ring &) = delete;
+      mpmc_ring &operator=(const mpmc_ring &) = delete;
+
+      template <typename... Args> bool try_emplace(Args &&...args) {
+        Cell *cell;
+        size_t pos = _enqPos.load(std::memory_order_relaxed);
+        for (;;) {
+          cell = &_cells[pos & _mask];
+          const size_t seq = cell->_seq.load(std::memory_order_acquire);
+          const auto dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+          if (dif == 0) {
+            if (_enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+          } else if (dif < 0)
+            return false;  // full
+          else
+            pos = _enqPos.load(std::memory_order_relaxed);
+        }
+        ::new (cell->_storage) T(FWD(args)...);
+        cell->_seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+      bool try_pop(T &value) {
+        Cell *cell;
+        size_t pos = _deqPos.load(std::memory_order_relaxed);
+        for (;;) {
+          cell = &_cells[pos & _mask];
+          const size_t seq = cell->_seq.load(std::memory_order_acquire);
+          const auto dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+          if (dif == 0) {
+            if (_deqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+          } else if (dif < 0)
+            return false;  // empty
+          else
+            pos = _deqPos.load(std::memory_order_relaxed);
+        }
+        T *ptr = reinterpret_cast<T *>(cell->_storage);
+        value = zs::move(*ptr);
+        ptr->~T();
+        cell->_seq.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+      }
+      size_t capacity() const noexcept { return _mask + 1; }
+      /// visits the stored elements in queue order, only when no other thread is operating
+      template <typename F> void for_each(F &&f) const {
+        for (size_t pos = _deqPos.load(std::memory_order_acquire),
+                    ed = _enqPos.load(std::memory_order_acquire);
+             pos != ed; ++pos)
+          f(*reinterpret_cast<const T *>(_cells[pos & _mask]._storage));
+      }
+      /// only exact when no other thread is operating
+      size_t size() const noexcept {
+        const size_t ed = _enqPos.load(std::memory_order_acquire);
+        const size_t st = _deqPos.load(std::memory_order_acquire);
+        return ed > st ? ed - st : 0;
+      }
+
+      std::unique_ptr<Cell[]> _cells;
+      size_t _mask;
+      alignas(64) std::atomic<size_t> _enqPos{0};
+      alignas(64) std::atomic<size_t> _deqPos{0};
+    };
+  }  // namespace detail
+
+  /// @brief lock-free bounded multi-producer multi-consumer queue
+  /// @note capacity is rounded up to a power of two, push() and wait_and_pop() block on a futex
+  template <typename T> class bounded_mpmc_queue {
   public:
-    threadsafe_queue() {}
-    threadsafe_queue(threadsafe_queue const &other) {
-      std::lock_guard<std::mutex> lk(other.mut);
-      data_queue = other.data_queue;
-    }
-    void push(const T &new_value) {
-      std::lock_guard<std::mutex> lk(mut);
-      data_queue.push(new_value);
-      data_cond.notify_one();
-    }
-    void push(T &&new_value) {
-      std::lock_guard<std::mutex> lk(mut);
-      data_queue.push(std::move(new_value));
-      data_cond.notify_one();
-    }
-    void wait_and_pop(T &value) {
-      /// spinlock should be better
-      std::unique_lock<std::mutex> lk(mut);
-      data_cond.wait(lk, [this] { return !data_queue.empty(); });
-      value = data_queue.front();
-      data_queue.pop();
-    }
-    decltype(auto) wait_and_pop() {
-      /// spinlock should be better
-      std::unique_lock<std::mutex> lk(mut);
-      data_cond.wait(lk, [this] { return !data_queue.empty(); });
-      T value = data_queue.front();
-      data_queue.pop();
-      return value;
-    }
-    std::shared_ptr<T> wait_and_pop_ptr() {
-      std::unique_lock<std::mutex> lk(mut);
-      data_cond.wait(lk, [this] { return !data_queue.empty(); });
-      std::shared_ptr<T> res(std::make_shared<T>(data_queue.front()));
-      data_queue.pop();
-      return res;
+    using value_type = T;
+
+    explicit bounded_mpmc_queue(size_t capacity) : _ring{capacity} {}
+
+    template <typename... Args> bool try_emplace(Args &&...args) {
+      if (!_ring.try_emplace(FWD(args)...)) return false;
+      _notEmpty.notify();
+      return true;
     }
+    bool try_push(const T &value) { return try_emplace(value); }
+    bool try_push(T &&value) { return try_emplace(zs::move(value)); }
     bool try_pop(T &value) {
-      std::lock_guard<std::mutex> lk(mut);
-      if (data_queue.empty()) return false;
-      value = data_queue.front();
-      data_queue.pop();
+      if (!_ring.try_pop(value)) return false;
+      _notFull.notify();
       return true;
     }
-    decltype(auto) try_pop() {
-      std::lock_guard<std::mutex> lk(mut);
-      if (data_queue.empty()) return optional<T>{};
-      optional<T> value{data_queue.front()};
-      data_queue.pop();
+    optional<T> try_pop() {
+      optional<T> ret{};
+      T value;
+      if (try_pop(value)) ret.emplace(zs::move(value));
+      return ret;
+    }
+
+    void push(const T &value) {
+      _notFull.wait([&]() { return _ring.try_emplace(value); });
+      _notEmpty.notify();
+    }
+    void push(T &&value) {
+      _notFull.wait([&]() { return _ring.try_emplace(zs::move(value)); });
+      _notEmpty.notify();
+    }
+    void wait_and_pop(T &value) { _notEmpty.wait([&]() { return try_pop(value); }); }
+    T wait_and_pop() {
+      T value;
+      wait_and_pop(value);
       return value;
     }
+
+    size_t capacity() const noexcept { return _ring.capacity(); }
+    size_t size() const noexcept { return _ring.size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+  protected:
+    detail::mpmc_ring<T> _ring;
+    detail::queue_wait_event _notEmpty, _notFull;
+  };
+
+  /// @brief unbounded multi-producer multi-consumer queue built from lock-free ring segments
+  /// @note a full segment is closed and followed by one twice as large, only this growth step
+  /// takes a lock. Drained segments are not reused but released with the queue, the segments
+  /// allocated so far may thus hold up to four times the peak number of queued elements.
+  /// wait_and_pop() blocks on a futex.
+  template <typename T> class concurrent_queue {
+    struct Segment : detail::mpmc_ring<T> {
+      using detail::mpmc_ring<T>::mpmc_ring;
+      std::atomic<Segment *> _next{nullptr};
+      std::atomic<bool> _closed{false};
+      /// producers that may still write into this segment
+      std::atomic<u32> _numWriters{0};
+    };
+
+  public:
+    using value_type = T;
+
+    explicit concurrent_queue(size_t segmentCapacity = 1024) {
+      _segments.push_back(std::make_unique<Segment>(segmentCapacity));
+      _head.store(_segments.back().get(), std::memory_order_relaxed);
+      _tail.store(_segments.back().get(), std::memory_order_relaxed);
+    }
+    /// copies the queued elements, only consistent when no other thread operates on [o]
+    concurrent_queue(const concurrent_queue &o)
+        : concurrent_queue(o.size() > o._segments.front()->capacity()
+                               ? o.size()
+                               : o._segments.front()->capacity()) {
+      for (Segment *seg = o._head.load(std::memory_order_acquire); seg;
+           seg = seg->_next.load(std::memory_order_acquire))
+        seg->for_each([this](const T &value) { emplace(value); });
+    }
+    concurrent_queue &operator=(const concurrent_queue &) = delete;
+
+    template <typename... Args> void emplace(Args &&...args) {
+      for (;;) {
+        Segment *seg = _tail.load(std::memory_order_acquire);
+        seg->_numWriters.fetch_add(1, std::memory_order_seq_cst);
+        const bool done
+            = !seg->_closed.load(std::memory_order_seq_cst) && seg->try_emplace(FWD(args)...);
+        seg->_numWriters.fetch_sub(1, std::memory_order_release);
+        if (done) break;
+        grow(seg);
+      }
+      _notEmpty.notify();
+    }
+    void push(const T &value) { emplace(value); }
+    void push(T &&value) { emplace(zs::move(value)); }
+
+    bool try_pop(T &value) {
+      for (;;) {
+        Segment *seg = _head.load(std::memory_order_acquire);
+        if (seg->try_pop(value)) return true;
+        Segment *next = seg->_next.load(std::memory_order_acquire);
+        if (next == nullptr) return false;
+        // closed, abandon it once the producers still inside have finished
+        while (seg->_numWriters.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+        if (seg->try_pop(value)) return true;
+        _head.compare_exchange_strong(seg, next, std::memory_order_acq_rel);
+      }
+    }
+    optional<T> try_pop() {
+      optional<T> ret{};
+      T value;
+      if (try_pop(value)) ret.emplace(zs::move(value));
+      return ret;
+    }
     std::shared_ptr<T> try_pop_ptr() {
-      std::lock_guard<std::mutex> lk(mut);
-      if (data_queue.empty()) return std::shared_ptr<T>();
-      std::shared_ptr<T> res(std::make_shared<T>(data_queue.front()));
-      data_queue.pop();
-      return res;
+      T value;
+      if (try_pop(value)) return std::make_shared<T>(zs::move(value));
+      return std::shared_ptr<T>();
     }
-    bool empty() const {
-      std::lock_guard<std::mutex> lk(mut);
-      return data_queue.empty();
+    void wait_and_pop(T &value) { _notEmpty.wait([&]() { return try_pop(value); }); }
+    T wait_and_pop() {
+      T value;
+      wait_and_pop(value);
+      return value;
+    }
+    std::shared_ptr<T> wait_and_pop_ptr() { return std::make_shared<T>(wait_and_pop()); }
+
+    /// only exact when no other thread is operating
+    size_t size() const noexcept {
+      size_t ret = 0;
+      for (Segment *seg = _head.load(std::memory_order_acquire); seg;
+           seg = seg->_next.load(std::memory_order_acquire))
+        ret += seg->size();
+      return ret;
     }
+    bool empty() const noexcept { return size() == 0; }
+
+  protected:
+    void grow(Segment *seg) {
+      _growLock.lock();
+      if (_tail.load(std::memory_order_relaxed) == seg) {
+        _segments.push_back(std::make_unique<Segment>(seg->capacity() * 2));
+        Segment *next = _segments.back().get();
+        seg->_closed.store(true, std::memory_order_seq_cst);
+        seg->_next.store(next, std::memory_order_release);
+        _tail.store(next, std::memory_order_release);
+      }
+      _growLock.unlock();
+    }
+
+    alignas(64) std::atomic<Segment *> _head;
+    alignas(64) std::atomic<Segment *> _tail;
+    Mutex _growLock{};
+    std::vector<std::unique_ptr<Segment>> _segments;
+    detail::queue_wait_event _notEmpty;
   };
 
+  /// @note formerly a mutex-guarded std::queue (<<C++ concurrency in action>>), same interface
+  template <typename T> using threadsafe_queue = concurrent_queue<T>;
+
   template <typename KeyT, typename ValueT> struct concurrent_map {
     using key_t = KeyT;
     using value_t = ValueT;
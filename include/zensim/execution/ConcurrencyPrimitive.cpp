@@ -98,19 +98,14 @@ namespace zs {
       static WaitQueue *get_queue(u64 key) {
         /// @note must be power of two
         static constexpr size_t num_queues = 4096;
-        static WaitQueue queues[num_queues];
+        /// @note never released, threads may still park or unpark during static destruction
+        static WaitQueue *queues = new WaitQueue[num_queues];
         return &queues[key & (num_queues - 1)];
       }
 
       WaitQueue() = default;
-      ~WaitQueue() {
-        WaitNode *node = _list;
-        while (node != nullptr) {
-          auto cur = node;
-          node = node->_next;
-          delete cur;
-        }
-      }
+      /// @note nodes still listed belong to threads parked at exit, which release them
+      ~WaitQueue() = default;
 
       [[nodiscard]] WaitNode *insertHead(const WaitNode &newNode_) {
         WaitNode *newNode = new WaitNode{newNode_._key, newNode_._lotid, newNode_._data};
@@ -118,22 +113,14 @@ namespace zs {
         _list = newNode;
         return _list;
       }
+      /// @note only unlinks [node], the parked thread owns and releases its node
       void erase(WaitNode *node) {
-        if (_list == node) {
-          delete _list;
-          _list = _list->_next;
-          return;
-        }
-        WaitNode *cur = _list->_next, *prev = _list;
-        while (cur != nullptr) {
-          if (node == cur) {
-            prev->_next = cur->_next;
-            delete cur;
+        for (WaitNode **cur = &_list; *cur != nullptr; cur = &(*cur)->_next)
+          if (*cur == node) {
+            *cur = node->_next;
+            node->_next = nullptr;
             return;
           }
-          prev = cur;
-          cur = cur->_next;
-        }
       }
     };
 
@@ -176,12 +163,17 @@ namespace zs {
 
         auto status = (*pnode).waitFor(timeoutMs);
         if (status == std::cv_status::timeout) {
-          std::lock_guard queueLock{queue->_mtx};
+          std::unique_lock queueLock{queue->_mtx};
+          // the unparker signals under the queue lock, so the flag is settled here
           if (!(*pnode).signaled()) {
             queue->erase(pnode);
+            queue->_count.fetch_sub(1, std::memory_order_relaxed);
+            queueLock.unlock();
+            delete pnode;
             return ParkResult::Timeout;
           }
         }
+        delete pnode;
         return ParkResult::Unpark;
       }
 
@@ -200,7 +192,8 @@ namespace zs {
           if (node._key == key && node._lotid == _lotid) {
             UnparkControl result = FWD(func)(node._data);
             if (result == UnparkControl::RemoveBreak || result == UnparkControl::RemoveContinue) {
-              queue->erase(st);
+              queue->erase(&node);
+              queue->_count.fetch_sub(1, std::memory_order_relaxed);
               node.wake();
             }
             if (result == UnparkControl::RemoveBreak || result == UnparkControl::RetainBreak) {
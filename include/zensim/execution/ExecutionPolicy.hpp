@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <numeric>
 
 #include "zensim/TypeAlias.hpp"
@@ -607,6 +608,121 @@ namespace zs {
       }
     }
 
+    /// segment i spans [first + offsets[i], first + offsets[i + 1])
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_reduce(
+        InputIt &&first, OffsetIt &&offsets, size_t numSegments, OutputIt &&d_first,
+        remove_cvref_t<decltype(*declval<InputIt>())> init
+        = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+        BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) const {
+      for (size_t s = 0; s != numSegments; ++s) {
+        auto res = init;
+        for (auto i = offsets[s]; i < offsets[s + 1]; ++i) res = binary_op(res, *(first + i));
+        *(d_first + s) = res;
+      }
+    }
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_inclusive_scan(InputIt &&first, OffsetIt &&offsets, size_t numSegments,
+                                  OutputIt &&d_first, BinaryOp &&binary_op = {},
+                                  const source_location &loc = source_location::current()) const {
+      for (size_t s = 0; s != numSegments; ++s) {
+        const auto st = offsets[s], ed = offsets[s + 1];
+        if (st >= ed) continue;
+        remove_cvref_t<decltype(*first)> res = *(first + st);
+        *(d_first + st) = res;
+        for (auto i = st + 1; i < ed; ++i) *(d_first + i) = res = binary_op(res, *(first + i));
+      }
+    }
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_exclusive_scan(
+        InputIt &&first, OffsetIt &&offsets, size_t numSegments, OutputIt &&d_first,
+        remove_cvref_t<decltype(*declval<InputIt>())> init
+        = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+        BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) const {
+      for (size_t s = 0; s != numSegments; ++s) {
+        auto res = init;
+        for (auto i = offsets[s]; i < offsets[s + 1]; ++i) {
+          auto v = *(first + i);  // in-place safe
+          *(d_first + i) = res;
+          res = binary_op(res, v);
+        }
+      }
+    }
+    /// stream compaction, returns the number of elements written
+    template <class InputIt, class OutputIt, class Predicate>
+    size_t copy_if(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred,
+                   const source_location &loc = source_location::current()) const {
+      size_t cnt = 0;
+      for (; first != last; ++first)
+        if (pred(*first)) *(d_first + cnt++) = *first;
+      return cnt;
+    }
+    /// stable, returns the number of elements satisfying [pred]
+    template <class InputIt, class OutputIt0, class OutputIt1, class Predicate>
+    size_t partition_copy(InputIt &&first, InputIt &&last, OutputIt0 &&d_true,
+                          OutputIt1 &&d_false, Predicate &&pred,
+                          const source_location &loc = source_location::current()) const {
+      size_t numTrue = 0, numFalse = 0;
+      for (; first != last; ++first)
+        if (pred(*first))
+          *(d_true + numTrue++) = *first;
+        else
+          *(d_false + numFalse++) = *first;
+      return numTrue;
+    }
+    /// stable, elements satisfying [pred] precede the others in [d_first]
+    template <class InputIt, class OutputIt, class Predicate>
+    size_t partition(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred,
+                     const source_location &loc = source_location::current()) const {
+      size_t numTrue = 0;
+      for (auto it = first; it != last; ++it) numTrue += pred(*it) ? 1 : 0;
+      size_t i = 0, j = numTrue;
+      for (; first != last; ++first) *(d_first + (pred(*first) ? i++ : j++)) = *first;
+      return numTrue;
+    }
+    /// keeps the first element of each run of equal elements
+    template <class InputIt, class OutputIt,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    size_t unique(InputIt &&first, InputIt &&last, OutputIt &&d_first, EqualOp &&eq = {},
+                  const source_location &loc = source_location::current()) const {
+      size_t cnt = 0;
+      for (auto it = first; it != last; ++it)
+        if (it == first || !eq(*(it - 1), *it)) *(d_first + cnt++) = *it;
+      return cnt;
+    }
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+    size_t unique_by_key(KeyIter &&keys, ValueIter &&vals, size_t count, KeyOutIter &&keysOut,
+                         ValueOutIter &&valsOut, EqualOp &&eq = {},
+                         const source_location &loc = source_location::current()) const {
+      size_t cnt = 0;
+      for (size_t i = 0; i != count; ++i)
+        if (i == 0 || !eq(*(keys + (i - 1)), *(keys + i))) {
+          *(keysOut + cnt) = *(keys + i);
+          *(valsOut + cnt++) = *(vals + i);
+        }
+      return cnt;
+    }
+    /// reduces the values of each run of equal keys, returns the number of runs
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<ValueIter>())>>,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+    size_t reduce_by_key(KeyIter &&keys, ValueIter &&vals, size_t count, KeyOutIter &&keysOut,
+                         ValueOutIter &&valsOut, BinaryOp &&binary_op = {}, EqualOp &&eq = {},
+                         const source_location &loc = source_location::current()) const {
+      size_t cnt = 0;
+      for (size_t i = 0; i != count; ++i)
+        if (i == 0 || !eq(*(keys + (i - 1)), *(keys + i))) {
+          *(keysOut + cnt) = *(keys + i);
+          *(valsOut + cnt++) = *(vals + i);
+        } else
+          *(valsOut + (cnt - 1)) = binary_op(*(valsOut + (cnt - 1)), *(vals + i));
+      return cnt;
+    }
+
   protected:
     bool do_launch(const ParallelTask &) const noexcept;
     bool do_sync() const noexcept { return true; }
@@ -780,5 +896,79 @@ namespace zs {
     policy.radix_sort(FWD(first), FWD(last), FWD(d_first), sbit, ebit, loc);
   }
   /// gather/ select (flagged, if, unique)
+  template <class ExecutionPolicy, class InputIt, class OutputIt, class Predicate>
+  size_t copy_if(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last, OutputIt &&d_first,
+                 Predicate &&pred, const source_location &loc = source_location::current()) {
+    return policy.copy_if(FWD(first), FWD(last), FWD(d_first), FWD(pred), loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OutputIt0, class OutputIt1,
+            class Predicate>
+  size_t partition_copy(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last,
+                        OutputIt0 &&d_true, OutputIt1 &&d_false, Predicate &&pred,
+                        const source_location &loc = source_location::current()) {
+    return policy.partition_copy(FWD(first), FWD(last), FWD(d_true), FWD(d_false), FWD(pred),
+                                 loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OutputIt, class Predicate>
+  size_t partition(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last, OutputIt &&d_first,
+                   Predicate &&pred, const source_location &loc = source_location::current()) {
+    return policy.partition(FWD(first), FWD(last), FWD(d_first), FWD(pred), loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OutputIt,
+            class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<InputIt>())>>>
+  size_t unique(ExecutionPolicy &&policy, InputIt &&first, InputIt &&last, OutputIt &&d_first,
+                EqualOp &&eq = {}, const source_location &loc = source_location::current()) {
+    return policy.unique(FWD(first), FWD(last), FWD(d_first), FWD(eq), loc);
+  }
+  template <class ExecutionPolicy, class KeyIter, class ValueIter, class KeyOutIter,
+            class ValueOutIter,
+            class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+  size_t unique_by_key(ExecutionPolicy &&policy, KeyIter &&keys, ValueIter &&vals, size_t count,
+                       KeyOutIter &&keysOut, ValueOutIter &&valsOut, EqualOp &&eq = {},
+                       const source_location &loc = source_location::current()) {
+    return policy.unique_by_key(FWD(keys), FWD(vals), count, FWD(keysOut), FWD(valsOut), FWD(eq),
+                                loc);
+  }
+  /// segmented reduce/ scan
+  template <class ExecutionPolicy, class KeyIter, class ValueIter, class KeyOutIter,
+            class ValueOutIter,
+            class BinaryOp = plus<remove_cvref_t<decltype(*declval<ValueIter>())>>,
+            class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+  size_t reduce_by_key(ExecutionPolicy &&policy, KeyIter &&keys, ValueIter &&vals, size_t count,
+                       KeyOutIter &&keysOut, ValueOutIter &&valsOut, BinaryOp &&binary_op = {},
+                       EqualOp &&eq = {}, const source_location &loc = source_location::current()) {
+    return policy.reduce_by_key(FWD(keys), FWD(vals), count, FWD(keysOut), FWD(valsOut),
+                                FWD(binary_op), FWD(eq), loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OffsetIt, class OutputIt,
+            class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+  void segmented_reduce(
+      ExecutionPolicy &&policy, InputIt &&first, OffsetIt &&offsets, size_t numSegments,
+      OutputIt &&d_first,
+      remove_cvref_t<decltype(*declval<InputIt>())> init
+      = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+      BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) {
+    policy.segmented_reduce(FWD(first), FWD(offsets), numSegments, FWD(d_first), init,
+                            FWD(binary_op), loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OffsetIt, class OutputIt,
+            class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+  void segmented_inclusive_scan(ExecutionPolicy &&policy, InputIt &&first, OffsetIt &&offsets,
+                                size_t numSegments, OutputIt &&d_first, BinaryOp &&binary_op = {},
+                                const source_location &loc = source_location::current()) {
+    policy.segmented_inclusive_scan(FWD(first), FWD(offsets), numSegments, FWD(d_first),
+                                    FWD(binary_op), loc);
+  }
+  template <class ExecutionPolicy, class InputIt, class OffsetIt, class OutputIt,
+            class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+  void segmented_exclusive_scan(
+      ExecutionPolicy &&policy, InputIt &&first, OffsetIt &&offsets, size_t numSegments,
+      OutputIt &&d_first,
+      remove_cvref_t<decltype(*declval<InputIt>())> init
+      = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+      BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) {
+    policy.segmented_exclusive_scan(FWD(first), FWD(offsets), numSegments, FWD(d_first), init,
+                                    FWD(binary_op), loc);
+  }
 
 }  // namespace zs
\ No newline at end of file
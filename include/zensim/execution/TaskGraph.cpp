@@ -0,0 +1,305 @@
+#include "TaskGraph.hpp"
+
+#include <deque>
+
+#include "zensim/execution/Intrinsics.hpp"
+
+namespace zs {
+
+  namespace {
+    struct WorkerContext {
+      const TaskScheduler *scheduler{nullptr};
+      int wid{-1};
+    };
+    thread_local WorkerContext g_workerContext{};
+
+    constexpr int g_numSpins = 64;
+
+    inline u32 xorshift32(u32 &state) noexcept {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state;
+    }
+  }  // namespace
+
+  /// @note ref: Correct and Efficient Work-Stealing for Weak Memory Models, Le et al.
+  /// only the owner pushes and pops (bottom end), other threads steal from the top end
+  struct TaskScheduler::Worker {
+    struct Array {
+      explicit Array(i64 capacity) : _capacity{capacity}, _slots{new Slot[capacity]} {}
+      TaskNode *get(i64 i) const noexcept {
+        return _slots[i & (_capacity - 1)].load(std::memory_order_relaxed);
+      }
+      void put(i64 i, TaskNode *node) noexcept {
+        _slots[i & (_capacity - 1)].store(node, std::memory_order_relaxed);
+      }
+      using Slot = std::atomic<TaskNode *>;
+      i64 _capacity;
+      std::unique_ptr<Slot[]> _slots;
+    };
+
+    Worker() : _array{new Array(256)} { _retired.emplace_back(_array.load()); }
+
+    void push(TaskNode *node) {
+      const i64 b = _bottom.load(std::memory_order_relaxed);
+      const i64 t = _top.load(std::memory_order_acquire);
+      Array *a = _array.load(std::memory_order_relaxed);
+      if (b - t > a->_capacity - 1) {
+        // thieves may still read the old array, it is kept alive until the worker is destroyed
+        auto grown = new Array(a->_capacity * 2);
+        for (i64 i = t; i != b; ++i) grown->put(i, a->get(i));
+        _retired.emplace_back(grown);
+        _array.store(grown, std::memory_order_release);
+        a = grown;
+      }
+      a->put(b, node);
+      std::atomic_thread_fence(std::memory_order_release);
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    TaskNode *pop() {
+      const i64 b = _bottom.load(std::memory_order_relaxed) - 1;
+      Array *a = _array.load(std::memory_order_relaxed);
+      _bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      i64 t = _top.load(std::memory_order_relaxed);
+      TaskNode *node = nullptr;
+      if (t <= b) {
+        node = a->get(b);
+        if (t == b) {
+          // the last element, race against thieves
+          if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed))
+            node = nullptr;
+          _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+      } else
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      return node;
+    }
+    TaskNode *steal() {
+      i64 t = _top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const i64 b = _bottom.load(std::memory_order_acquire);
+      if (t < b) {
+        Array *a = _array.load(std::memory_order_acquire);
+        TaskNode *node = a->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+          return nullptr;
+        return node;
+      }
+      return nullptr;
+    }
+    bool empty() const noexcept {
+      return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<i64> _top{0};
+    alignas(64) std::atomic<i64> _bottom{0};
+    std::atomic<Array *> _array;
+    std::vector<std::unique_ptr<Array>> _retired;
+  };
+
+  /// tasks published by threads outside the pool
+  struct TaskScheduler::Injection {
+    void push(TaskNode *node, u32 count) {
+      _lock.lock();
+      for (u32 i = 0; i != count; ++i) _queue.push_back(node);
+      _size.store(_queue.size(), std::memory_order_release);
+      _lock.unlock();
+    }
+    TaskNode *pop() {
+      if (_size.load(std::memory_order_acquire) == 0) return nullptr;
+      TaskNode *node = nullptr;
+      _lock.lock();
+      if (!_queue.empty()) {
+        node = _queue.front();
+        _queue.pop_front();
+        _size.store(_queue.size(), std::memory_order_release);
+      }
+      _lock.unlock();
+      return node;
+    }
+
+    Mutex _lock{};
+    std::deque<TaskNode *> _queue{};
+    std::atomic<size_t> _size{0};
+  };
+
+  /// @note intentionally leaked, parked workers must not outlive the parking lot at exit
+  TaskScheduler &TaskScheduler::instance() {
+    static TaskScheduler *s_scheduler = new TaskScheduler{};
+    return *s_scheduler;
+  }
+
+  TaskScheduler::TaskScheduler(u32 numWorkers) : _injection{std::make_unique<Injection>()} {
+    if (numWorkers == 0) {
+      const u32 hc = std::thread::hardware_concurrency();
+      numWorkers = hc > 1 ? hc - 1 : 1;
+    }
+    _workers.reserve(numWorkers);
+    for (u32 i = 0; i != numWorkers; ++i) _workers.push_back(std::make_unique<Worker>());
+    _threads.reserve(numWorkers);
+    for (u32 i = 0; i != numWorkers; ++i)
+      _threads.emplace_back([this, i]() { worker_loop((int)i); });
+  }
+  TaskScheduler::~TaskScheduler() {
+    _stop.store(true, std::memory_order_seq_cst);
+    _epoch.fetch_add(1, std::memory_order_seq_cst);
+    Futex::wake(&_epoch);
+    for (auto &th : _threads)
+      if (th.joinable()) th.join();
+  }
+
+  int TaskScheduler::current_worker() const noexcept {
+    return g_workerContext.scheduler == this ? g_workerContext.wid : -1;
+  }
+
+  void TaskScheduler::notify(u32 count) {
+    // pairs with the fence of a worker going to sleep, either the worker sees the new task or
+    // this thread sees the sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_numSleeping.load(std::memory_order_relaxed) == 0) return;
+    _epoch.fetch_add(1, std::memory_order_release);
+    Futex::wake(&_epoch, (int)count);
+  }
+
+  /// make a ready node available, loops are published once per thread that may help
+  void TaskScheduler::schedule(TaskNode *node, int wid) {
+    const size_t numChunks = node->num_chunks();
+    const size_t numThreads = _workers.size() + 1;
+    const u32 numCopies = (u32)(numChunks < numThreads ? (numChunks ? numChunks : 1) : numThreads);
+    node->_nextChunk.store(0, std::memory_order_relaxed);
+    node->_copies.store(numCopies, std::memory_order_relaxed);
+    if (wid >= 0)
+      for (u32 i = 0; i != numCopies; ++i) _workers[wid]->push(node);
+    else
+      _injection->push(node, numCopies);
+    notify(numCopies);
+  }
+
+  TaskNode *TaskScheduler::acquire(int wid, u32 &seed) {
+    if (wid >= 0)
+      if (auto node = _workers[wid]->pop()) return node;
+    if (auto node = _injection->pop()) return node;
+    const u32 numWorkers = (u32)_workers.size();
+    const u32 st = xorshift32(seed) % numWorkers;
+    for (u32 i = 0; i != numWorkers; ++i) {
+      const u32 victim = (st + i) % numWorkers;
+      if ((int)victim == wid) continue;
+      if (auto node = _workers[victim]->steal()) return node;
+    }
+    return nullptr;
+  }
+
+  /// run the chunks this copy can claim, returns a successor to continue with (if any)
+  TaskNode *TaskScheduler::execute(TaskNode *node, int wid) {
+    TaskGraph &graph = *node->_graph;
+    const size_t numChunks = node->num_chunks();
+    for (size_t c = node->_nextChunk.fetch_add(1, std::memory_order_relaxed); c < numChunks;
+         c = node->_nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+      if (graph.cancelled()) continue;
+      const size_t st = c * node->_grain;
+      const size_t ed = st + node->_grain < node->_n ? st + node->_grain : node->_n;
+      try {
+        node->_work(st, ed);
+      } catch (...) {
+        graph.capture_exception(std::current_exception());
+      }
+    }
+    if (node->_copies.fetch_sub(1, std::memory_order_acq_rel) != 1) return nullptr;
+
+    // the last copy retires the node, the first ready successor runs on this thread
+    TaskNode *continuation = nullptr;
+    for (TaskNode *succ : node->_successors)
+      if (succ->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (continuation) schedule(continuation, wid);
+        continuation = succ;
+      }
+    if (continuation) {
+      const size_t numChunks = continuation->num_chunks();
+      if (numChunks > 1) {
+        // a loop is split among the pool, this thread works on one copy right away
+        schedule(continuation, wid);
+        continuation = wid >= 0 ? _workers[wid]->pop() : _injection->pop();
+      } else {
+        continuation->_nextChunk.store(0, std::memory_order_relaxed);
+        continuation->_copies.store(1, std::memory_order_relaxed);
+      }
+    }
+    // the graph may be destroyed by its waiter once the count drops to zero
+    if (graph._remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      graph._state.store(1, std::memory_order_release);
+      Futex::wake(&graph._state);
+      graph._state.store(2, std::memory_order_release);
+    }
+    return continuation;
+  }
+
+  void TaskScheduler::launch(TaskGraph &graph) {
+    if (!graph.done())
+      throw std::runtime_error("[TaskScheduler::launch] the graph is still running");
+    graph._exception = nullptr;
+    graph._cancelled.store(false, std::memory_order_relaxed);
+    if (graph._nodes.empty()) return;
+    for (auto &node : graph._nodes)
+      node->_pending.store(node->_numPredecessors, std::memory_order_relaxed);
+    graph._remaining.store(graph._nodes.size(), std::memory_order_relaxed);
+    graph._state.store(0, std::memory_order_release);
+    const int wid = current_worker();
+    bool hasSource = false;
+    for (auto &node : graph._nodes)
+      if (node->_numPredecessors == 0) {
+        schedule(node.get(), wid);
+        hasSource = true;
+      }
+    if (!hasSource) {
+      graph._state.store(2, std::memory_order_release);
+      throw std::runtime_error("[TaskScheduler::launch] the graph has no source task (cycle)");
+    }
+  }
+
+  void TaskScheduler::wait(TaskGraph &graph) {
+    const int wid = current_worker();
+    u32 seed = (u32)(uintptr_t)&graph | 1u;
+    for (;;) {
+      const u32 state = graph._state.load(std::memory_order_acquire);
+      if (state == 2) break;
+      // help instead of blocking, this also keeps nested waits from deadlocking
+      if (auto node = acquire(wid, seed)) {
+        while (node) node = execute(node, wid);
+        continue;
+      }
+      if (state == 1)
+        std::this_thread::yield();
+      else
+        Futex::wait_for(&graph._state, 0, 1);
+    }
+    if (graph._exception) std::rethrow_exception(graph._exception);
+  }
+
+  void TaskScheduler::worker_loop(int wid) {
+    g_workerContext = WorkerContext{this, wid};
+    u32 seed = (u32)wid * 2654435761u + 1u;
+    while (!_stop.load(std::memory_order_acquire)) {
+      TaskNode *node = nullptr;
+      for (int i = 0; i != g_numSpins && !node; ++i) {
+        node = acquire(wid, seed);
+        if (!node) pause_cpu();
+      }
+      if (node) {
+        while (node) node = execute(node, wid);
+        continue;
+      }
+      const u32 epoch = _epoch.load(std::memory_order_acquire);
+      _numSleeping.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if ((node = acquire(wid, seed)) == nullptr && !_stop.load(std::memory_order_acquire))
+        Futex::wait(&_epoch, epoch);
+      _numSleeping.fetch_sub(1, std::memory_order_relaxed);
+      while (node) node = execute(node, wid);
+    }
+  }
+
+}  // namespace zs
@@ -0,0 +1,296 @@
+#pragma once
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zensim/ZpcFunction.hpp"
+#include "zensim/execution/ConcurrencyPrimitive.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+namespace zs {
+
+  struct TaskGraph;
+  struct TaskScheduler;
+
+  /// @brief a node of a task graph, either a single task or a loop over [0, n) split in chunks
+  /// @note a loop node is scheduled as several copies that claim chunks dynamically, the last
+  /// copy to retire releases the successors
+  struct TaskNode {
+    size_t num_chunks() const noexcept { return (_n + _grain - 1) / _grain; }
+
+    unique_function<void(size_t, size_t)> _work{};  ///< processes the elements [st, ed)
+    std::vector<TaskNode *> _successors{};
+    std::string _name{};
+    TaskGraph *_graph{nullptr};
+    size_t _n{1}, _grain{1};
+    u32 _numPredecessors{0};
+    std::atomic<u32> _pending{0};
+    std::atomic<u32> _copies{0};
+    std::atomic<size_t> _nextChunk{0};
+  };
+
+  /// @brief lightweight reference to a node, used to declare dependencies
+  struct TaskHandle {
+    TaskHandle() noexcept = default;
+    explicit TaskHandle(TaskNode *node) noexcept : _node{node} {}
+
+    explicit operator bool() const noexcept { return _node != nullptr; }
+    bool operator==(const TaskHandle &o) const noexcept { return _node == o._node; }
+    bool operator!=(const TaskHandle &o) const noexcept { return _node != o._node; }
+
+    /// this task runs before [tasks]
+    template <typename... Ts> TaskHandle &precede(Ts &&...tasks) {
+      (link(*this, tasks), ...);
+      return *this;
+    }
+    /// this task runs after [tasks]
+    template <typename... Ts> TaskHandle &succeed(Ts &&...tasks) {
+      (link(tasks, *this), ...);
+      return *this;
+    }
+    TaskHandle &name(std::string_view tag) {
+      _node->_name = tag;
+      return *this;
+    }
+    const std::string &name() const noexcept { return _node->_name; }
+    size_t num_successors() const noexcept { return _node->_successors.size(); }
+    size_t num_predecessors() const noexcept { return _node->_numPredecessors; }
+
+    TaskNode *_node{nullptr};
+
+  protected:
+    static void link(const TaskHandle &from, const TaskHandle &to) {
+      if (!from || !to) return;
+      if (from._node->_graph != to._node->_graph)
+        throw std::runtime_error("[TaskHandle] cannot link tasks of different graphs");
+      from._node->_successors.push_back(to._node);
+      to._node->_numPredecessors++;
+    }
+  };
+
+  /// @brief pool of worker threads, each owning a work-stealing deque
+  /// @note idle workers spin briefly, then park on a futex until new work is published
+  struct TaskScheduler {
+    /// shared pool with (hardware concurrency - 1) workers, the waiting thread is the last one
+    ZPC_CORE_API static TaskScheduler &instance();
+
+    ZPC_CORE_API explicit TaskScheduler(u32 numWorkers = 0);
+    ZPC_CORE_API ~TaskScheduler();
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    u32 num_workers() const noexcept { return (u32)_workers.size(); }
+    /// worker index of the calling thread within this scheduler, -1 for other threads
+    ZPC_CORE_API int current_worker() const noexcept;
+
+    /// release the source tasks of [graph], returns immediately
+    ZPC_CORE_API void launch(TaskGraph &graph);
+    /// the calling thread executes pending tasks until [graph] completes
+    ZPC_CORE_API void wait(TaskGraph &graph);
+
+    struct Worker;
+    struct Injection;
+
+  protected:
+    ZPC_CORE_API void schedule(TaskNode *node, int wid);
+    ZPC_CORE_API TaskNode *acquire(int wid, u32 &seed);
+    ZPC_CORE_API TaskNode *execute(TaskNode *node, int wid);
+    ZPC_CORE_API void notify(u32 count);
+    void worker_loop(int wid);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::unique_ptr<Injection> _injection;
+    std::vector<std::thread> _threads;
+    std::atomic<u32> _epoch{0};
+    std::atomic<u32> _numSleeping{0};
+    std::atomic<bool> _stop{false};
+  };
+
+  namespace detail {
+    template <typename F, typename Iter> void invoke_range_body(F &f, Iter &&it) {
+      if constexpr (is_invocable_v<F &, decltype(*it)>)
+        zs::invoke(f, *it);
+      else if constexpr (is_std_tuple_v<remove_cvref_t<decltype(*it)>>)
+        std::apply(f, *it);
+      else if constexpr (is_tuple_v<remove_cvref_t<decltype(*it)>>)
+        zs::apply(f, *it);
+      else if constexpr (is_invocable_v<F &>)
+        zs::invoke(f);
+      else
+        static_assert(always_false<F>, "unable to handle this callable and the range.");
+    }
+  }  // namespace detail
+
+  struct TaskGraphPolicy;
+
+  /// @brief tasks with dependencies, executed by a TaskScheduler
+  /// @note a graph can be run repeatedly, nodes and their links persist until clear()
+  struct TaskGraph {
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+
+    /// a single task
+    template <typename F, enable_if_t<is_invocable_v<F &>> = 0> TaskHandle emplace(F &&f) {
+      auto node = create_node();
+      node->_work = [f = FWD(f)](size_t, size_t) mutable { f(); };
+      return TaskHandle{node};
+    }
+    TaskHandle emplace(const ParallelTask &task) {
+      auto h = emplace([f = task.func]() mutable { f(); });
+      h.name(task.source);
+      return h;
+    }
+    /// a loop over a random-access range, invoked like pol(range, f)
+    /// @note [grain] elements per chunk, 0 picks roughly eight chunks per thread
+    template <typename Range, typename F>
+    TaskHandle parallel_for(Range &&range, F &&f, size_t grain = 0) {
+      auto first = std::begin(range);
+      const auto dist = std::end(range) - first;
+      auto node = create_node();
+      node->_n = dist > 0 ? (size_t)dist : 0;
+      node->_grain = grain ? grain : default_grain(node->_n);
+      node->_work = [first, f = FWD(f)](size_t st, size_t ed) mutable {
+        for (auto it = first + st, last = first + ed; it != last; ++it)
+          detail::invoke_range_body(f, it);
+      };
+      return TaskHandle{node};
+    }
+    /// a policy whose pol(range, f) calls become nodes, ordered after [deps] and one another
+    template <typename... Ts> TaskGraphPolicy policy(Ts &&...deps);
+
+    /// launch on [scheduler] and wait for completion, rethrows the first task exception
+    void run(TaskScheduler &scheduler = TaskScheduler::instance()) {
+      scheduler.launch(*this);
+      scheduler.wait(*this);
+    }
+    bool done() const noexcept { return _state.load(std::memory_order_acquire) == 2; }
+    size_t size() const noexcept { return _nodes.size(); }
+    bool empty() const noexcept { return _nodes.empty(); }
+    void clear() { _nodes.clear(); }
+
+    /// records the first exception, the remaining tasks of this run are skipped
+    void capture_exception(std::exception_ptr e) {
+      _exceptionLock.lock();
+      if (!_exception) _exception = e;
+      _exceptionLock.unlock();
+      _cancelled.store(true, std::memory_order_release);
+    }
+    bool cancelled() const noexcept { return _cancelled.load(std::memory_order_acquire); }
+
+  protected:
+    friend struct TaskScheduler;
+
+    TaskNode *create_node() {
+      _nodes.push_back(std::make_unique<TaskNode>());
+      _nodes.back()->_graph = this;
+      return _nodes.back().get();
+    }
+    static size_t default_grain(size_t n) {
+      const size_t numChunks = (size_t)(std::thread::hardware_concurrency() + 1) * 8;
+      const size_t grain = n / numChunks;
+      return grain ? grain : 1;
+    }
+
+    std::vector<std::unique_ptr<TaskNode>> _nodes{};
+    std::atomic<size_t> _remaining{0};
+    /// 0: running, 1: completed, 2: completion published (safe to destroy)
+    std::atomic<u32> _state{2};
+    std::atomic<bool> _cancelled{false};
+    std::exception_ptr _exception{};
+    Mutex _exceptionLock{};
+  };
+
+  /// @brief records pol(range, f) calls as graph nodes instead of executing them
+  /// @note calls through the same policy keep their order, separate policies of one graph overlap
+  /// @note exec_tag only tells that loop bodies run on host threads. Only loops are recorded, the
+  /// algorithms (reduce, scans, sorts) are rejected rather than run serially at record time, use
+  /// a host policy within a task for them.
+  struct TaskGraphPolicy {
+    using exec_tag = seq_exec_tag;
+
+    TaskGraphPolicy(TaskGraph &graph) noexcept : _graph{&graph} {}
+
+    template <typename Range, typename F>
+    TaskHandle operator()(Range &&range, F &&f,
+                          const source_location &loc = source_location::current()) const {
+      auto h = _graph->parallel_for(FWD(range), FWD(f), _grain);
+      h.name(fmt::format("[File {}, Ln {}]", loc.file_name(), loc.line()));
+      for (auto &dep : _deps) h.succeed(dep);
+      if (_last) h.succeed(_last);
+      _last = h;
+      return h;
+    }
+    /// subsequent nodes also wait for [tasks] (handles, or policies of the same graph)
+    template <typename... Ts> TaskGraphPolicy &after(Ts &&...tasks) {
+      (_deps.push_back(to_handle(tasks)), ...);
+      return *this;
+    }
+    TaskGraphPolicy &grain(size_t g) noexcept {
+      _grain = g;
+      return *this;
+    }
+    /// the most recently recorded node
+    TaskHandle last() const noexcept { return _last; }
+    TaskGraph &graph() const noexcept { return *_graph; }
+
+    template <typename InputIt, typename... Args> void reduce(InputIt &&, Args &&...) const {
+      static_assert(always_false<InputIt>, "[TaskGraphPolicy] reduce is not recorded in a graph");
+    }
+    template <typename InputIt, typename... Args>
+    void inclusive_scan(InputIt &&, Args &&...) const {
+      static_assert(always_false<InputIt>,
+                    "[TaskGraphPolicy] inclusive_scan is not recorded in a graph");
+    }
+    template <typename InputIt, typename... Args>
+    void exclusive_scan(InputIt &&, Args &&...) const {
+      static_assert(always_false<InputIt>,
+                    "[TaskGraphPolicy] exclusive_scan is not recorded in a graph");
+    }
+    template <typename InputIt, typename... Args> void radix_sort(InputIt &&, Args &&...) const {
+      static_assert(always_false<InputIt>,
+                    "[TaskGraphPolicy] radix_sort is not recorded in a graph");
+    }
+    template <typename KeyIter, typename... Args>
+    void radix_sort_pair(KeyIter &&, Args &&...) const {
+      static_assert(always_false<KeyIter>,
+                    "[TaskGraphPolicy] radix_sort_pair is not recorded in a graph");
+    }
+    template <typename KeyIter, typename... Args> void sort(KeyIter &&, Args &&...) const {
+      static_assert(always_false<KeyIter>, "[TaskGraphPolicy] sort is not recorded in a graph");
+    }
+    template <typename KeyIter, typename... Args> void sort_pair(KeyIter &&, Args &&...) const {
+      static_assert(always_false<KeyIter>,
+                    "[TaskGraphPolicy] sort_pair is not recorded in a graph");
+    }
+    template <typename KeyIter, typename... Args> void merge_sort(KeyIter &&, Args &&...) const {
+      static_assert(always_false<KeyIter>,
+                    "[TaskGraphPolicy] merge_sort is not recorded in a graph");
+    }
+    template <typename KeyIter, typename... Args>
+    void merge_sort_pair(KeyIter &&, Args &&...) const {
+      static_assert(always_false<KeyIter>,
+                    "[TaskGraphPolicy] merge_sort_pair is not recorded in a graph");
+    }
+
+  protected:
+    static TaskHandle to_handle(const TaskHandle &h) noexcept { return h; }
+    static TaskHandle to_handle(const TaskGraphPolicy &pol) noexcept { return pol.last(); }
+
+    TaskGraph *_graph;
+    std::vector<TaskHandle> _deps{};
+    mutable TaskHandle _last{};
+    size_t _grain{0};
+  };
+
+  template <typename... Ts> TaskGraphPolicy TaskGraph::policy(Ts &&...deps) {
+    TaskGraphPolicy pol{*this};
+    pol.after(FWD(deps)...);
+    return pol;
+  }
+
+}  // namespace zs
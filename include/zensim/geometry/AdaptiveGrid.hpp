@@ -650,6 +650,13 @@ namespace zs {
     constexpr size_type getPropertyOffset(const SmallString &str) const {
       return level(dim_c<num_levels - 1>).grid.getPropertyOffset(str);
     }
+    PropertyHandle resolve(const SmallString &str) const {
+      return level(dim_c<num_levels - 1>).grid.resolve(str);
+    }
+    template <typename... Ts, enable_if_t<(sizeof...(Ts) > 1)> = 0>
+    auto resolve(const Ts &...strs) const {
+      return level(dim_c<num_levels - 1>).grid.resolve(strs...);
+    }
     constexpr PropertyTag getPropertyTag(size_type i = 0) const {
       return level(dim_c<num_levels - 1>).grid.getPropertyTag(i);
     }
@@ -1587,6 +1594,16 @@ namespace zs {
     constexpr bool hasProperty(const SmallString &propName) const noexcept {
       return propertyIndex(propName) != _N;
     }
+    /// @brief resolve [propName] once, pass handle.offset to the channel-based accessors
+    constexpr PropertyHandle resolve(const SmallString &propName) const noexcept {
+      auto propNo = propertyIndex(propName);
+      if (propNo == _N) return PropertyHandle{};
+      return PropertyHandle{(int)_tagOffsets[propNo], (int)_tagSizes[propNo]};
+    }
+    template <typename... Ts, enable_if_t<(sizeof...(Ts) > 1)> = 0>
+    constexpr auto resolve(const Ts &...propNames) const noexcept {
+      return zs::make_tuple(resolve(SmallString{propNames})...);
+    }
 
     /// @note TileVectorView-alike
     const SmallString *_tagNames;
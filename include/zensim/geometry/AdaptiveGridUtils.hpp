@@ -1,5 +1,216 @@
 #pragma once
 #include "AdaptiveGrid.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/bit/Bits.h"
 
-namespace zs {}  // namespace zs
\ No newline at end of file
+namespace zs {
+
+  namespace detail {
+    /// @brief leaf-level accessors shared by SparseGridView and AdaptiveGridView
+    template <typename GridViewT> struct leaf_block_traits {
+      using container_type = typename GridViewT::container_type;
+      using integer_coord_type = typename GridViewT::integer_coord_type;
+      using integer_coord_component_type = typename GridViewT::integer_coord_component_type;
+      static constexpr bool is_spg = is_spg_v<container_type>;
+
+      static constexpr integer_coord_component_type deduce_side_length() noexcept {
+        if constexpr (is_spg)
+          return GridViewT::side_length;
+        else {
+          using leaf_t = typename GridViewT::template level_view_type<0>;
+          static_assert(leaf_t::sbit == 0, "leaf level should be at voxel resolution");
+          return leaf_t::tile_dim;
+        }
+      }
+      static constexpr integer_coord_component_type side_length = deduce_side_length();
+      static constexpr integer_coord_component_type side_bits = bit_count(side_length);
+
+      static constexpr auto query(const GridViewT &gv, const integer_coord_type &origin) noexcept {
+        if constexpr (is_spg)
+          return gv._table.query(origin);
+        else
+          return gv.level(dim_c<0>).table.query(origin);
+      }
+      template <typename IndexT>
+      static constexpr auto value(const GridViewT &gv, typename GridViewT::size_type chn,
+                                  IndexT bno, const integer_coord_type &coord) noexcept {
+        if constexpr (is_spg)
+          return gv._grid(chn, bno, gv.local_coord_to_offset(coord & (side_length - 1)));
+        else
+          return gv.level(dim_c<0>).grid(chn, bno, gv.template coord_to_tile_offset<0>(coord));
+      }
+      /// @note used when the leaf block is absent
+      static constexpr auto fallback(const GridViewT &gv, typename GridViewT::size_type chn,
+                                     const integer_coord_type &coord) noexcept {
+        if constexpr (is_spg)
+          return gv._background;
+        else
+          return gv.value(false_c, chn, coord);
+      }
+    };
+
+    /// @note interleaved (morton) bits of the biased leaf block coordinate
+    template <int dim, typename VecT> constexpr u64 leaf_block_sort_key(const VecT &blockCoord) {
+      constexpr int bits = 64 / dim;
+      constexpr u64 bias = (u64)1 << (bits - 1);
+      if constexpr (dim == 3) {
+        return (expand_bits_64((u32)((u64)blockCoord[0] + bias)) << 2)
+               | (expand_bits_64((u32)((u64)blockCoord[1] + bias)) << 1)
+               | expand_bits_64((u32)((u64)blockCoord[2] + bias));
+      } else {
+        u64 ret = 0;
+        for (int b = 0; b != bits; ++b)
+          for (int d = 0; d != dim; ++d)
+            ret |= ((((u64)blockCoord[d] + bias) >> b) & (u64)1) << (b * dim + (dim - 1 - d));
+        return ret;
+      }
+    }
+  }  // namespace detail
+
+  /// @brief batched sampling of channel [chn] of a SparseGrid or AdaptiveGrid at world-space
+  /// [points], equivalent to calling wSample per point.
+  /// @note queries are bucketed by the leaf block holding their stencil corner (radix sort), the
+  /// (at most 2^dim) leaf blocks touched by a bucket are resolved once and shared by its points.
+  /// The queries are then interpolated in parallel in bucket order and scattered back in input
+  /// order.
+  template <kernel_e kt = kernel_e::linear, typename ExecPol, typename GridT, typename T,
+            int dim, typename PointAllocatorT, typename OutAllocatorT,
+            enable_if_all<is_spg_v<GridT> || is_ag_v<GridT>, GridT::dim == dim> = 0>
+  void sample(ExecPol &&pol, const GridT &grid, const Vector<vec<T, dim>, PointAllocatorT> &points,
+              typename GridT::size_type chn, Vector<typename GridT::value_type, OutAllocatorT> &out,
+              wrapv<kt> = {}) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = typename GridT::size_type;
+    using grid_view_t = RM_CVREF_T(proxy<space>(grid));
+    using traits = detail::leaf_block_traits<grid_view_t>;
+    using integer_coord_type = typename grid_view_t::integer_coord_type;
+    using Ti = typename grid_view_t::integer_coord_component_type;
+    using arena_t = GridArena<const grid_view_t, kt, 0>;
+
+    if (!valid_memspace_for_execution(pol, grid.get_allocator())
+        || !valid_memspace_for_execution(pol, points.get_allocator())
+        || !valid_memspace_for_execution(pol, out.get_allocator()))
+      throw std::runtime_error(
+          "[sample] current memory location not compatible with the execution policy");
+    if (chn >= grid.numChannels())
+      throw std::runtime_error("[sample] channel index out of bound");
+
+    const auto n = points.size();
+    out.resize(n);
+    if (n == 0) return;
+
+    auto allocator = get_temporary_memory_source(pol);
+    Vector<u64> keys{allocator, n}, sortedKeys{allocator, n};
+    Vector<size_type> indices{allocator, n}, sortedIndices{allocator, n};
+    /// bucket key per query
+    pol(range(n), [gv = proxy<space>(grid), points = view<space>(points), keys = view<space>(keys),
+                   indices = view<space>(indices)] ZS_LAMBDA(size_type i) mutable {
+      const auto pad = arena_t(false_c, &gv, gv.worldToIndex(points[i]));
+      keys[i] = detail::leaf_block_sort_key<dim>(integer_coord_type::init(
+          [&pad](int d) -> Ti { return pad.iCorner[d] >> traits::side_bits; }));
+      indices[i] = i;
+    });
+    radix_sort_pair(pol, keys.begin(), indices.begin(), sortedKeys.begin(), sortedIndices.begin(),
+                    n);
+
+    /// bucket boundaries
+    Vector<size_type> marks{allocator, n}, bucketNos{allocator, n};
+    pol(range(n), [keys = view<space>(sortedKeys),
+                   marks = view<space>(marks)] ZS_LAMBDA(size_type i) mutable {
+      marks[i] = (i == 0 || keys[i] != keys[i - 1]) ? 1 : 0;
+    });
+    exclusive_scan(pol, marks.begin(), marks.end(), bucketNos.begin());
+    const size_type nbuckets = bucketNos.getVal(n - 1) + marks.getVal(n - 1);
+
+    /// resolve the leaf blocks of every bucket once, at its first query
+    constexpr int num_corners = 1 << dim;
+    using index_t = RM_CVREF_T(traits::query(declval<const grid_view_t &>(),
+                                             declval<const integer_coord_type &>()));
+    Vector<integer_coord_type> bucketOrigins{allocator, nbuckets};
+    Vector<index_t> bucketBlocks{allocator, nbuckets * num_corners};
+    pol(range(n), [gv = proxy<space>(grid), points = view<space>(points),
+                   indices = view<space>(sortedIndices), marks = view<space>(marks),
+                   bucketNos = view<space>(bucketNos), origins = view<space>(bucketOrigins),
+                   blocks = view<space>(bucketBlocks)] ZS_LAMBDA(size_type i) mutable {
+      if (!marks[i]) return;
+      constexpr Ti side_length = traits::side_length;
+      const auto bi = bucketNos[i];
+      const auto pad = arena_t(false_c, &gv, gv.worldToIndex(points[indices[i]]));
+      const integer_coord_type origin = pad.iCorner & ~(side_length - 1);
+      origins[bi] = origin;
+      for (int c = 0; c != num_corners; ++c) {
+        integer_coord_type blockOrigin = origin;
+        for (int d = 0; d != dim; ++d)
+          if (c & (1 << (dim - 1 - d))) blockOrigin[d] += side_length;
+        blocks[bi * num_corners + c] = traits::query(gv, blockOrigin);
+      }
+    });
+
+    /// interpolate every query with the blocks of its bucket
+    pol(range(n),
+        [gv = proxy<space>(grid), points = view<space>(points), out = view<space>(out),
+         indices = view<space>(sortedIndices), marks = view<space>(marks),
+         bucketNos = view<space>(bucketNos), origins = view<space>(bucketOrigins),
+         blocks = view<space>(bucketBlocks), chn] ZS_LAMBDA(size_type i) mutable {
+          constexpr Ti side_length = traits::side_length;
+          const auto pi = indices[i];
+          const auto bi = bucketNos[i] + marks[i] - 1;
+          const auto pad = arena_t(false_c, &gv, gv.worldToIndex(points[pi]));
+          const integer_coord_type origin = pad.iCorner & ~(side_length - 1);
+          // keys may alias for extremely distant blocks, hence re-resolve when needed
+          const bool sameOrigin = origin == origins[bi];
+          if constexpr (arena_t::is_blocked_storage) {
+            // the arena gathers contiguous rows from the blocks handed over through the cache
+            typename arena_t::block_cache_type cache{};
+            if (sameOrigin) {
+              cache.origin = origin;
+              for (int c = 0; c != num_corners; ++c) cache.blocks[c] = blocks[bi * num_corners + c];
+              cache.resolved = (1u << num_corners) - 1;
+            }
+            out[pi] = pad.isample(chn, cache, gv._background);
+          } else {
+            index_t bnos[num_corners];
+            for (int c = 0; c != num_corners; ++c) {
+              if (sameOrigin)
+                bnos[c] = blocks[bi * num_corners + c];
+              else {
+                integer_coord_type blockOrigin = origin;
+                for (int d = 0; d != dim; ++d)
+                  if (c & (1 << (dim - 1 - d))) blockOrigin[d] += side_length;
+                bnos[c] = traits::query(gv, blockOrigin);
+              }
+            }
+            typename grid_view_t::value_type ret = 0;
+            for (auto loc : pad.range()) {
+              const auto coord = pad.coord(loc);
+              int c = 0;
+              bool inRange = true;
+              for (int d = 0; d != dim; ++d) {
+                const Ti offset = coord[d] - origin[d];
+                if (offset < 0 || offset >= side_length + side_length) inRange = false;
+                c = (c << 1) | (offset >= side_length ? 1 : 0);
+              }
+              typename grid_view_t::value_type v{};
+              if (inRange && bnos[c] != grid_view_t::sentinel_v)
+                v = traits::value(gv, chn, bnos[c], coord);
+              else
+                v = traits::fallback(gv, chn, coord);
+              ret += pad.weight(loc) * v;
+            }
+            out[pi] = ret;
+          }
+        });
+  }
+  template <kernel_e kt = kernel_e::linear, typename ExecPol, typename GridT, typename T,
+            int dim, typename PointAllocatorT, typename OutAllocatorT,
+            enable_if_all<is_spg_v<GridT> || is_ag_v<GridT>, GridT::dim == dim> = 0>
+  void sample(ExecPol &&pol, const GridT &grid, const Vector<vec<T, dim>, PointAllocatorT> &points,
+              const SmallString &propName,
+              Vector<typename GridT::value_type, OutAllocatorT> &out, wrapv<kt> = {}) {
+    if (!grid.hasProperty(propName))
+      throw std::runtime_error(
+          fmt::format("[sample] property \"{}\" does not exist", propName.asChars()));
+    sample(FWD(pol), grid, points, grid.getPropertyOffset(propName), out, wrapv<kt>{});
+  }
+
+}  // namespace zs
@@ -105,7 +105,7 @@ namespace zs {
         v2 = x;
         v1(i) = x(i) + eps;
         v2(i) = x(i) - eps;
-        diff(i) = (getSignedDistance(v1) - getSignedDistance(v2)) / (eps + eps);
+        diff(i) = (this->getSignedDistance(v1) - this->getSignedDistance(v2)) / (eps + eps);
       }
       return diff.normalized();
     }
@@ -223,7 +223,7 @@ namespace zs {
         v2 = x;
         v1(i) = x(i) + eps;
         v2(i) = x(i) - eps;
-        diff(i) = (getSignedDistance(v1) - getSignedDistance(v2)) / (eps + eps);
+        diff(i) = (this->getSignedDistance(v1) - this->getSignedDistance(v2)) / (eps + eps);
       }
       return diff.normalized();
     }
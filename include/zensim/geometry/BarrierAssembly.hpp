@@ -0,0 +1,508 @@
+#pragma once
+#include "Distance.hpp"
+#include "SpatialQuery.hpp"
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/matrix/Eigen.hpp"
+#include "zensim/math/matrix/SparseMatrix.hpp"
+
+namespace zs {
+
+  /// @brief closest-feature type of an active contact, contacts of the same type form a batch
+  /// @note the mollified variants stem from nearly parallel edge-edge pairs
+  enum struct barrier_contact_e : int { pp = 0, pe, pt, ee, ppm, pem, eem, num_types };
+
+  namespace detail {
+    /// vertices (among the 4 stored) the distance is measured between
+    template <barrier_contact_e type> constexpr int barrier_num_dist_verts() noexcept {
+      if constexpr (type == barrier_contact_e::pp || type == barrier_contact_e::ppm)
+        return 2;
+      else if constexpr (type == barrier_contact_e::pe || type == barrier_contact_e::pem)
+        return 3;
+      else
+        return 4;
+    }
+    template <barrier_contact_e type> constexpr int barrier_dist_vert(int i) noexcept {
+      // mollified contacts keep both edges (a0', a1', b0', b1'), distance taken from a0' to b0'
+      // (ppm) or to edge b0'b1' (pem)
+      if constexpr (type == barrier_contact_e::ppm || type == barrier_contact_e::pem)
+        return i == 0 ? 0 : i + 1;
+      else
+        return i;
+    }
+    /// @brief (a0, a1, b0, b1) permutation per ee_distance_type, the closest features become
+    /// a0' and b0' (b0'b1' for point-edge)
+    constexpr int ee_contact_perm(int eeType, int i) noexcept {
+      constexpr int perms[9][4]
+          = {{0, 1, 2, 3}, {0, 1, 3, 2}, {0, 1, 2, 3}, {1, 0, 2, 3}, {1, 0, 3, 2},
+             {1, 0, 2, 3}, {2, 3, 0, 1}, {3, 2, 0, 1}, {0, 1, 2, 3}};
+      return perms[eeType][i];
+    }
+
+    /// @brief barrier energy, gradient and hessian (w.r.t. the 4 stored vertices) of one contact
+    template <barrier_contact_e type, bool ProjectPD, typename T>
+    constexpr T barrier_local(const vec<T, 3> (&x)[4], T eps, T dHat2, T kappa, vec<T, 12> &grad,
+                              vec<T, 12, 12> &hess) noexcept {
+      constexpr int nv = barrier_num_dist_verts<type>();
+      constexpr int nd = nv * 3;
+      constexpr bool mollified = type == barrier_contact_e::ppm || type == barrier_contact_e::pem
+                                 || type == barrier_contact_e::eem;
+      constexpr int v0 = barrier_dist_vert<type>(0), v1 = barrier_dist_vert<type>(1),
+                    v2 = barrier_dist_vert<type>(2 % nv), v3 = barrier_dist_vert<type>(3 % nv);
+      T d2{};
+      vec<T, nd> dg{};
+      vec<T, nd, nd> dH{};
+      if constexpr (nv == 2) {
+        d2 = dist2_pp(x[v0], x[v1]);
+        auto g = dist_grad_pp(x[v0], x[v1]);
+        dH = dist_hess_pp(x[v0], x[v1]);
+        for (int i = 0; i != nd; ++i) dg.val(i) = g.val(i);
+      } else if constexpr (nv == 3) {
+        d2 = dist2_pe(x[v0], x[v1], x[v2]);
+        auto g = dist_grad_pe(x[v0], x[v1], x[v2]);
+        dH = dist_hess_pe(x[v0], x[v1], x[v2]);
+        for (int i = 0; i != nd; ++i) dg.val(i) = g.val(i);
+      } else if constexpr (type == barrier_contact_e::pt) {
+        d2 = dist2_pt(x[v0], x[v1], x[v2], x[v3]);
+        auto g = dist_grad_pt(x[v0], x[v1], x[v2], x[v3]);
+        dH = dist_hess_pt(x[v0], x[v1], x[v2], x[v3]);
+        for (int i = 0; i != nd; ++i) dg.val(i) = g.val(i);
+      } else {
+        d2 = dist2_ee(x[v0], x[v1], x[v2], x[v3]);
+        auto g = dist_grad_ee(x[v0], x[v1], x[v2], x[v3]);
+        dH = dist_hess_ee(x[v0], x[v1], x[v2], x[v3]);
+        for (int i = 0; i != nd; ++i) dg.val(i) = g.val(i);
+      }
+      const T b = barrier(d2, dHat2, kappa);
+      const T bg = barrier_gradient(d2, dHat2, kappa);
+      const T bh = barrier_hessian(d2, dHat2, kappa);
+      // d/dx b(d2(x))
+      auto gb = dg * bg;
+      auto Hb = dH * bg;
+      for (int i = 0; i != nd; ++i)
+        for (int j = 0; j != nd; ++j) Hb(i, j) += bh * dg.val(i) * dg.val(j);
+
+      // scatter the distance dofs to the 4 stored vertices
+      constexpr auto dof = [](int i) { return barrier_dist_vert<type>(i / 3) * 3 + i % 3; };
+      grad = vec<T, 12>::zeros();
+      hess = vec<T, 12, 12>::zeros();
+      if constexpr (!mollified) {
+        if constexpr (ProjectPD) make_pd(Hb);
+        for (int i = 0; i != nd; ++i) {
+          grad.val(dof(i)) = gb.val(i);
+          for (int j = 0; j != nd; ++j) hess(dof(i), dof(j)) = Hb(i, j);
+        }
+        return b;
+      } else {
+        // e = m(x) b(x), mollifier m is invariant to the vertex permutation
+        const T m = mollifier_ee(x[0], x[1], x[2], x[3], eps);
+        auto gm = mollifier_grad_ee(x[0], x[1], x[2], x[3], eps);
+        auto Hm = mollifier_hess_ee(x[0], x[1], x[2], x[3], eps);
+        auto gbe = vec<T, 12>::zeros();
+        for (int i = 0; i != nd; ++i) gbe.val(dof(i)) = gb.val(i);
+        for (int i = 0; i != 12; ++i) {
+          grad.val(i) = m * gbe.val(i) + b * gm.val(i);
+          for (int j = 0; j != 12; ++j)
+            hess(i, j) = b * Hm(i, j) + gm.val(i) * gbe.val(j) + gbe.val(i) * gm.val(j);
+        }
+        for (int i = 0; i != nd; ++i)
+          for (int j = 0; j != nd; ++j) hess(dof(i), dof(j)) += m * Hb(i, j);
+        if constexpr (ProjectPD) make_pd(hess);
+        return m * b;
+      }
+    }
+  }  // namespace detail
+
+  /// ref: Incremental Potential Contact, Li et al. 2020
+  /// @brief ipc barrier of the active contacts among point-triangle and edge-edge candidates
+  /// @note classify() sorts the active contacts into homogeneous batches (barrier_contact_e),
+  /// evaluate() computes the local 12x12 systems batch by batch, and scatter() accumulates them
+  /// into the global gradient and block-csr hessian without atomics, through the slot map set up by
+  /// build_scatter_map(). The map stays valid as long as the contacts and the pattern do.
+  template <typename T = float, typename Ti = int, typename AllocatorT = ZSPmrAllocator<>>
+  struct BarrierContacts {
+    static_assert(is_floating_point_v<T>, "value_type should be floating point");
+    using value_type = T;
+    using index_type = Ti;
+    using allocator_type = AllocatorT;
+    using size_type = size_t;
+    using ivec4 = vec<index_type, 4>;
+    using vec3 = vec<value_type, 3>;
+    using vec12 = vec<value_type, 12>;
+    using mat12 = vec<value_type, 12, 12>;
+    static constexpr int num_types = (int)barrier_contact_e::num_types;
+
+    decltype(auto) get_default_allocator(memsrc_e mre, ProcID devid) const {
+      if constexpr (is_virtual_zs_allocator<allocator_type>::value)
+        return get_virtual_memory_source(mre, devid, (size_t)1 << (size_t)36, "STACK");
+      else
+        return get_memory_source(mre, devid);
+    }
+
+    BarrierContacts(const allocator_type &allocator)
+        : _inds{allocator, 0},
+          _eps{allocator, 0},
+          _energies{allocator, 0},
+          _grads{allocator, 0},
+          _hess{allocator, 0},
+          _gradContribs{allocator, 0},
+          _gradSts{allocator, 0},
+          _gradEds{allocator, 0},
+          _hessContribs{allocator, 0},
+          _hessSts{allocator, 0},
+          _hessEds{allocator, 0} {}
+    BarrierContacts(memsrc_e mre = memsrc_e::host, ProcID devid = -1)
+        : BarrierContacts{get_default_allocator(mre, devid)} {}
+
+    decltype(auto) get_allocator() const noexcept { return _inds.get_allocator(); }
+    constexpr size_type size() const noexcept { return _offsets[num_types]; }
+    constexpr size_type size(barrier_contact_e type) const noexcept {
+      return _offsets[(int)type + 1] - _offsets[(int)type];
+    }
+
+    /// @brief collect the candidates within [dHat], edge-edge pairs are not mollified
+    template <typename Policy, typename VAllocatorT, typename IAllocatorT>
+    void classify(Policy &&pol, const Vector<vec3, VAllocatorT> &xs,
+                  const Vector<ivec4, IAllocatorT> &PT, const Vector<ivec4, IAllocatorT> &EE,
+                  value_type dHat) {
+      classify_impl(FWD(pol), xs, (const Vector<vec3, VAllocatorT> *)nullptr, PT, EE, dHat);
+    }
+    /// @brief nearly parallel edge-edge pairs (w.r.t. rest positions [xsRest]) are mollified
+    template <typename Policy, typename VAllocatorT, typename IAllocatorT>
+    void classify(Policy &&pol, const Vector<vec3, VAllocatorT> &xs,
+                  const Vector<vec3, VAllocatorT> &xsRest, const Vector<ivec4, IAllocatorT> &PT,
+                  const Vector<ivec4, IAllocatorT> &EE, value_type dHat) {
+      classify_impl(FWD(pol), xs, &xsRest, PT, EE, dHat);
+    }
+
+    /// @brief local energies, gradients and (optionally psd-projected) hessians of every contact
+    /// @return total barrier energy
+    template <typename Policy, typename VAllocatorT, bool ProjectPD = true>
+    value_type evaluate(Policy &&pol, const Vector<vec3, VAllocatorT> &xs, value_type dHat,
+                        value_type kappa, wrapv<ProjectPD> = {}) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      if (!valid_memspace_for_execution(pol, get_allocator()))
+        throw std::runtime_error(
+            "[BarrierContacts::evaluate] current memory location not compatible with the execution "
+            "policy");
+      const size_type n = size();
+      _energies.resize(n);
+      _grads.resize(n);
+      _hess.resize(n);
+      if (n == 0) return 0;
+      const value_type dHat2 = dHat * dHat;
+      auto evalBatch = [&](auto typeTag) {
+        constexpr barrier_contact_e type = RM_CVREF_T(typeTag)::value;
+        const size_type st = _offsets[(int)type];
+        const size_type cnt = _offsets[(int)type + 1] - st;
+        if (cnt == 0) return;
+        pol(range(cnt), [xs = view<space>(xs), inds = view<space>(_inds), eps = view<space>(_eps),
+                         es = view<space>(_energies), grads = view<space>(_grads),
+                         hess = view<space>(_hess), st, dHat2,
+                         kappa] ZS_LAMBDA(size_type i) mutable {
+          const auto k = st + i;
+          const auto ind = inds[k];
+          vec3 x[4];
+          for (int v = 0; v != 4; ++v) x[v] = ind[v] >= 0 ? xs[ind[v]] : vec3::zeros();
+          vec12 g;
+          mat12 H;
+          es[k] = detail::barrier_local<type, ProjectPD>(x, eps[k], dHat2, kappa, g, H);
+          grads[k] = g;
+          hess[k] = H;
+        });
+      };
+      evalBatch(wrapv<barrier_contact_e::pp>{});
+      evalBatch(wrapv<barrier_contact_e::pe>{});
+      evalBatch(wrapv<barrier_contact_e::pt>{});
+      evalBatch(wrapv<barrier_contact_e::ee>{});
+      evalBatch(wrapv<barrier_contact_e::ppm>{});
+      evalBatch(wrapv<barrier_contact_e::pem>{});
+      evalBatch(wrapv<barrier_contact_e::eem>{});
+
+      Vector<value_type> res{get_temporary_memory_source(pol), 1};
+      reduce(pol, std::begin(_energies), std::end(_energies), std::begin(res), (value_type)0);
+      return res.getVal();
+    }
+
+    /// @brief resolve the destination of every local block and gradient entry
+    /// @note the pattern of [spmat] should contain all (i, j) vertex pairs of the contacts
+    template <typename Policy, bool RowMajor, typename Tn, typename SAllocatorT>
+    void build_scatter_map(
+        Policy &&pol,
+        const SparseMatrix<vec<value_type, 3, 3>, RowMajor, index_type, Tn, SAllocatorT> &spmat) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      if (!valid_memspace_for_execution(pol, get_allocator()))
+        throw std::runtime_error(
+            "[BarrierContacts::build_scatter_map] current memory location not compatible with the "
+            "execution policy");
+      const size_type n = size();
+      const size_type numVerts = spmat.rows();
+      const size_type nnz = spmat.nnz();
+      auto allocator = get_temporary_memory_source(pol);
+
+      /// gradient, contribution (k * 4 + a) sorted by vertex
+      {
+        const size_type m = n * 4;
+        Vector<u32> keys{allocator, m}, sortedKeys{allocator, m};
+        Vector<size_type> contribs{allocator, m};
+        _gradContribs.resize(m);
+        pol(range(m), [inds = view<space>(_inds), keys = view<space>(keys),
+                       contribs = view<space>(contribs),
+                       numVerts] ZS_LAMBDA(size_type c) mutable {
+          const auto vi = inds[c / 4][c % 4];
+          keys[c] = vi >= 0 ? (u32)vi : (u32)numVerts;
+          contribs[c] = c;
+        });
+        radix_sort_pair(pol, keys.begin(), contribs.begin(), sortedKeys.begin(),
+                        _gradContribs.begin(), m);
+        build_runs(pol, sortedKeys, _gradSts, _gradEds, numVerts);
+      }
+      /// hessian, contribution (k * 16 + a * 4 + b) sorted by the block slot of spmat
+      {
+        const size_type m = n * 16;
+        Vector<u32> keys{allocator, m}, sortedKeys{allocator, m};
+        Vector<size_type> contribs{allocator, m};
+        _hessContribs.resize(m);
+        pol(range(m), [inds = view<space>(_inds), spmat = view<space>(spmat),
+                       keys = view<space>(keys), contribs = view<space>(contribs),
+                       nnz] ZS_LAMBDA(size_type c) mutable {
+          const auto ind = inds[c / 16];
+          const auto vi = ind[(c / 4) % 4], vj = ind[c % 4];
+          if (vi >= 0 && vj >= 0) {
+            const auto slot = spmat.locate(vi, vj);
+            keys[c] = slot < nnz ? (u32)slot : detail::deduce_numeric_max<u32>();
+          } else
+            keys[c] = (u32)nnz;
+          contribs[c] = c;
+        });
+        radix_sort_pair(pol, keys.begin(), contribs.begin(), sortedKeys.begin(),
+                        _hessContribs.begin(), m);
+        if (m && sortedKeys.getVal(m - 1) == detail::deduce_numeric_max<u32>())
+          throw std::runtime_error(
+              "[BarrierContacts::build_scatter_map] contact block missing from the sparse matrix "
+              "pattern");
+        build_runs(pol, sortedKeys, _hessSts, _hessEds, nnz);
+      }
+    }
+
+    /// @brief grad += dE/dx, hessian blocks += d2E/dx2, each destination summed by one thread
+    template <typename Policy, typename VAllocatorT, bool RowMajor, typename Tn,
+              typename SAllocatorT>
+    void scatter(
+        Policy &&pol, Vector<vec3, VAllocatorT> &grad,
+        SparseMatrix<vec<value_type, 3, 3>, RowMajor, index_type, Tn, SAllocatorT> &spmat) const {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      if (!valid_memspace_for_execution(pol, get_allocator()))
+        throw std::runtime_error(
+            "[BarrierContacts::scatter] current memory location not compatible with the execution "
+            "policy");
+      if (_gradSts.size() != grad.size() || _hessSts.size() != spmat.nnz())
+        throw std::runtime_error(
+            "[BarrierContacts::scatter] scatter map out of date, call build_scatter_map first");
+      pol(range(grad.size()),
+          [grad = view<space>(grad), grads = view<space>(_grads),
+           contribs = view<space>(_gradContribs), sts = view<space>(_gradSts),
+           eds = view<space>(_gradEds)] ZS_LAMBDA(size_type vi) mutable {
+            const auto st = sts[vi], ed = eds[vi];
+            if (st == ed) return;
+            auto sum = vec3::zeros();
+            for (auto i = st; i != ed; ++i) {
+              const auto c = contribs[i];
+              const auto &g = grads[c / 4];
+              for (int d = 0; d != 3; ++d) sum.val(d) += g.val((c % 4) * 3 + d);
+            }
+            grad[vi] += sum;
+          });
+      pol(range(spmat.nnz()),
+          [vals = view<space>(spmat._vals), hess = view<space>(_hess),
+           contribs = view<space>(_hessContribs), sts = view<space>(_hessSts),
+           eds = view<space>(_hessEds)] ZS_LAMBDA(size_type slot) mutable {
+            const auto st = sts[slot], ed = eds[slot];
+            if (st == ed) return;
+            auto sum = vec<value_type, 3, 3>::zeros();
+            for (auto i = st; i != ed; ++i) {
+              const auto c = contribs[i];
+              const auto &H = hess[c / 16];
+              const int r = ((c / 4) % 4) * 3, s = (c % 4) * 3;
+              for (int a = 0; a != 3; ++a)
+                for (int b = 0; b != 3; ++b) sum(a, b) += H(r + a, s + b);
+            }
+            vals[slot] += sum;
+          });
+    }
+
+    Vector<ivec4, allocator_type> _inds;     // sorted by barrier_contact_e, -1 for unused slots
+    Vector<value_type, allocator_type> _eps;  // mollifier threshold
+    Vector<value_type, allocator_type> _energies;
+    Vector<vec12, allocator_type> _grads;
+    Vector<mat12, allocator_type> _hess;
+    size_type _offsets[num_types + 1] = {};  // batch ranges (host)
+    /// scatter map, contribution ids (up to 16 per contact) and their runs exceed index_type
+    Vector<size_type, allocator_type> _gradContribs, _gradSts, _gradEds;
+    Vector<size_type, allocator_type> _hessContribs, _hessSts, _hessEds;
+
+  protected:
+    template <typename Policy, typename VAllocatorT, typename IAllocatorT>
+    void classify_impl(Policy &&pol, const Vector<vec3, VAllocatorT> &xs,
+                       const Vector<vec3, VAllocatorT> *xsRest,
+                       const Vector<ivec4, IAllocatorT> &PT, const Vector<ivec4, IAllocatorT> &EE,
+                       value_type dHat) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      if (!valid_memspace_for_execution(pol, get_allocator())
+          || !valid_memspace_for_execution(pol, xs.get_allocator())
+          || !valid_memspace_for_execution(pol, PT.get_allocator())
+          || !valid_memspace_for_execution(pol, EE.get_allocator())
+          || (xsRest && !valid_memspace_for_execution(pol, xsRest->get_allocator())))
+        throw std::runtime_error(
+            "[BarrierContacts::classify] current memory location not compatible with the "
+            "execution policy");
+      const size_type npt = PT.size(), nee = EE.size(), n = npt + nee;
+      for (auto &o : _offsets) o = 0;
+      _inds.resize(0);
+      _eps.resize(0);
+      if (n == 0) return;
+
+      auto allocator = get_temporary_memory_source(pol);
+      Vector<u32> keys{allocator, n}, sortedKeys{allocator, n};
+      Vector<index_type> ids{allocator, n}, sortedIds{allocator, n};
+      Vector<ivec4> cands{allocator, n};
+      Vector<value_type> candEps{allocator, n};
+      const bool mollify = xsRest != nullptr;
+      const value_type dHat2 = dHat * dHat;
+      pol(range(n), [xs = view<space>(xs), xsRest = view<space>(mollify ? *xsRest : xs),
+                     PT = view<space>(PT), EE = view<space>(EE), keys = view<space>(keys),
+                     ids = view<space>(ids), cands = view<space>(cands),
+                     candEps = view<space>(candEps), npt, dHat2,
+                     mollify] ZS_LAMBDA(size_type k) mutable {
+        ids[k] = (index_type)k;
+        candEps[k] = 0;
+        barrier_contact_e type = barrier_contact_e::num_types;
+        value_type d2 = dHat2;
+        ivec4 ind{-1, -1, -1, -1};
+        if (k < npt) {
+          const auto pt = PT[k];
+          const auto p = xs[pt[0]], t0 = xs[pt[1]], t1 = xs[pt[2]], t2 = xs[pt[3]];
+          const int ptType = pt_distance_type(p, t0, t1, t2);
+          switch (ptType) {
+            case 0:
+            case 1:
+            case 2: {
+              const int tv = ptType + 1;
+              d2 = dist2_pp(p, xs[pt[tv]]);
+              type = barrier_contact_e::pp;
+              ind = ivec4{pt[0], pt[tv], -1, -1};
+            } break;
+            case 3:
+              d2 = dist2_pe(p, t0, t1);
+              type = barrier_contact_e::pe;
+              ind = ivec4{pt[0], pt[1], pt[2], -1};
+              break;
+            case 4:
+              d2 = dist2_pe(p, t1, t2);
+              type = barrier_contact_e::pe;
+              ind = ivec4{pt[0], pt[2], pt[3], -1};
+              break;
+            case 5:
+              d2 = dist2_pe(p, t2, t0);
+              type = barrier_contact_e::pe;
+              ind = ivec4{pt[0], pt[3], pt[1], -1};
+              break;
+            case 6:
+              d2 = dist2_pt(p, t0, t1, t2);
+              type = barrier_contact_e::pt;
+              ind = pt;
+              break;
+            default:
+              break;
+          }
+        } else {
+          const auto ee = EE[k - npt];
+          const auto eeType = ee_distance_type(xs[ee[0]], xs[ee[1]], xs[ee[2]], xs[ee[3]]);
+          ivec4 perm{};
+          for (int v = 0; v != 4; ++v) perm[v] = ee[detail::ee_contact_perm(eeType, v)];
+          const auto a0 = xs[perm[0]], a1 = xs[perm[1]], b0 = xs[perm[2]], b1 = xs[perm[3]];
+          int nv = 4;
+          if (eeType == 0 || eeType == 1 || eeType == 3 || eeType == 4) {
+            d2 = dist2_pp(a0, b0);
+            nv = 2;
+          } else if (eeType == 8)
+            d2 = dist2_ee(a0, a1, b0, b1);
+          else {
+            d2 = dist2_pe(a0, b0, b1);
+            nv = 3;
+          }
+          bool mollified = false;
+          if (mollify) {
+            const auto eps = mollifier_threshold_ee(xsRest[ee[0]], xsRest[ee[1]], xsRest[ee[2]],
+                                                    xsRest[ee[3]]);
+            mollified = cn2_ee(a0, a1, b0, b1) < eps;
+            candEps[k] = eps;
+          }
+          if (mollified) {
+            ind = perm;
+            type = nv == 2   ? barrier_contact_e::ppm
+                   : nv == 3 ? barrier_contact_e::pem
+                             : barrier_contact_e::eem;
+          } else if (nv == 2) {
+            ind = ivec4{perm[0], perm[2], -1, -1};
+            type = barrier_contact_e::pp;
+          } else if (nv == 3) {
+            ind = ivec4{perm[0], perm[2], perm[3], -1};
+            type = barrier_contact_e::pe;
+          } else {
+            ind = perm;
+            type = barrier_contact_e::ee;
+          }
+        }
+        if (!(d2 < dHat2)) type = barrier_contact_e::num_types;
+        keys[k] = (u32)type;
+        cands[k] = ind;
+      });
+      radix_sort_pair(pol, keys.begin(), ids.begin(), sortedKeys.begin(), sortedIds.begin(), n, 0,
+                      (int)bit_length((u32)num_types));
+
+      /// batch boundaries, bounds[t] is the first contact of type >= t
+      Vector<size_type> bounds{allocator, (size_t)num_types + 1};
+      pol(range(n + 1), [keys = view<space>(sortedKeys), bounds = view<space>(bounds),
+                         n] ZS_LAMBDA(size_type i) mutable {
+        const int prev = i == 0 ? -1 : (int)keys[i - 1];
+        const int cur = i == n ? num_types : (int)keys[i];
+        for (int t = prev + 1; t <= cur && t <= num_types; ++t) bounds[t] = i;
+      });
+      bounds = bounds.clone({memsrc_e::host, -1});
+      for (int t = 0; t <= num_types; ++t) _offsets[t] = bounds[t];
+
+      const size_type nActive = _offsets[num_types];
+      _inds.resize(nActive);
+      _eps.resize(nActive);
+      pol(range(nActive), [inds = view<space>(_inds), eps = view<space>(_eps),
+                           cands = view<space>(cands), candEps = view<space>(candEps),
+                           ids = view<space>(sortedIds)] ZS_LAMBDA(size_type i) mutable {
+        const auto k = ids[i];
+        inds[i] = cands[k];
+        eps[i] = candEps[k];
+      });
+    }
+
+    /// @brief [sts[key], eds[key]) ranges of the sorted keys, keys >= numKeys are skipped
+    template <typename Policy>
+    void build_runs(Policy &&pol, const Vector<u32> &sortedKeys,
+                    Vector<size_type, allocator_type> &sts,
+                    Vector<size_type, allocator_type> &eds, size_type numKeys) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      const size_type m = sortedKeys.size();
+      sts.resize(numKeys);
+      eds.resize(numKeys);
+      sts.reset(0);
+      eds.reset(0);
+      pol(range(m), [keys = view<space>(sortedKeys), sts = view<space>(sts),
+                     eds = view<space>(eds), m, numKeys] ZS_LAMBDA(size_type i) mutable {
+        const auto key = keys[i];
+        if (key >= numKeys) return;
+        if (i == 0 || keys[i - 1] != key) sts[key] = i;
+        if (i == m - 1 || keys[i + 1] != key) eds[key] = i + 1;
+      });
+    }
+  };
+
+}  // namespace zs
@@ -4065,4 +4065,103 @@ namespace zs {
     return false;
   }
 
-}  // namespace zs
\ No newline at end of file
+  /// ref: Codimensional Incremental Potential Contact, Li et al. 2021 (additive ccd)
+  /// @brief conservative time of impact within [0, tStart] of point [p] moving by [dp] against
+  /// triangle [t0, t1, t2] moving by [dt0, dt1, dt2]. Advances by safe lower bounds until the gap
+  /// shrinks below [eta] of its initial value.
+  /// @note returns false (toi = tStart) when no impact happens before tStart
+  template <typename VecTP, typename VecT, typename T,
+            enable_if_all<VecTP::dim == 1, is_same_v<typename VecTP::dims, typename VecT::dims>,
+                          is_floating_point_v<T>>
+            = 0>
+  constexpr bool accd_pt(const VecInterface<VecTP> &p, const VecInterface<VecT> &t0,
+                         const VecInterface<VecT> &t1, const VecInterface<VecT> &t2,
+                         const VecInterface<VecTP> &dp, const VecInterface<VecT> &dt0,
+                         const VecInterface<VecT> &dt1, const VecInterface<VecT> &dt2, T eta,
+                         T thickness, T tStart, T &toi) noexcept {
+    // relative motion only
+    auto mov = (dp + dt0 + dt1 + dt2) / 4;
+    auto dp_ = dp - mov, dt0_ = dt0 - mov, dt1_ = dt1 - mov, dt2_ = dt2 - mov;
+    const T maxDispMag
+        = dp_.norm()
+          + zs::sqrt(math::max(dt0_.l2NormSqr(), math::max(dt1_.l2NormSqr(), dt2_.l2NormSqr())));
+    toi = tStart;
+    if (maxDispMag == 0) return false;
+
+    auto p_ = p.clone();
+    auto t0_ = t0.clone(), t1_ = t1.clone(), t2_ = t2.clone();
+    const T thickness2 = thickness * thickness;
+    T dist2 = dist2_pt_unclassified(p_, t0_, t1_, t2_);
+    if (dist2 <= thickness2) {
+      toi = 0;
+      return true;
+    }
+    T dist = zs::sqrt(dist2);
+    const T gap = eta * (dist2 - thickness2) / (dist + thickness);
+    T toc = 0;
+    while (true) {
+      const T tocLowerBound = (1 - eta) * (dist2 - thickness2) / ((dist + thickness) * maxDispMag);
+      // degenerate primitives (nan distance), stop conservatively
+      if (!(tocLowerBound > 0)) break;
+      p_ += tocLowerBound * dp_;
+      t0_ += tocLowerBound * dt0_;
+      t1_ += tocLowerBound * dt1_;
+      t2_ += tocLowerBound * dt2_;
+      dist2 = dist2_pt_unclassified(p_, t0_, t1_, t2_);
+      dist = zs::sqrt(dist2);
+      if (toc != 0 && (dist2 - thickness2) / (dist + thickness) < gap) break;
+      toc += tocLowerBound;
+      if (toc > tStart) return false;
+    }
+    toi = toc;
+    return true;
+  }
+
+  /// @brief edge-edge counterpart of accd_pt
+  template <typename VecTA, typename VecTB, typename T,
+            enable_if_all<VecTA::dim == 1, is_same_v<typename VecTA::dims, typename VecTB::dims>,
+                          is_floating_point_v<T>>
+            = 0>
+  constexpr bool accd_ee(const VecInterface<VecTA> &ea0, const VecInterface<VecTA> &ea1,
+                         const VecInterface<VecTB> &eb0, const VecInterface<VecTB> &eb1,
+                         const VecInterface<VecTA> &dea0, const VecInterface<VecTA> &dea1,
+                         const VecInterface<VecTB> &deb0, const VecInterface<VecTB> &deb1, T eta,
+                         T thickness, T tStart, T &toi) noexcept {
+    // relative motion only
+    auto mov = (dea0 + dea1 + deb0 + deb1) / 4;
+    auto dea0_ = dea0 - mov, dea1_ = dea1 - mov, deb0_ = deb0 - mov, deb1_ = deb1 - mov;
+    const T maxDispMag = zs::sqrt(math::max(dea0_.l2NormSqr(), dea1_.l2NormSqr()))
+                         + zs::sqrt(math::max(deb0_.l2NormSqr(), deb1_.l2NormSqr()));
+    toi = tStart;
+    if (maxDispMag == 0) return false;
+
+    auto ea0_ = ea0.clone(), ea1_ = ea1.clone();
+    auto eb0_ = eb0.clone(), eb1_ = eb1.clone();
+    const T thickness2 = thickness * thickness;
+    T dist2 = dist2_ee_unclassified(ea0_, ea1_, eb0_, eb1_);
+    if (dist2 <= thickness2) {
+      toi = 0;
+      return true;
+    }
+    T dist = zs::sqrt(dist2);
+    const T gap = eta * (dist2 - thickness2) / (dist + thickness);
+    T toc = 0;
+    while (true) {
+      const T tocLowerBound = (1 - eta) * (dist2 - thickness2) / ((dist + thickness) * maxDispMag);
+      // degenerate primitives (nan distance), stop conservatively
+      if (!(tocLowerBound > 0)) break;
+      ea0_ += tocLowerBound * dea0_;
+      ea1_ += tocLowerBound * dea1_;
+      eb0_ += tocLowerBound * deb0_;
+      eb1_ += tocLowerBound * deb1_;
+      dist2 = dist2_ee_unclassified(ea0_, ea1_, eb0_, eb1_);
+      dist = zs::sqrt(dist2);
+      if (toc != 0 && (dist2 - thickness2) / (dist + thickness) < gap) break;
+      toc += tocLowerBound;
+      if (toc > tStart) return false;
+    }
+    toi = toc;
+    return true;
+  }
+
+}  // namespace zs
@@ -0,0 +1,368 @@
+#pragma once
+#include "zensim/container/Vector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/geometry/Distance.hpp"
+#include "zensim/geometry/Geometry.hpp"
+
+namespace zs {
+
+  /// ref: A Large Scale Benchmark and an Inclusion-Based Algorithm for Continuous Collision
+  /// Detection, Wang et al. 2021
+  /// interval (inclusion-based) root finding over the (t, u, v) parameter domain in double
+  /// precision. A box is discarded only when one axis of the codomain is certainly nonzero, hence
+  /// no root is ever missed; a box is accepted once its codomain is within [tolerance]. Queries
+  /// left unresolved go to the exact vertexFaceCCD / edgeEdgeCCD when their 64-bit rationals
+  /// cannot overflow, otherwise they are reported as collisions at the earliest time a root may
+  /// exist.
+  namespace detail {
+    enum ccd_result_e : int { ccd_ambiguous = -1, ccd_separated = 0, ccd_collided = 1 };
+
+    /// @note corner k of the box is (t[k >> 2 & 1], u[k >> 1 & 1], v[k & 1])
+    struct ccd_box {
+      double t[2], u[2], v[2];
+    };
+
+    /// @note [ps], [pe] hold the start/end positions of the 4 primitive vertices (vertex, face or
+    /// edge0, edge1 vertices), F(t, u, v) is the vertex-face or edge-edge difference vector. F is
+    /// multilinear in (t, u, v), hence its range over a box is spanned by the 8 corner values.
+    template <bool IsVF>
+    constexpr void ccd_eval_corners(const double ps[4][3], const double pe[4][3], int d,
+                                    const ccd_box &box, double c[8]) noexcept {
+      for (int ti = 0; ti != 2; ++ti) {
+        double p[4];
+        for (int k = 0; k != 4; ++k) p[k] = ps[k][d] + (pe[k][d] - ps[k][d]) * box.t[ti];
+        for (int ui = 0; ui != 2; ++ui)
+          for (int vi = 0; vi != 2; ++vi) {
+            const double u = box.u[ui], v = box.v[vi];
+            if constexpr (IsVF)
+              c[ti << 2 | ui << 1 | vi] = p[0] - (p[1] + (p[2] - p[1]) * u + (p[3] - p[1]) * v);
+            else
+              c[ti << 2 | ui << 1 | vi] = (p[0] + (p[1] - p[0]) * u) - (p[2] + (p[3] - p[2]) * v);
+          }
+      }
+    }
+
+    /// @brief a priori bound of the rounding error of ccd_eval_corners on an axis whose
+    /// coordinates are at most [xmax] in magnitude
+    /// @note with u the unit roundoff and gamma_k = k u / (1 - k u) the bound of k chained
+    /// roundings, each lerped position p = ps + (pe - ps) t is off by at most 3 gamma_3 xmax (E)
+    /// and bounded by P = xmax + E. The vertex-face difference
+    /// p0 - (p1 + (p2 - p1) u + (p3 - p1) v) has coefficients summing to at most 4 in magnitude
+    /// and rounds at most 5 times on terms summing to 6 P, the edge-edge one sums to 2 and rounds
+    /// at most 4 times on 6 P.
+    template <bool IsVF> constexpr double ccd_rounding_error_bound(double xmax) noexcept {
+      constexpr double u = deduce_numeric_epsilon<double>() * 0.5;
+      constexpr auto gamma = [](int k) { return k * u / (1 - k * u); };
+      const double E = 3 * gamma(3) * xmax;
+      const double P = xmax + E;
+      const double bound = IsVF ? 4 * E + 6 * gamma(5) * P : 2 * E + 6 * gamma(4) * P;
+      // inflated for the rounding of the bound itself and for underflowing products
+      return bound * (1 + 64 * deduce_numeric_epsilon<double>())
+             + 8 * limits<double>::denorm_min();
+    }
+
+    /// @brief largest T not above [t] (t >= 0)
+    template <typename T> constexpr T ccd_round_down(double t) noexcept {
+      T r = (T)t;
+      if constexpr (is_same_v<T, float>)
+        if ((double)r > t) r = reinterpret_bits<float>(reinterpret_bits<u32>(r) - 1);
+      return r;
+    }
+
+    template <bool IsVF, int StackSize = 128>
+    constexpr int ccd_interval_root_finder(const double ps[4][3], const double pe[4][3],
+                                           double tmax, double tolerance, int maxChecks,
+                                           double &toi) noexcept {
+      double delta[3];
+      for (int d = 0; d != 3; ++d) {
+        double xmax = 0;
+        for (int k = 0; k != 4; ++k) {
+          xmax = math::max(xmax, math::abs(ps[k][d]));
+          xmax = math::max(xmax, math::abs(pe[k][d]));
+        }
+        delta[d] = ccd_rounding_error_bound<IsVF>(xmax);
+      }
+
+      ccd_box stack[StackSize];
+      int top = 0;
+      stack[top++] = ccd_box{{0, tmax}, {0, 1}, {0, 1}};
+      bool found = false;
+      toi = tmax;
+      for (int checks = 0; top;) {
+        const auto box = stack[--top];
+        if (found && box.t[0] >= toi) continue;
+        if constexpr (IsVF)
+          if (box.u[0] + box.v[0] > 1) continue;
+        if (++checks > maxChecks || top + 2 > StackSize) {
+          // unresolved, report the earliest time a root may still exist
+          double lb = box.t[0];
+          for (int i = 0; i != top; ++i) lb = math::min(lb, stack[i].t[0]);
+          if (!found || lb < toi) toi = lb;
+          return ccd_ambiguous;
+        }
+
+        double c[3][8];
+        bool excluded = false, small = true;
+        for (int d = 0; d != 3 && !excluded; ++d) {
+          double mi = detail::deduce_numeric_max<double>(),
+                 ma = detail::deduce_numeric_lowest<double>();
+          ccd_eval_corners<IsVF>(ps, pe, d, box, c[d]);
+          for (int k = 0; k != 8; ++k) {
+            mi = math::min(mi, c[d][k]);
+            ma = math::max(ma, c[d][k]);
+          }
+          if (mi > delta[d] || ma < -delta[d]) excluded = true;
+          if (ma - mi > tolerance) small = false;
+        }
+        if (excluded) continue;
+        if (small) {
+          toi = box.t[0];
+          found = true;
+          continue;
+        }
+
+        // split the parameter with the largest codomain variation
+        double w[3] = {0, 0, 0};
+        for (int d = 0; d != 3; ++d)
+          for (int k = 0; k != 8; ++k)
+            for (int p = 0; p != 3; ++p)
+              if (!(k & (4 >> p))) w[p] = math::max(w[p], math::abs(c[d][k | (4 >> p)] - c[d][k]));
+        int p = 0;
+        if (w[1] > w[p]) p = 1;
+        if (w[2] > w[p]) p = 2;
+        auto lo = box, hi = box;
+        double *lr = p == 0 ? lo.t : (p == 1 ? lo.u : lo.v);
+        double *hr = p == 0 ? hi.t : (p == 1 ? hi.u : hi.v);
+        const double mid = (lr[0] + lr[1]) * 0.5;
+        lr[1] = mid;
+        hr[0] = mid;
+        // earlier half is visited first
+        stack[top++] = hi;
+        stack[top++] = lo;
+      }
+      return found ? ccd_collided : ccd_separated;
+    }
+
+    /// coordinates spanning at most this many bits keep the degree 6 rational predicates of
+    /// vertexFaceCCD / edgeEdgeCCD within 64-bit integers
+    constexpr int ccd_exact_bits = 6;
+    /// @brief scales the query by a power of two (which preserves the collision) onto integers
+    /// below 2^ccd_exact_bits in magnitude
+    /// @return false if the coordinates do not fit, [ps] and [pe] are then left unspecified
+    constexpr bool ccd_exact_scale(double (&ps)[4][3], double (&pe)[4][3]) noexcept {
+      double xmax = 0;
+      for (int k = 0; k != 4; ++k)
+        for (int d = 0; d != 3; ++d)
+          xmax = math::max(xmax, math::max(math::abs(ps[k][d]), math::abs(pe[k][d])));
+      if (xmax == 0) return true;
+      int e = 0;
+      zs::frexp(xmax, &e);  // 2^(e - 1) <= xmax < 2^e
+      const int s = ccd_exact_bits - e;
+      auto scale = [s](double &x) {
+        const double y = zs::ldexp(x, s);
+        double ip{};
+        if (zs::modf(y, &ip) != 0 || zs::ldexp(y, -s) != x) return false;
+        x = y;
+        return true;
+      };
+      for (int k = 0; k != 4; ++k)
+        for (int d = 0; d != 3; ++d)
+          if (!scale(ps[k][d]) || !scale(pe[k][d])) return false;
+      return true;
+    }
+    /// @brief exact (rational) test of an unresolved query over [0, 1]
+    /// @return false if the query does not fit the exact path
+    template <bool IsVF>
+    constexpr bool ccd_exact_fallback(const double (&ps)[4][3], const double (&pe)[4][3],
+                                      bool &hit) noexcept {
+      double xs[4][3], xe[4][3];
+      for (int k = 0; k != 4; ++k)
+        for (int d = 0; d != 3; ++d) {
+          xs[k][d] = ps[k][d];
+          xe[k][d] = pe[k][d];
+        }
+      if (!ccd_exact_scale(xs, xe)) return false;
+      using vec3 = zs::vec<double, 3>;
+      auto s = [&xs](int k) { return vec3{xs[k][0], xs[k][1], xs[k][2]}; };
+      auto e = [&xe](int k) { return vec3{xe[k][0], xe[k][1], xe[k][2]}; };
+      if constexpr (IsVF)
+        hit = vertexFaceCCD(s(0), s(1), s(2), s(3), e(0), e(1), e(2), e(3));
+      else
+        hit = edgeEdgeCCD(s(0), s(1), s(2), s(3), e(0), e(1), e(2), e(3));
+      return true;
+    }
+
+    template <typename VecT>
+    constexpr void ccd_load(double (&ps)[4][3], double (&pe)[4][3], int k,
+                            const VecInterface<VecT> &s, const VecInterface<VecT> &e) noexcept {
+      for (int d = 0; d != 3; ++d) {
+        ps[k][d] = (double)s[d];
+        pe[k][d] = (double)e[d];
+      }
+    }
+  }  // namespace detail
+
+  /// @brief vertex-face ccd within [0, tmax] of the linear trajectories, [toi] receives the
+  /// (conservative, rounded down) earliest time of impact, or tmax when no collision occurs
+  /// @note a query the interval search cannot resolve within [maxChecks] box evaluations is
+  /// decided by the exact vertexFaceCCD if [tmax] is 1 and the coordinates are small dyadic
+  /// rationals (integers spanning at most 6 bits after scaling by a power of two, see
+  /// detail::ccd_exact_scale). Any other unresolved query is reported as a collision at the
+  /// lower time bound of the unresolved boxes, an unresolved but exactly confirmed collision too.
+  template <typename VecT, enable_if_all<is_floating_point_v<typename VecT::value_type>,
+                                         VecT::dim == 1, VecT::extent == 3>
+                           = 0>
+  constexpr bool vertexFaceFilteredCCD(
+      const VecInterface<VecT> &vertex_start, const VecInterface<VecT> &face_vertex0_start,
+      const VecInterface<VecT> &face_vertex1_start, const VecInterface<VecT> &face_vertex2_start,
+      const VecInterface<VecT> &vertex_end, const VecInterface<VecT> &face_vertex0_end,
+      const VecInterface<VecT> &face_vertex1_end, const VecInterface<VecT> &face_vertex2_end,
+      typename VecT::value_type &toi, typename VecT::value_type tmax = 1,
+      typename VecT::value_type tolerance = (typename VecT::value_type)1e-6,
+      int maxChecks = 100000) {
+    double ps[4][3], pe[4][3], t{};
+    detail::ccd_load(ps, pe, 0, vertex_start, vertex_end);
+    detail::ccd_load(ps, pe, 1, face_vertex0_start, face_vertex0_end);
+    detail::ccd_load(ps, pe, 2, face_vertex1_start, face_vertex1_end);
+    detail::ccd_load(ps, pe, 3, face_vertex2_start, face_vertex2_end);
+    auto res = detail::ccd_interval_root_finder<true>(ps, pe, tmax, tolerance, maxChecks, t);
+    // the exact test only tells whether a collision occurs, its time stays the conservative one
+    bool exactHit = true;
+    if (res == detail::ccd_ambiguous && tmax == 1
+        && detail::ccd_exact_fallback<true>(ps, pe, exactHit) && !exactHit)
+      res = detail::ccd_separated;
+    const bool hit = res != detail::ccd_separated;
+    toi = hit ? detail::ccd_round_down<typename VecT::value_type>(t) : tmax;
+    return hit;
+  }
+
+  /// @brief edge-edge counterpart of vertexFaceFilteredCCD, falls back to edgeEdgeCCD
+  template <typename VecT, enable_if_all<is_floating_point_v<typename VecT::value_type>,
+                                         VecT::dim == 1, VecT::extent == 3>
+                           = 0>
+  constexpr bool edgeEdgeFilteredCCD(
+      const VecInterface<VecT> &edge0_vertex0_start, const VecInterface<VecT> &edge0_vertex1_start,
+      const VecInterface<VecT> &edge1_vertex0_start, const VecInterface<VecT> &edge1_vertex1_start,
+      const VecInterface<VecT> &edge0_vertex0_end, const VecInterface<VecT> &edge0_vertex1_end,
+      const VecInterface<VecT> &edge1_vertex0_end, const VecInterface<VecT> &edge1_vertex1_end,
+      typename VecT::value_type &toi, typename VecT::value_type tmax = 1,
+      typename VecT::value_type tolerance = (typename VecT::value_type)1e-6,
+      int maxChecks = 100000) {
+    double ps[4][3], pe[4][3], t{};
+    detail::ccd_load(ps, pe, 0, edge0_vertex0_start, edge0_vertex0_end);
+    detail::ccd_load(ps, pe, 1, edge0_vertex1_start, edge0_vertex1_end);
+    detail::ccd_load(ps, pe, 2, edge1_vertex0_start, edge1_vertex0_end);
+    detail::ccd_load(ps, pe, 3, edge1_vertex1_start, edge1_vertex1_end);
+    auto res = detail::ccd_interval_root_finder<false>(ps, pe, tmax, tolerance, maxChecks, t);
+    // the exact test only tells whether a collision occurs, its time stays the conservative one
+    bool exactHit = true;
+    if (res == detail::ccd_ambiguous && tmax == 1
+        && detail::ccd_exact_fallback<false>(ps, pe, exactHit) && !exactHit)
+      res = detail::ccd_separated;
+    const bool hit = res != detail::ccd_separated;
+    toi = hit ? detail::ccd_round_down<typename VecT::value_type>(t) : tmax;
+    return hit;
+  }
+
+  /// @brief earliest time of impact within [0, tmax] over all candidate point-triangle [PT]
+  /// (vertex, face vertices) and edge-edge [EE] pairs, vertices move linearly from [xs] to [xe]
+  template <typename ExecPol, typename T, typename VAllocatorT, typename PTAllocatorT,
+            typename EEAllocatorT>
+  T ccd_min_toi(ExecPol &&pol, const Vector<vec<T, 3>, VAllocatorT> &xs,
+                const Vector<vec<T, 3>, VAllocatorT> &xe,
+                const Vector<vec<int, 4>, PTAllocatorT> &PT,
+                const Vector<vec<int, 4>, EEAllocatorT> &EE, T tmax = 1,
+                T tolerance = (T)1e-6) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = typename Vector<T, VAllocatorT>::size_type;
+    if (!valid_memspace_for_execution(pol, xs.get_allocator())
+        || !valid_memspace_for_execution(pol, xe.get_allocator())
+        || !valid_memspace_for_execution(pol, PT.get_allocator())
+        || !valid_memspace_for_execution(pol, EE.get_allocator()))
+      throw std::runtime_error(
+          "[ccd_min_toi] current memory location not compatible with the execution policy");
+    if (xs.size() != xe.size())
+      throw std::runtime_error("[ccd_min_toi] start and end positions differ in size");
+
+    const size_type npt = PT.size(), nee = EE.size();
+    if (npt + nee == 0) return tmax;
+    auto allocator = get_temporary_memory_source(pol);
+    Vector<T> tois{allocator, npt + nee}, ret{allocator, 1};
+    pol(range(npt + nee),
+        [xs = view<space>(xs), xe = view<space>(xe), PT = view<space>(PT), EE = view<space>(EE),
+         tois = view<space>(tois), npt, tmax, tolerance] ZS_LAMBDA(size_type i) mutable {
+          T toi = tmax;
+          if (i < npt) {
+            const auto inds = PT[i];
+            vertexFaceFilteredCCD(xs[inds[0]], xs[inds[1]], xs[inds[2]], xs[inds[3]],
+                                  xe[inds[0]], xe[inds[1]], xe[inds[2]], xe[inds[3]], toi, tmax,
+                                  tolerance);
+          } else {
+            const auto inds = EE[i - npt];
+            edgeEdgeFilteredCCD(xs[inds[0]], xs[inds[1]], xs[inds[2]], xs[inds[3]], xe[inds[0]],
+                                xe[inds[1]], xe[inds[2]], xe[inds[3]], toi, tmax, tolerance);
+          }
+          tois[i] = toi;
+        });
+    reduce(pol, std::begin(tois), std::end(tois), std::begin(ret), tmax, getmin<T>{});
+    return ret.getVal();
+  }
+
+  /// @brief additive ccd (accd_pt/accd_ee) over all candidate point-triangle [PT] and edge-edge
+  /// [EE] pairs (e.g. collected from LBvh or SpatialHash queries) moving along [dxs], returns the
+  /// minimum of the per-pair steps, i.e. the largest step in [0, alpha] safe for every pair
+  /// @note [tois] receives the per-pair conservative step (PT pairs first, then EE pairs): alpha
+  /// when the pair does not collide before alpha, 0 when it is already within [thickness]
+  template <typename ExecPol, typename T, typename VAllocatorT, typename PTAllocatorT,
+            typename EEAllocatorT, typename TAllocatorT>
+  T accd_max_step(ExecPol &&pol, const Vector<vec<T, 3>, VAllocatorT> &xs,
+                  const Vector<vec<T, 3>, VAllocatorT> &dxs,
+                  const Vector<vec<int, 4>, PTAllocatorT> &PT,
+                  const Vector<vec<int, 4>, EEAllocatorT> &EE, Vector<T, TAllocatorT> &tois,
+                  T alpha = 1, T eta = (T)0.1, T thickness = 0) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = typename Vector<T, VAllocatorT>::size_type;
+    if (!valid_memspace_for_execution(pol, xs.get_allocator())
+        || !valid_memspace_for_execution(pol, dxs.get_allocator())
+        || !valid_memspace_for_execution(pol, PT.get_allocator())
+        || !valid_memspace_for_execution(pol, EE.get_allocator())
+        || !valid_memspace_for_execution(pol, tois.get_allocator()))
+      throw std::runtime_error(
+          "[accd_max_step] current memory location not compatible with the execution policy");
+    if (xs.size() != dxs.size())
+      throw std::runtime_error("[accd_max_step] positions and displacements differ in size");
+
+    const size_type npt = PT.size(), nee = EE.size();
+    tois.resize(npt + nee);
+    if (npt + nee == 0) return alpha;
+    pol(range(npt + nee),
+        [xs = view<space>(xs), dxs = view<space>(dxs), PT = view<space>(PT), EE = view<space>(EE),
+         tois = view<space>(tois), npt, alpha, eta, thickness] ZS_LAMBDA(size_type i) mutable {
+          T toi = alpha;
+          if (i < npt) {
+            const auto inds = PT[i];
+            accd_pt(xs[inds[0]], xs[inds[1]], xs[inds[2]], xs[inds[3]], dxs[inds[0]],
+                    dxs[inds[1]], dxs[inds[2]], dxs[inds[3]], eta, thickness, alpha, toi);
+          } else {
+            const auto inds = EE[i - npt];
+            accd_ee(xs[inds[0]], xs[inds[1]], xs[inds[2]], xs[inds[3]], dxs[inds[0]],
+                    dxs[inds[1]], dxs[inds[2]], dxs[inds[3]], eta, thickness, alpha, toi);
+          }
+          tois[i] = toi;
+        });
+    Vector<T> ret{get_temporary_memory_source(pol), 1};
+    reduce(pol, std::begin(tois), std::end(tois), std::begin(ret), alpha, getmin<T>{});
+    return ret.getVal();
+  }
+  template <typename ExecPol, typename T, typename VAllocatorT, typename PTAllocatorT,
+            typename EEAllocatorT>
+  T accd_max_step(ExecPol &&pol, const Vector<vec<T, 3>, VAllocatorT> &xs,
+                  const Vector<vec<T, 3>, VAllocatorT> &dxs,
+                  const Vector<vec<int, 4>, PTAllocatorT> &PT,
+                  const Vector<vec<int, 4>, EEAllocatorT> &EE, T alpha = 1, T eta = (T)0.1,
+                  T thickness = 0) {
+    Vector<T> tois{get_temporary_memory_source(pol), PT.size() + EE.size()};
+    return accd_max_step(FWD(pol), xs, dxs, PT, EE, tois, alpha, eta, thickness);
+  }
+
+}  // namespace zs
@@ -63,6 +63,75 @@ namespace zs {
       return orientation_e::COPLANAR;
   }
 
+  namespace detail {
+    template <int D, typename T, typename Ti>
+    void orient_lanes_chunked(Ti n, const T* const (&ps)[D + 1][D], orientation_e* ori) noexcept {
+      constexpr Ti chunk = 64;
+      double buf[D + 1][D][chunk], det[chunk];
+      for (Ti base = 0; base < n; base += chunk) {
+        const Ti cnt = n - base < chunk ? n - base : chunk;
+        const double* p[D + 1][D];
+        for (int v = 0; v != D + 1; ++v)
+          for (int d = 0; d != D; ++d) {
+            if constexpr (is_same_v<T, double>)
+              p[v][d] = ps[v][d] + base;
+            else {
+              for (Ti l = 0; l < cnt; ++l) buf[v][d][l] = ps[v][d][base + l];
+              p[v][d] = buf[v][d];
+            }
+          }
+        if constexpr (D == 2)
+          orient2d_lanes(cnt, p[0], p[1], p[2], det);
+        else
+          orient3d_lanes(cnt, p[0], p[1], p[2], p[3], det);
+        for (Ti l = 0; l < cnt; ++l)
+          ori[base + l] = det[l] > 0   ? orientation_e::POSITIVE
+                          : det[l] < 0 ? orientation_e::NEGATIVE
+                                       : orientation_e::DEGENERATE;
+      }
+    }
+  }  // namespace detail
+
+  /// @brief orient2d of [n] queries, point coordinates laid out as structure-of-arrays
+  /// @note batched through orient2d_lanes, only near-degenerate queries take the adaptive path
+  template <typename T, typename Ti, enable_if_t<is_floating_point_v<T>> = 0>
+  void orient2d(Ti n, const T* const pa[2], const T* const pb[2], const T* const pc[2],
+                orientation_e* ori) noexcept {
+    const T* const ps[3][2] = {{pa[0], pa[1]}, {pb[0], pb[1]}, {pc[0], pc[1]}};
+    detail::orient_lanes_chunked<2>(n, ps, ori);
+  }
+  /// @brief orient3d of [n] queries, point coordinates laid out as structure-of-arrays
+  /// @note batched through orient3d_lanes, only near-degenerate queries take the adaptive path
+  template <typename T, typename Ti, enable_if_t<is_floating_point_v<T>> = 0>
+  void orient3d(Ti n, const T* const pa[3], const T* const pb[3], const T* const pc[3],
+                const T* const pd[3], orientation_e* ori) noexcept {
+    const T* const ps[4][3] = {{pa[0], pa[1], pa[2]},
+                               {pb[0], pb[1], pb[2]},
+                               {pc[0], pc[1], pc[2]},
+                               {pd[0], pd[1], pd[2]}};
+    detail::orient_lanes_chunked<3>(n, ps, ori);
+  }
+
+  namespace detail {
+    /// orient3d of the N point quadruples [ps], evaluated as one batch
+    template <int N, typename... VecTs>
+    void orient3d_batch(orientation_e (&ori)[N], const VecTs&... ps) noexcept {
+      static_assert(sizeof...(VecTs) == 4 * N, "four points per query expected");
+      double coords[4][3][N];
+      int k = 0;
+      auto gather = [&coords, &k](const auto& p) {
+        for (int d = 0; d != 3; ++d) coords[k % 4][d][k / 4] = p[d];
+        ++k;
+      };
+      (gather(ps), ...);
+      const double* const pa[3] = {coords[0][0], coords[0][1], coords[0][2]};
+      const double* const pb[3] = {coords[1][0], coords[1][1], coords[1][2]};
+      const double* const pc[3] = {coords[2][0], coords[2][1], coords[2][2]};
+      const double* const pd[3] = {coords[3][0], coords[3][1], coords[3][2]};
+      orient3d(N, pa, pb, pc, pd, ori);
+    }
+  }  // namespace detail
+
   /// ref: ExactRootParityCCD
   // Wang Bolun, Zachary Ferguson
   // bilinear
@@ -330,10 +399,12 @@ namespace zs {
         np[1] = pcg();
         np[2] = pcg();
       }
-      int o1 = orient3d(np, e1, s0, e0);
+      orientation_e o[3];
+      detail::orient3d_batch(o, np, e1, s0, e0, np, s1, s0, e0, np, e1, s0, s1);
+      int o1 = o[0];
       if (o1 == 0) return point_on_ray(s0, e0, dir0, e1);
-      int o2 = -1 * orient3d(np, s1, s0, e0);  // already know this is not 0
-      int oo = orient3d(np, e1, s0, s1);
+      int o2 = -1 * o[1];  // already know this is not 0
+      int oo = o[2];
       if (oo == 0) {  // actually can directly return 0 because s0-s1-e0 is not
                       // degenerated
         if (point_on_ray(s0, e0, dir0, s1) > 0 || point_on_ray(s0, e0, dir0, e1) > 0) return 1;
@@ -380,9 +451,11 @@ namespace zs {
         np[1] = pcg();
         np[2] = pcg();
       }
-      int o1 = orient3d(pt, np, t1, t2);
-      int o2 = orient3d(pt, np, t2, t3);  // this edge
-      int o3 = orient3d(pt, np, t3, t1);
+      orientation_e o[3];
+      detail::orient3d_batch(o, pt, np, t1, t2, pt, np, t2, t3, pt, np, t3, t1);
+      int o1 = o[0];
+      int o2 = o[1];  // this edge
+      int o3 = o[2];
       if (halfopen) {
         if (o2 == 0 && o1 == o3) return 3;  // on open edge t2-t3
       }
@@ -455,13 +528,15 @@ namespace zs {
     // the rest of cases are point not on plane and triangle not degenerated
     // 3 point or ray shoot t2-t3 edge, -1 shoot on border, 0 not intersected, 1
     // intersect interior
-    int ori12 = orient3d(pt1, pt, t1, t2);
-    int ori23 = orient3d(pt1, pt, t2, t3);
-    int ori31 = orient3d(pt1, pt, t3, t1);
+    orientation_e o[4];
+    detail::orient3d_batch(o, pt1, pt, t1, t2, pt1, pt, t2, t3, pt1, pt, t3, t1, t3, pt, t1, t2);
+    int ori12 = o[0];
+    int ori23 = o[1];
+    int ori31 = o[2];
     // if(ori12*ori23<0||ori12*ori31<0||ori23*ori31<0) return 0;//ray triangle
     // not intersected;
-    int oris = orient3d(t3, pt, t1, t2);  // if ray shoot triangle, oris should have
-                                          // same sign with the three oritations
+    int oris = o[3];  // if ray shoot triangle, oris should have
+                      // same sign with the three oritations
     if (oris * ori12 < 0 || oris * ori23 < 0 || oris * ori31 < 0)
       return 0;  // ray triangle not intersected;
 
@@ -5,7 +5,11 @@
 #include <algorithm>
 #include <fstream>
 
+#include "zensim/container/Bht.hpp"
 #include "zensim/container/DenseGrid.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/math/probability/Random.hpp"
 #include "zensim/math/RandomNumber.hpp"
 #include "zensim/math/Vec.h"
 // #include <taskflow/taskflow.hpp>
@@ -320,4 +324,302 @@ namespace zs {
     return pd.sample([&ls](const vec<T, dim> &x) { return ls.getSignedDistance(x) < 0; });
   }
 
+  namespace detail {
+    /// splitmix64 finalizer, decorrelates the per-(cell, attempt) random streams
+    constexpr u64 poisson_disk_hash(u64 x) noexcept {
+      x += 0x9e3779b97f4a7c15ull;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+      return x ^ (x >> 31);
+    }
+  }  // namespace detail
+
+  /// @brief parallel poisson disk sampling of the interior (negative signed distance) of [ls],
+  /// the samples are written to the [xTag] property of [tv], which is resized accordingly.
+  /// @note the background grid (cell size r / sqrt(dim), at most one sample per cell) is sparse,
+  /// only the blocks of cells near or inside [ls] are allocated and addressed through a hash
+  /// table. Cells are visited in 3^dim phase groups, cells of the same group are at least two
+  /// cells apart and never conflict, so each group is processed in parallel without locks. Every
+  /// cell draws its darts from its own random stream derived from [seed], hence the result does
+  /// not depend on the scheduling.
+  /// @note [ls] is assumed to be a signed distance field (used to cull the background grid)
+  template <typename ExecPol, typename LS, typename T, size_t Length, typename Allocator>
+  size_t sample_from_levelset(ExecPol &&pol, const LevelSetInterface<LS> &ls, float dx, float ppc,
+                              TileVector<T, Length, Allocator> &tv, u32 seed = 0,
+                              int maxAttempts = 30, const SmallString &xTag = "x") {
+    using value_type = typename LS::value_type;
+    static constexpr int dim = LS::dim;
+    static constexpr int num_phases = dim == 2 ? 9 : 27;
+    static constexpr int block_side = 8;
+    static constexpr int block_size = dim == 2 ? 64 : 512;
+    static constexpr int num_subcells = dim == 2 ? 16 : 64;
+    using TV = vec<value_type, dim>;
+    using IV = vec<int, dim>;
+    using size_type = typename TileVector<T, Length, Allocator>::size_type;
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+
+    if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+      throw std::runtime_error(
+          "[sample_from_levelset] current memory location not compatible with the execution "
+          "policy");
+    const auto xHandle = tv.resolve(xTag);
+    if (!xHandle || xHandle.size != dim)
+      throw std::runtime_error(fmt::format(
+          "[sample_from_levelset] property \"{}\" of {} channels does not exist", xTag.asChars(),
+          dim));
+
+    PoissonDisk<value_type, dim> pd{};
+    pd.setDistanceByPpc(dx, ppc);
+    const value_type r = pd.minDistance;
+    const value_type h = r / std::sqrt((value_type)dim);
+    const value_type cellRadius = h * std::sqrt((value_type)dim) / 2;
+    auto [minCorner, maxCorner] = ls.getBoundingBox();
+    const TV mi = minCorner;
+    IV cellDims{}, blockDims{};
+    size_t numBlocks = 1;
+    for (int d = 0; d != dim; ++d) {
+      cellDims[d] = (int)std::ceil((maxCorner[d] - minCorner[d]) / h);
+      if (cellDims[d] < 1) cellDims[d] = 1;
+      blockDims[d] = (cellDims[d] + block_side - 1) / block_side;
+      numBlocks *= blockDims[d];
+    }
+
+    auto allocator = get_temporary_memory_source(pol);
+    const LS levelset = static_cast<const LS &>(ls);
+
+    /// blocks possibly holding interior points, numbered in lexicographic order
+    Vector<size_type> blockMarks{allocator, numBlocks + 1}, blockOffsets{allocator, numBlocks + 1};
+    pol(range(numBlocks), [blockMarks = view<space>(blockMarks), levelset, mi, blockDims, h,
+                           cellRadius] ZS_LAMBDA(size_type bi) mutable {
+      TV center{};
+      for (int d = dim - 1, id = (int)bi; d >= 0; --d) {
+        center[d] = mi[d] + (id % blockDims[d] + (value_type)0.5) * h * block_side;
+        id /= blockDims[d];
+      }
+      blockMarks[bi] = levelset.getSignedDistance(center) < cellRadius * block_side ? 1 : 0;
+    });
+    blockMarks.setVal(0, numBlocks);
+    exclusive_scan(pol, zs::begin(blockMarks), zs::end(blockMarks), zs::begin(blockOffsets));
+    const size_type numActiveBlocks = blockOffsets.getVal(numBlocks);
+    if (numActiveBlocks == 0) {
+      tv.resize(0);
+      return 0;
+    }
+    const size_type numCells = numActiveBlocks * block_size;
+
+    size_t tabSize = numActiveBlocks;
+    bht<int, dim, int, 16> tab{allocator, tabSize};
+    Vector<IV> blockCoords{allocator, numActiveBlocks};
+    for (bool success = false; !success;) {
+      pol(range(numBlocks), [tab = proxy<space>(tab), blockMarks = view<space>(blockMarks),
+                             blockOffsets = view<space>(blockOffsets),
+                             blockCoords = view<space>(blockCoords),
+                             blockDims] ZS_LAMBDA(size_type bi) mutable {
+        if (!blockMarks[bi]) return;
+        const auto bno = blockOffsets[bi];
+        IV blockCoord{};
+        for (int d = dim - 1, id = (int)bi; d >= 0; --d) {
+          blockCoord[d] = id % blockDims[d];
+          id /= blockDims[d];
+        }
+        tab.insert(blockCoord, (int)bno, false);
+        blockCoords[bno] = blockCoord;
+      });
+      success = tab._buildSuccess.getVal();
+      if (!success) {
+        tabSize *= 2;
+        tab = bht<int, dim, int, 16>{allocator, tabSize};
+      }
+    }
+
+    /// the 3^dim neighbor blocks of every active block (-1 if absent)
+    Vector<int> blockNeighbors{allocator, numActiveBlocks * num_phases};
+    pol(range(numActiveBlocks * num_phases),
+        [tab = proxy<space>(tab), blockCoords = view<space>(blockCoords),
+         blockNeighbors = view<space>(blockNeighbors)] ZS_LAMBDA(size_type i) mutable {
+          auto blockCoord = blockCoords[i / num_phases];
+          for (int d = dim - 1, id = (int)(i % num_phases); d >= 0; --d) {
+            blockCoord[d] += id % 3 - 1;
+            id /= 3;
+          }
+          blockNeighbors[i] = tab.query(blockCoord);
+        });
+
+    /// cell status: -1 unused, 0 empty, 1 sampled, 2 covered. Empty cells are grouped by phase,
+    /// the (stable) sort keeps the cell order within a phase.
+    /// darts are only thrown into the sub-cells (a quarter of the cell side) that may hold interior
+    /// points and are not yet covered by a single disk, tracked as a bit mask per cell.
+    Vector<int> status{allocator, numCells};
+    Vector<u64> subcellMasks{allocator, numCells};
+    Vector<int> numSeen{allocator, numCells};
+    numSeen.reset(0);
+    Vector<u32> keys{allocator, numCells}, sortedKeys{allocator, numCells};
+    Vector<int> ids{allocator, numCells}, order{allocator, numCells};
+    auto cell_coord = [](const IV &blockCoord, int cno) {
+      IV coord{};
+      for (int d = dim - 1; d >= 0; --d) {
+        coord[d] = blockCoord[d] * block_side + cno % block_side;
+        cno /= block_side;
+      }
+      return coord;
+    };
+    pol(range(numCells),
+        [status = view<space>(status), subcellMasks = view<space>(subcellMasks),
+         keys = view<space>(keys), ids = view<space>(ids), blockCoords = view<space>(blockCoords),
+         levelset, mi, cellDims, h, cellRadius, cell_coord] ZS_LAMBDA(size_type k) mutable {
+          const auto coord = cell_coord(blockCoords[k / block_size], (int)(k % block_size));
+          bool active = true;
+          TV center{};
+          for (int d = 0; d != dim; ++d) {
+            if (coord[d] >= cellDims[d]) active = false;
+            center[d] = mi[d] + (coord[d] + (value_type)0.5) * h;
+          }
+          active = active && levelset.getSignedDistance(center) < cellRadius;
+          u64 mask = 0;
+          if (active)
+            for (int sc = 0; sc != num_subcells; ++sc) {
+              for (int d = 0, id = sc; d != dim; ++d, id >>= 2)
+                center[d] = mi[d] + (coord[d] + ((id & 3) + (value_type)0.5) / 4) * h;
+              if (levelset.getSignedDistance(center) < cellRadius / 4) mask |= (u64)1 << sc;
+            }
+          active = mask != 0;
+          subcellMasks[k] = mask;
+          u32 phase = 0;
+          for (int d = dim - 1; d >= 0; --d) phase = phase * 3 + (u32)(coord[d] % 3);
+          status[k] = active ? 0 : -1;
+          keys[k] = active ? phase : (u32)num_phases;
+          ids[k] = (int)k;
+        });
+    radix_sort_pair(pol, keys.begin(), ids.begin(), sortedKeys.begin(), order.begin(), numCells, 0,
+                    (int)bit_length((u32)num_phases));
+    Vector<size_type> bounds{allocator, (size_t)num_phases + 1};
+    pol(range(numCells + 1), [keys = view<space>(sortedKeys), bounds = view<space>(bounds),
+                              numCells] ZS_LAMBDA(size_type i) mutable {
+      const int prev = i == 0 ? -1 : (int)keys[i - 1];
+      const int cur = i == numCells ? num_phases : (int)keys[i];
+      for (int t = prev + 1; t <= cur && t <= num_phases; ++t) bounds[t] = i;
+    });
+    bounds = bounds.clone({memsrc_e::host, -1});
+
+    /// dart throwing, the phase order is shuffled every round to avoid directional bias
+    Vector<TV> samples{allocator, numCells};
+    int phases[num_phases];
+    for (int p = 0; p != num_phases; ++p) phases[p] = p;
+    u64 shuffleState = detail::poisson_disk_hash(seed);
+    for (int attempt = 0; attempt != maxAttempts; ++attempt) {
+      for (int p = num_phases - 1; p > 0; --p)
+        std::swap(phases[p], phases[PCG::pcg32_random_r(shuffleState) % (u32)(p + 1)]);
+      for (int p : phases) {
+        const size_type st = bounds[p], cnt = bounds[p + 1] - st;
+        pol(range(cnt), [order = view<space>(order), status = view<space>(status),
+                         subcellMasks = view<space>(subcellMasks), numSeen = view<space>(numSeen),
+                         samples = view<space>(samples), blockCoords = view<space>(blockCoords),
+                         blockNeighbors = view<space>(blockNeighbors), levelset, mi, h, r, st,
+                         seed, attempt, maxAttempts,
+                         cell_coord] ZS_LAMBDA(size_type j) mutable {
+          const auto k = order[st + j];
+          if (status[k] != 0) return;
+          const auto coord = cell_coord(blockCoords[k / block_size], k % block_size);
+          const int bno = k / block_size;
+          const value_type r2 = r * r;
+          // samples within the 5^dim neighborhood (r <= 2h), found in the 3^dim neighbor blocks
+          int axisBlocks[dim][5], axisCells[dim][5];
+          for (int d = 0; d != dim; ++d)
+            for (int o = 0; o != 5; ++o) {
+              const int local = coord[d] % block_side + o - 2;
+              const int blockOffset = local < 0 ? -1 : (local >= block_side ? 1 : 0);
+              axisBlocks[d][o] = blockOffset + 1;
+              axisCells[d][o] = local - blockOffset * block_side;
+            }
+          TV nbs[math::pow_integral(5, dim)];
+          int numNbs = 0;
+          auto gather = [&](int b, int cno) {
+            const auto nbno = blockNeighbors[bno * num_phases + b];
+            if (nbno < 0) return;
+            const auto q = nbno * block_size + cno;
+            if (status[q] == 1) nbs[numNbs++] = samples[q];
+          };
+          for (int o0 = 0; o0 != 5; ++o0)
+            for (int o1 = 0; o1 != 5; ++o1) {
+              const int b = axisBlocks[0][o0] * 3 + axisBlocks[1][o1];
+              const int cno = axisCells[0][o0] * block_side + axisCells[1][o1];
+              if constexpr (dim == 2)
+                gather(b, cno);
+              else
+                for (int o2 = 0; o2 != 5; ++o2)
+                  gather(b * 3 + axisBlocks[2][o2], cno * block_side + axisCells[2][o2]);
+            }
+          // drop the sub-cells now covered by a single disk, i.e. within r of its farthest corner.
+          // Samples are never removed, the mask is only refined when new neighbors showed up.
+          const value_type subh = h / 4;
+          u64 uncovered = subcellMasks[k];
+          for (int i = numSeen[k] == numNbs ? numNbs : 0; i < numNbs && uncovered; ++i) {
+            value_type far2[dim][4], lowerBound = 0;
+            for (int d = 0; d != dim; ++d) {
+              value_type closest = detail::deduce_numeric_max<value_type>();
+              for (int sub = 0; sub != 4; ++sub) {
+                const value_type lo = mi[d] + coord[d] * h + sub * subh;
+                const value_type a = nbs[i][d] - lo, b = lo + subh - nbs[i][d];
+                far2[d][sub] = a > b ? a * a : b * b;
+                if (far2[d][sub] < closest) closest = far2[d][sub];
+              }
+              lowerBound += closest;
+            }
+            if (!(lowerBound < r2)) continue;
+            for (int sc = 0; sc != num_subcells; ++sc) {
+              if (!((uncovered >> sc) & 1)) continue;
+              value_type dist2 = 0;
+              for (int d = 0, id = sc; d != dim; ++d, id >>= 2) dist2 += far2[d][id & 3];
+              if (dist2 < r2) uncovered ^= (u64)1 << sc;
+            }
+          }
+          subcellMasks[k] = uncovered;
+          numSeen[k] = numNbs;
+          if (!uncovered) {
+            status[k] = 2;
+            return;
+          }
+          int numUncovered = 0;
+          for (int sc = 0; sc != num_subcells; ++sc) numUncovered += (uncovered >> sc) & 1;
+
+          u64 state = detail::poisson_disk_hash(((u64)seed << 32)
+                                                ^ ((u64)k * (u64)maxAttempts + (u64)attempt));
+          int sc = 0;
+          for (int pick = (int)(PCG::pcg32_random_r(state) % (u32)numUncovered);; ++sc)
+            if (((uncovered >> sc) & 1) && pick-- == 0) break;
+          TV x{};
+          for (int d = 0, id = sc; d != dim; ++d, id >>= 2)
+            x[d] = mi[d] + coord[d] * h
+                   + ((id & 3)
+                      + (value_type)(PCG::pcg32_random_r(state) >> 8) * (value_type)0x1p-24)
+                         * subh;
+          if (!(levelset.getSignedDistance(x) < 0)) return;
+          for (int i = 0; i != numNbs; ++i)
+            if ((nbs[i] - x).l2NormSqr() < r2) return;
+          samples[k] = x;
+          status[k] = 1;
+        });
+      }
+    }
+
+    /// compaction in cell order
+    Vector<size_type> marks{allocator, numCells + 1}, dsts{allocator, numCells + 1};
+    pol(range(numCells), [marks = view<space>(marks),
+                          status = view<space>(status)] ZS_LAMBDA(size_type k) mutable {
+      marks[k] = status[k] == 1 ? 1 : 0;
+    });
+    marks.setVal(0, numCells);
+    exclusive_scan(pol, zs::begin(marks), zs::end(marks), zs::begin(dsts));
+    const size_type numSamples = dsts.getVal(numCells);
+    tv.resize(numSamples);
+    pol(range(numCells), [tv = view<space>({}, tv), samples = view<space>(samples),
+                          marks = view<space>(marks), dsts = view<space>(dsts),
+                          xHandle] ZS_LAMBDA(size_type k) mutable {
+      if (!marks[k]) return;
+      const auto x = samples[k];
+      for (int d = 0; d != dim; ++d) tv(xHandle, d, dsts[k]) = (T)x[d];
+    });
+    return numSamples;
+  }
+
 }  // namespace zs
@@ -1065,4 +1065,94 @@ namespace zs {
     return orient3dadapt(pa, pb, pc, pd, permanent);
   }
 
+  /*****************************************************************************/
+  /*                                                                           */
+  /*  orient2d_lanes()   orient3d_lanes()   Batched adaptive orientation tests.  */
+  /*                                                                           */
+  /*               Evaluate [n] queries whose points are laid out as structure */
+  /*               of arrays (pa[0][i], pa[1][i], ... is point a of query i).  */
+  /*               The floating-point determinant and its static error bound   */
+  /*               are computed in simd lanes, only the queries that fail the  */
+  /*               g_ccwerrboundA/g_o3derrboundA filter are passed to the      */
+  /*               scalar routines. Results are identical to those of          */
+  /*               orient2d()/orient3d(). Returns the number of queries that   */
+  /*               fell back to the scalar path.                               */
+  /*                                                                           */
+  /*****************************************************************************/
+  template <typename Ti>
+  inline Ti orient2d_lanes(Ti n, const double *const pa[2], const double *const pb[2],
+                           const double *const pc[2], double *det) noexcept {
+    constexpr Ti chunk = 64;
+    // hoisted so that the simd loop does not reload them after every store
+    const double *ax = pa[0], *ay = pa[1], *bx = pb[0], *by = pb[1], *cx = pc[0], *cy = pc[1];
+    double errbounds[chunk];
+    Ti numAdapt = 0;
+    for (Ti base = 0; base < n; base += chunk) {
+      const Ti cnt = n - base < chunk ? n - base : chunk;
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+      for (Ti l = 0; l < cnt; ++l) {
+        const Ti i = base + l;
+        const double detleft = (ax[i] - cx[i]) * (by[i] - cy[i]);
+        const double detright = (ay[i] - cy[i]) * (bx[i] - cx[i]);
+        det[i] = detleft - detright;
+        // terms of opposite signs (or a zero term) always pass, as then |det| == detsum
+        errbounds[l] = g_ccwerrboundA * (absolute(detleft) + absolute(detright));
+      }
+      // lanes failing the static filter, the scalar routine resolves them exactly
+      for (Ti l = 0; l < cnt; ++l)
+        if (!(absolute(det[base + l]) >= errbounds[l])) {
+          const Ti i = base + l;
+          const double a[2] = {ax[i], ay[i]}, b[2] = {bx[i], by[i]}, c[2] = {cx[i], cy[i]};
+          det[i] = orient2d(a, b, c);
+          ++numAdapt;
+        }
+    }
+    return numAdapt;
+  }
+
+  template <typename Ti>
+  inline Ti orient3d_lanes(Ti n, const double *const pa[3], const double *const pb[3],
+                           const double *const pc[3], const double *const pd[3],
+                           double *det) noexcept {
+    constexpr Ti chunk = 64;
+    const double *ax = pa[0], *ay = pa[1], *az = pa[2], *bx = pb[0], *by = pb[1], *bz = pb[2];
+    const double *cx = pc[0], *cy = pc[1], *cz = pc[2], *dx = pd[0], *dy = pd[1], *dz = pd[2];
+    double permanents[chunk];
+    Ti numAdapt = 0;
+    for (Ti base = 0; base < n; base += chunk) {
+      const Ti cnt = n - base < chunk ? n - base : chunk;
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+      for (Ti l = 0; l < cnt; ++l) {
+        const Ti i = base + l;
+        const double adx = ax[i] - dx[i], bdx = bx[i] - dx[i], cdx = cx[i] - dx[i];
+        const double ady = ay[i] - dy[i], bdy = by[i] - dy[i], cdy = cy[i] - dy[i];
+        const double adz = az[i] - dz[i], bdz = bz[i] - dz[i], cdz = cz[i] - dz[i];
+        const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        const double cdxady = cdx * ady, adxcdy = adx * cdy;
+        const double adxbdy = adx * bdy, bdxady = bdx * ady;
+        const double d
+            = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+        const double permanent = (absolute(bdxcdy) + absolute(cdxbdy)) * absolute(adz)
+                                 + (absolute(cdxady) + absolute(adxcdy)) * absolute(bdz)
+                                 + (absolute(adxbdy) + absolute(bdxady)) * absolute(cdz);
+        det[i] = d;
+        permanents[l] = permanent;
+      }
+      // lanes failing the static filter
+      for (Ti l = 0; l < cnt; ++l)
+        if (!(absolute(det[base + l]) > g_o3derrboundA * permanents[l])) {
+          const Ti i = base + l;
+          const double a[3] = {ax[i], ay[i], az[i]}, b[3] = {bx[i], by[i], bz[i]},
+                       c[3] = {cx[i], cy[i], cz[i]}, dd[3] = {dx[i], dy[i], dz[i]};
+          det[i] = orient3dadapt(a, b, c, dd, permanents[l]);
+          ++numAdapt;
+        }
+    }
+    return numAdapt;
+  }
+
 }  // namespace zs
\ No newline at end of file
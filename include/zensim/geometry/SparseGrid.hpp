@@ -80,6 +80,10 @@ namespace zs {
         return (value_type)0;
     }
 
+    /// block stencil
+    static constexpr int num_neighbor_blocks = math::pow_integral(3, dim);
+    using block_adjacency_type = vec<typename table_type::value_type, num_neighbor_blocks>;
+
     SparseGrid(const allocator_type &allocator, const std::vector<PropertyTag> &channelTags,
                size_type numBlocks = 0)
         : _table{allocator, numBlocks},
@@ -132,6 +136,11 @@ namespace zs {
     constexpr size_type getPropertyOffset(const SmallString &str) const {
       return _grid.getPropertyOffset(str);
     }
+    PropertyHandle resolve(const SmallString &str) const { return _grid.resolve(str); }
+    template <typename... Ts, enable_if_t<(sizeof...(Ts) > 1)> = 0>
+    auto resolve(const Ts &...strs) const {
+      return _grid.resolve(strs...);
+    }
     constexpr PropertyTag getPropertyTag(size_type i = 0) const { return _grid.getPropertyTag(i); }
     constexpr const auto &getPropertyTags() const { return _grid.getPropertyTags(); }
 
@@ -181,6 +190,17 @@ namespace zs {
     }
     void scale(const value_type s) { scale(s * coord_type::constant(1)); }
 
+    /// @brief resolve the (3^dim) neighbor block indices of every active block once
+    /// @note the centering block itself is at [num_neighbor_blocks / 2], inactive ones are sentinel
+    template <typename Policy>
+    Vector<block_adjacency_type, allocator_type> computeBlockAdjacency(Policy &&pol) const;
+    /// @brief for each active block, gather the block and its halo into a padded tile, then
+    /// invoke f(blockno, paddedTile, gridView)
+    template <typename Policy, typename Fn, int Halo = 1, int NumChns = 1>
+    void forEachPaddedBlock(Policy &&pol,
+                            const Vector<block_adjacency_type, allocator_type> &adjacency,
+                            size_type chnOffset, Fn &&f, wrapv<Halo> = {}, wrapv<NumChns> = {});
+
     table_type _table;
     grid_storage_type _grid;
     transform_type _transform;
@@ -196,6 +216,60 @@ namespace zs {
   // forward decl
   template <typename GridViewT, kernel_e kt, int drv_order> struct GridArena;
 
+  /// @brief dense copy of a block along with a halo of width [Halo] taken from its neighbors
+  /// @note meant to live in thread-local (register/stack) storage within a block-wise kernel
+  template <typename ValueT, int dim_, int SideLength, int Halo, int NumChns = 1>
+  struct SparseGridPaddedBlock {
+    static_assert(Halo >= 0 && Halo <= SideLength, "halo width should be within [0, side_length]");
+    static constexpr int dim = dim_;
+    static constexpr int side_length = SideLength;
+    static constexpr int halo = Halo;
+    static constexpr int num_channels = NumChns;
+    static constexpr int padded_side_length = side_length + halo + halo;
+    static constexpr int padded_block_size = math::pow_integral(padded_side_length, dim);
+    using value_type = ValueT;
+
+    /// @note local coord of the block itself is within [0, side_length), halo cells within
+    /// [-halo, 0) and [side_length, side_length + halo)
+    template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
+                                           is_integral_v<typename VecT::value_type>>
+                             = 0>
+    static constexpr int local_coord_to_offset(const VecInterface<VecT> &coord) noexcept {
+      int ret = (int)coord[0] + halo;
+      for (int d = 1; d < dim; ++d) ret = ret * padded_side_length + ((int)coord[d] + halo);
+      return ret;
+    }
+    template <typename... Tn, enable_if_all<sizeof...(Tn) == dim, (is_integral_v<Tn> && ...)> = 0>
+    static constexpr int local_coord_to_offset(Tn... is) noexcept {
+      int ret = 0;
+      ((void)(ret = ret * padded_side_length + ((int)is + halo)), ...);
+      return ret;
+    }
+
+    template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
+                                           is_integral_v<typename VecT::value_type>>
+                             = 0>
+    constexpr value_type &operator()(int chn, const VecInterface<VecT> &coord) noexcept {
+      return _vals[chn][local_coord_to_offset(coord)];
+    }
+    template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
+                                           is_integral_v<typename VecT::value_type>>
+                             = 0>
+    constexpr value_type operator()(int chn, const VecInterface<VecT> &coord) const noexcept {
+      return _vals[chn][local_coord_to_offset(coord)];
+    }
+    template <typename... Tn, enable_if_all<sizeof...(Tn) == dim, (is_integral_v<Tn> && ...)> = 0>
+    constexpr value_type &operator()(int chn, Tn... is) noexcept {
+      return _vals[chn][local_coord_to_offset(is...)];
+    }
+    template <typename... Tn, enable_if_all<sizeof...(Tn) == dim, (is_integral_v<Tn> && ...)> = 0>
+    constexpr value_type operator()(int chn, Tn... is) const noexcept {
+      return _vals[chn][local_coord_to_offset(is...)];
+    }
+
+    value_type _vals[num_channels][padded_block_size];
+  };
+
   template <execspace_e Space, typename SparseGridT> struct SparseGridView
       : LevelSetInterface<SparseGridView<Space, SparseGridT>> {
     static constexpr bool is_const_structure = is_const_v<SparseGridT>;
@@ -229,6 +303,7 @@ namespace zs {
     using coord_mask_type = make_unsigned_t<integer_coord_component_type>;
     static constexpr coord_mask_type origin_mask = ~(coord_mask_type)(side_length - 1);
     static constexpr index_type sentinel_v = table_view_type::sentinel_v;
+    using stencil_block_cache_type = StencilBlockCache<index_type, integer_coord_type>;
     static constexpr int num_levels = 1;
     template <int> struct level_view_type {
       static constexpr coord_mask_type origin_mask = SparseGridView::origin_mask;
@@ -298,6 +373,9 @@ namespace zs {
     constexpr auto propertyOffset(const SmallString &propTag) const noexcept {
       return _grid.propertyOffset(propTag);
     }
+    template <typename... Ts> constexpr auto resolve(const Ts &...propTags) const noexcept {
+      return _grid.resolve(propTags...);
+    }
     // node value access (used for GridArena::arena_type init)
     template <typename VecTI, enable_if_all<VecTI::dim == 1, VecTI::extent == dim,
                                             is_integral_v<typename VecTI::index_type>>
@@ -455,7 +533,9 @@ namespace zs {
 
     /// sample
     // collocated
-    template <kernel_e kt = kernel_e::linear, typename VecT = int, bool UseAccessor = true,
+    /// @note the arena resolves the blocks touched by the stencil once by itself, [UseAccessor]
+    /// gathers the nodes one by one through a per-call accessor instead
+    template <kernel_e kt = kernel_e::linear, typename VecT = int, bool UseAccessor = false,
               enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
     constexpr auto iSample(size_type chn, const VecInterface<VecT> &X, wrapv<kt> = {},
                            wrapv<UseAccessor> = {}) const {
@@ -464,11 +544,18 @@ namespace zs {
         auto pad = GridArena<RM_CVREF_T(acc), kt, 0>(false_c, &acc, X);
         return pad.isample(chn, _background);
       } else {
-        // auto pad = GridArena<const SparseGridView, kt, 0>(false_c, this, X);
         auto pad = iArena(X, wrapv<kt>{});
         return pad.isample(chn, _background);
       }
     }
+    /// @brief coherent queries (e.g. sorted by block) share the blocks resolved in [cache]
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto iSample(size_type chn, const VecInterface<VecT> &X,
+                           stencil_block_cache_type &cache, wrapv<kt> = {}) const {
+      auto pad = iArena(X, wrapv<kt>{});
+      return pad.isample(chn, cache, _background);
+    }
     template <typename AccessorGridView, kernel_e kt = kernel_e::linear, typename VecT = int,
               enable_if_all<is_same_v<SparseGridView, AccessorGridView>, VecT::dim == 1,
                             VecT::extent == dim>
@@ -497,6 +584,12 @@ namespace zs {
     constexpr auto wSample(size_type chn, const VecInterface<VecT> &x, wrapv<kt> = {}) const {
       return iSample(chn, worldToIndex(x), wrapv<kt>{});
     }
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto wSample(size_type chn, const VecInterface<VecT> &x,
+                           stencil_block_cache_type &cache, wrapv<kt> = {}) const {
+      return iSample(chn, worldToIndex(x), cache, wrapv<kt>{});
+    }
     template <typename AccessorGridView, kernel_e kt = kernel_e::linear, typename VecT = int,
               enable_if_all<is_same_v<SparseGridView, AccessorGridView>, VecT::dim == 1,
                             VecT::extent == dim>
@@ -532,7 +625,7 @@ namespace zs {
         v2 = x;
         v1(i) = x(i) + eps;
         v2(i) = x(i) - eps;
-        diff(i) = (getSignedDistance(v1) - getSignedDistance(v2)) / (eps + eps);
+        diff(i) = (do_getSignedDistance(v1) - do_getSignedDistance(v2)) / (eps + eps);
       }
       return diff.normalized();
     }
@@ -740,6 +833,66 @@ namespace zs {
       return iPack(_grid.propertyOffset(prop) + chn, worldToIndex(x), wrapv<N>{}, wrapv<kt>{});
     }
 
+    /// property handle (see resolve) variants, no name lookup
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto iSample(const PropertyHandle &prop, const VecInterface<VecT> &X,
+                           wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, 0, "iSample")) return iSample(_grid.numChannels(), X, wrapv<kt>{});
+#endif
+      return iSample(prop.offset, X, wrapv<kt>{});
+    }
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto iSample(const PropertyHandle &prop, size_type chn, const VecInterface<VecT> &X,
+                           wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "iSample")) return iSample(_grid.numChannels(), X, wrapv<kt>{});
+#endif
+      return iSample(prop.offset + chn, X, wrapv<kt>{});
+    }
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto wSample(const PropertyHandle &prop, const VecInterface<VecT> &x,
+                           wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, 0, "wSample"))
+        return iSample(_grid.numChannels(), worldToIndex(x), wrapv<kt>{});
+#endif
+      return iSample(prop.offset, worldToIndex(x), wrapv<kt>{});
+    }
+    template <kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim> = 0>
+    constexpr auto wSample(const PropertyHandle &prop, size_type chn, const VecInterface<VecT> &x,
+                           wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "wSample"))
+        return iSample(_grid.numChannels(), worldToIndex(x), wrapv<kt>{});
+#endif
+      return iSample(prop.offset + chn, worldToIndex(x), wrapv<kt>{});
+    }
+    template <int N = dim, kernel_e kt = kernel_e::linear, typename VecT = int,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim, (N <= dim)> = 0>
+    constexpr auto iPack(const PropertyHandle &prop, const VecInterface<VecT> &X, wrapv<N> = {},
+                         wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, N - 1, "iPack"))
+        return iPack(_grid.numChannels(), X, wrapv<N>{}, wrapv<kt>{});
+#endif
+      return iPack(prop.offset, X, wrapv<N>{}, wrapv<kt>{});
+    }
+    template <int N = dim, kernel_e kt = kernel_e::linear, typename VecT,
+              enable_if_all<VecT::dim == 1, VecT::extent == dim, (N <= dim)> = 0>
+    constexpr auto wPack(const PropertyHandle &prop, const VecInterface<VecT> &x, wrapv<N> = {},
+                         wrapv<kt> = {}) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, N - 1, "wPack"))
+        return iPack(_grid.numChannels(), worldToIndex(x), wrapv<N>{}, wrapv<kt>{});
+#endif
+      return iPack(prop.offset, worldToIndex(x), wrapv<N>{}, wrapv<kt>{});
+    }
+
     /// node access
     // ref
     constexpr decltype(auto) operator()(size_type chn, size_type cellno) {
@@ -756,6 +909,22 @@ namespace zs {
                                         size_type cellno) {
       return this->operator()(_grid.propertyOffset(prop) + chn, blockno, cellno);
     }
+    constexpr decltype(auto) operator()(const PropertyHandle &prop, size_type blockno,
+                                        size_type cellno) {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, 0, "operator()"))
+        return this->operator()(_grid.numChannels(), blockno, cellno);
+#endif
+      return this->operator()(prop.offset, blockno, cellno);
+    }
+    constexpr decltype(auto) operator()(const PropertyHandle &prop, size_type chn,
+                                        size_type blockno, size_type cellno) {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "operator()"))
+        return this->operator()(_grid.numChannels(), blockno, cellno);
+#endif
+      return this->operator()(prop.offset + chn, blockno, cellno);
+    }
     template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
                                            std::is_convertible_v<typename VecT::value_type,
                                                                  integer_coord_component_type>>
@@ -792,6 +961,22 @@ namespace zs {
                               size_type cellno) const {
       return this->operator()(_grid.propertyOffset(prop) + chn, blockno, cellno);
     }
+    constexpr auto operator()(const PropertyHandle &prop, size_type blockno,
+                              size_type cellno) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, 0, "operator()"))
+        return this->operator()(_grid.numChannels(), blockno, cellno);
+#endif
+      return this->operator()(prop.offset, blockno, cellno);
+    }
+    constexpr auto operator()(const PropertyHandle &prop, size_type chn, size_type blockno,
+                              size_type cellno) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "operator()"))
+        return this->operator()(_grid.numChannels(), blockno, cellno);
+#endif
+      return this->operator()(prop.offset + chn, blockno, cellno);
+    }
     template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
                                            std::is_convertible_v<typename VecT::value_type,
                                                                  integer_coord_component_type>>
@@ -829,6 +1014,19 @@ namespace zs {
                          size_type cellno) const {
       return value(_grid.propertyOffset(prop) + chn, blockno, cellno);
     }
+    constexpr auto value(const PropertyHandle &prop, size_type blockno, size_type cellno) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, 0, "value")) return value(_grid.numChannels(), blockno, cellno);
+#endif
+      return value(prop.offset, blockno, cellno);
+    }
+    constexpr auto value(const PropertyHandle &prop, size_type chn, size_type blockno,
+                         size_type cellno) const {
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+      if (handle_ofb(prop, chn, "value")) return value(_grid.numChannels(), blockno, cellno);
+#endif
+      return value(prop.offset + chn, blockno, cellno);
+    }
     /// @brief access value by coord
     template <typename VecT, enable_if_all<VecT::dim == 1, VecT::extent == dim,
                                            std::is_convertible_v<typename VecT::value_type,
@@ -909,6 +1107,91 @@ namespace zs {
     constexpr auto block(size_type blockno) { return _grid.tile(blockno); }
     constexpr auto block(size_type blockno) const { return _grid.tile(blockno); }
 
+    /// block stencil
+    static constexpr int num_neighbor_blocks = container_type::num_neighbor_blocks;
+    using block_adjacency_type = typename container_type::block_adjacency_type;
+    template <int Halo, int NumChns = 1> using padded_block_type
+        = SparseGridPaddedBlock<value_type, dim, side_length, Halo, NumChns>;
+
+    /// @note neighbor [n] is offset by ((n / 3^(dim-1-d)) % 3 - 1) * side_length along axis d
+    constexpr block_adjacency_type blockAdjacency(size_type blockno) const {
+      block_adjacency_type ret{};
+      const integer_coord_type origin = _table._activeKeys[blockno];
+      for (int n = 0; n != num_neighbor_blocks; ++n) {
+        integer_coord_type nbOrigin{};
+        for (int d = dim - 1, m = n; d >= 0; --d, m /= 3)
+          nbOrigin[d] = origin[d] + (integer_coord_component_type)(m % 3 - 1) * side_length;
+        ret[n] = _table.query(nbOrigin);
+      }
+      return ret;
+    }
+    /// @brief fill [tile] with channels [chnOffset, chnOffset + NumChns) of block [blockno] and
+    /// its halo, reading each of the neighbor blocks resolved in [adjacency] as a dense region
+    template <int Halo, int NumChns>
+    constexpr void gatherPaddedBlock(padded_block_type<Halo, NumChns> &tile,
+                                     const block_adjacency_type &adjacency,
+                                     size_type chnOffset) const {
+      using tile_t = padded_block_type<Halo, NumChns>;
+      for (int n = 0; n != num_neighbor_blocks; ++n) {
+        // sub-region (in padded local coords) covered by neighbor n
+        int lo[dim], ext[dim], shift[dim], cnt = 1;
+        for (int d = dim - 1, m = n; d >= 0; --d, m /= 3) {
+          const int r = m % 3;
+          lo[d] = r == 0 ? -Halo : (r == 1 ? 0 : (int)side_length);
+          ext[d] = r == 1 ? (int)side_length : Halo;
+          shift[d] = (r - 1) * (int)side_length;
+          cnt *= ext[d];
+        }
+        if (cnt == 0) continue;
+        const auto nbno = adjacency[n];
+        if (nbno == sentinel_v) {
+          for (int i = 0; i != cnt; ++i) {
+            int dst = 0;
+            for (int d = 0, j = i, stride = cnt; d != dim; ++d) {
+              stride /= ext[d];
+              dst = dst * tile_t::padded_side_length + (lo[d] + j / stride + Halo);
+              j %= stride;
+            }
+            for (int chn = 0; chn != NumChns; ++chn) tile._vals[chn][dst] = _background;
+          }
+          continue;
+        }
+        const auto nbBlock = _grid.tile(nbno);
+        for (int i = 0; i != cnt; ++i) {
+          int dst = 0;
+          integer_coord_component_type src = 0;
+          for (int d = 0, j = i, stride = cnt; d != dim; ++d) {
+            stride /= ext[d];
+            const int c = lo[d] + j / stride;
+            dst = dst * tile_t::padded_side_length + (c + Halo);
+            src = src * side_length + (integer_coord_component_type)(c - shift[d]);
+            j %= stride;
+          }
+          for (int chn = 0; chn != NumChns; ++chn)
+            tile._vals[chn][dst] = nbBlock(chnOffset + chn, src);
+        }
+      }
+    }
+    template <int Halo, int NumChns>
+    constexpr void gatherPaddedBlock(padded_block_type<Halo, NumChns> &tile, size_type blockno,
+                                     size_type chnOffset) const {
+      gatherPaddedBlock(tile, blockAdjacency(blockno), chnOffset);
+    }
+
+#if ZS_ENABLE_OFB_ACCESS_CHECK
+    /// out-of-bound handle accesses are reported, then redirected past the last channel
+    constexpr bool handle_ofb(const PropertyHandle &prop, int lastChn,
+                              const char *op) const noexcept {
+      if (prop.valid() && lastChn < prop.size) return false;
+      printf(
+          "sparse grid ofb! (%s) accessing channel %d of property handle (offset %d, size %d) "
+          "(%d chns, %lld blocks) in total\n",
+          op, lastChn, prop.offset, prop.size, (int)_grid.numChannels(),
+          (long long int)numActiveBlocks());
+      return true;
+    }
+#endif
+
     table_view_type _table;
     grid_view_type _grid;
     transform_type _transform;
@@ -945,6 +1228,48 @@ namespace zs {
         spg};
   }
 
+  template <int dim_, typename ValueT, int SideLength, typename AllocatorT, typename IntegerCoordT>
+  template <typename Policy>
+  auto SparseGrid<dim_, ValueT, SideLength, AllocatorT, IntegerCoordT>::computeBlockAdjacency(
+      Policy &&pol) const -> Vector<block_adjacency_type, allocator_type> {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    if (!valid_memspace_for_execution(pol, get_allocator()))
+      throw std::runtime_error(
+          "[SparseGrid::computeBlockAdjacency] current memory location not compatible with the "
+          "execution policy");
+    const auto nbs = numBlocks();
+    Vector<block_adjacency_type, allocator_type> adjacency{get_allocator(), nbs};
+    pol(range(nbs), [spgv = proxy<space>(*this), adjacency = view<space>(adjacency)] ZS_LAMBDA(
+                        size_type bno) mutable { adjacency[bno] = spgv.blockAdjacency(bno); });
+    return adjacency;
+  }
+
+  template <int dim_, typename ValueT, int SideLength, typename AllocatorT, typename IntegerCoordT>
+  template <typename Policy, typename Fn, int Halo, int NumChns>
+  void SparseGrid<dim_, ValueT, SideLength, AllocatorT, IntegerCoordT>::forEachPaddedBlock(
+      Policy &&pol, const Vector<block_adjacency_type, allocator_type> &adjacency,
+      size_type chnOffset, Fn &&f, wrapv<Halo>, wrapv<NumChns>) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    if (!valid_memspace_for_execution(pol, get_allocator()))
+      throw std::runtime_error(
+          "[SparseGrid::forEachPaddedBlock] current memory location not compatible with the "
+          "execution policy");
+    const auto nbs = numBlocks();
+    if (adjacency.size() != nbs)
+      throw std::runtime_error(
+          "[SparseGrid::forEachPaddedBlock] block adjacency is out of date, recompute it after "
+          "topology changes");
+    if (chnOffset + NumChns > numChannels())
+      throw std::runtime_error("[SparseGrid::forEachPaddedBlock] channel range out of bound");
+    pol(range(nbs), [spgv = proxy<space>(*this), adjacency = view<space>(adjacency), chnOffset,
+                     f = FWD(f)] ZS_LAMBDA(size_type bno) mutable {
+      using spgv_t = RM_CVREF_T(spgv);
+      typename spgv_t::template padded_block_type<Halo, NumChns> tile;
+      spgv.gatherPaddedBlock(tile, adjacency[bno], chnOffset);
+      f(bno, tile, spgv);
+    });
+  }
+
 #if ZS_ENABLE_SERIALIZATION
   template <typename S, int dim, typename T, int SideLength, typename IntegerCoordT>
   void serialize(S &s, SparseGrid<dim, T, SideLength, ZSPmrAllocator<>, IntegerCoordT> &spg) {
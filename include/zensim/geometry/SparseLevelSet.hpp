@@ -837,6 +837,8 @@ namespace zs {
       return arena_type_impl<Val>(make_index_sequence<d>{});
     }
     template <typename Val> using Arena = RM_CVREF_T(arena_type<Val, lsv_t::dim>());
+    using block_cache_type
+        = StencilBlockCache<RM_CVREF_T(lsv_t::table_t::sentinel_v), typename lsv_t::IV>;
 
     /// constructors
     // index-space
@@ -896,11 +898,24 @@ namespace zs {
     constexpr Arena<value_type> arena(typename lsv_t::channel_counter_type chn,
                                       typename lsv_t::value_type defaultVal = 0) const noexcept {
       // ensure that chn's orientation is aligned with initialization if within a staggered grid
+      block_cache_type cache{};
+      return arena(chn, cache, defaultVal);
+    }
+    /// @note the (at most 2^dim) blocks touched are resolved once, blocks already resolved in
+    /// [cache] for the same corner block are reused
+    constexpr Arena<value_type> arena(typename lsv_t::channel_counter_type chn,
+                                      block_cache_type &cache,
+                                      typename lsv_t::value_type defaultVal = 0) const noexcept {
       Arena<value_type> pad{};
-      for (auto offset : ndrange<dim>(width)) {
-        pad.val(offset) = lsPtr->value_or(
-            chn, iCorner + make_vec<typename lsv_t::coord_index_type>(offset), defaultVal);
-      }
+      const auto ls = lsPtr;
+      detail::gather_blocked_stencil<lsv_t::side_length, width>(
+          pad, iCorner, cache,
+          [ls](const IV &blockOrigin) { return ls->_table.query(blockOrigin); },
+          [ls, chn](auto bno, int cno) {
+            return ls->_grid(chn, (typename lsv_t::size_type)bno,
+                             (typename lsv_t::cell_index_type)cno);
+          },
+          lsv_t::table_t::sentinel_v, defaultVal);
       return pad;
     }
     constexpr Arena<value_type> arena(const SmallString &propName,
@@ -941,11 +956,16 @@ namespace zs {
       auto pad = arena(chn, defaultVal);
       if constexpr (kt == kernel_e::linear)
         return xlerp(iLocalPos, pad);
-      else {
-        value_type ret = 0;
-        for (auto offset : ndrange<dim>(width)) ret += weight(offset) * pad.val(offset);
-        return ret;
-      }
+      else
+        return detail::contract_stencil<dim, width>(get<0>(weights), pad);
+    }
+    constexpr value_type isample(typename lsv_t::channel_counter_type chn, block_cache_type &cache,
+                                 typename lsv_t::value_type defaultVal) const noexcept {
+      auto pad = arena(chn, cache, defaultVal);
+      if constexpr (kt == kernel_e::linear)
+        return xlerp(iLocalPos, pad);
+      else
+        return detail::contract_stencil<dim, width>(get<0>(weights), pad);
     }
     constexpr value_type isample(const SmallString &propName,
                                  typename lsv_t::channel_counter_type chn,
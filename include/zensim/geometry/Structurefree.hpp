@@ -102,8 +102,8 @@ namespace zs {
       return ret;
     }
 
-    constexpr decltype(auto) attrs() { return _attributes; }
-    constexpr decltype(auto) attrs() const { return _attributes; }
+    constexpr auto &attrs() noexcept { return _attributes; }
+    constexpr const auto &attrs() const noexcept { return _attributes; }
 
     constexpr const Attribute *tryGet(const std::string &attrib) const noexcept {
       if (auto it = _attributes.find(attrib); it != _attributes.end()) return &it->second;
@@ -211,7 +211,8 @@ namespace zs {
     }
 
     void resize(size_t newSize) {
-      for (auto &&attrib : attrs()) match([newSize](auto &&att) { att.resize(newSize); })(attrib);
+      for (auto &&attrib : attrs())
+        match([newSize](auto &&att) { att.resize(newSize); })(attrib.second);
     }
 
     /// aux channels
@@ -0,0 +1,764 @@
+#pragma once
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "zensim/geometry/AdaptiveGrid.hpp"
+
+namespace zs {
+
+  /// @brief per-channel value encoding of the native grid archive
+  enum class grid_quantization_e : u8 { none = 0, q16, q8 };
+
+  ///
+  /// native sparse grid archive (.zsg)
+  /// @note layout: [header][chunk streams...][chunk table]
+  /// @note a chunk stores up to [numBlocksPerChunk] blocks of one level as
+  /// [origins][activity masks][topo masks][active values of each channel], byte-plane shuffled and
+  /// run-length coded on its own, so that chunks are encoded/decoded concurrently and box queries
+  /// only touch the chunks whose bounding box intersects the query.
+  /// @note a cell is active when any of its channels differs from the background.
+  ///
+  namespace detail {
+    constexpr u32 g_grid_archive_magic = 0x4447535a;  // "ZSGD"
+    constexpr u32 g_grid_archive_version = 1;
+    constexpr size_t g_grid_archive_chunks_per_wave = 64;
+
+    template <int dim> struct grid_archive_chunk {
+      u64 offset, numBytes, numRawBytes, numBlocks;
+      /// @note voxel-space bounding box, both inclusive
+      i32 lo[dim], hi[dim];
+    };
+    struct grid_archive_channel {
+      grid_quantization_e quant{grid_quantization_e::none};
+      f64 lo{0}, scale{0};
+    };
+
+    inline size_t grid_archive_quant_bytes(grid_quantization_e q, size_t rawBytes) noexcept {
+      return q == grid_quantization_e::q16 ? 2 : (q == grid_quantization_e::q8 ? 1 : rawBytes);
+    }
+
+    /// @brief byte-plane (de)shuffle, gathers the k-th byte of every element together
+    inline void grid_archive_shuffle(const u8 *src, u8 *dst, size_t n, size_t stride) noexcept {
+      if (stride <= 1) {
+        std::memcpy(dst, src, n * stride);
+        return;
+      }
+      for (size_t b = 0; b != stride; ++b)
+        for (size_t i = 0; i != n; ++i) dst[b * n + i] = src[i * stride + b];
+    }
+    inline void grid_archive_unshuffle(const u8 *src, u8 *dst, size_t n, size_t stride) noexcept {
+      if (stride <= 1) {
+        std::memcpy(dst, src, n * stride);
+        return;
+      }
+      for (size_t b = 0; b != stride; ++b)
+        for (size_t i = 0; i != n; ++i) dst[i * stride + b] = src[b * n + i];
+    }
+
+    /// @brief packbits-style run-length coding
+    /// @note control byte c < 128: (c + 1) literal bytes follow; otherwise the next byte repeats
+    /// (c - 125) times
+    inline std::vector<u8> grid_archive_rle_encode(const std::vector<u8> &src) {
+      std::vector<u8> ret;
+      ret.reserve(src.size() / 4 + 16);
+      const size_t n = src.size();
+      size_t litSt = 0, i = 0;
+      auto flushLiterals = [&](size_t ed) {
+        while (litSt < ed) {
+          size_t cnt = ed - litSt < 128 ? ed - litSt : 128;
+          ret.push_back((u8)(cnt - 1));
+          ret.insert(ret.end(), src.begin() + litSt, src.begin() + litSt + cnt);
+          litSt += cnt;
+        }
+      };
+      while (i < n) {
+        size_t j = i + 1;
+        while (j < n && src[j] == src[i] && j - i < 130) ++j;
+        if (j - i >= 3) {
+          flushLiterals(i);
+          ret.push_back((u8)(j - i + 125));
+          ret.push_back(src[i]);
+          litSt = i = j;
+        } else
+          i = j;
+      }
+      flushLiterals(n);
+      return ret;
+    }
+    inline bool grid_archive_rle_decode(const u8 *src, size_t n, std::vector<u8> &dst,
+                                        size_t numRawBytes) {
+      dst.resize(numRawBytes);
+      size_t o = 0;
+      for (size_t i = 0; i < n;) {
+        u8 c = src[i++];
+        if (c < 128) {
+          size_t cnt = (size_t)c + 1;
+          if (i + cnt > n || o + cnt > numRawBytes) return false;
+          std::memcpy(dst.data() + o, src + i, cnt);
+          i += cnt;
+          o += cnt;
+        } else {
+          size_t cnt = (size_t)c - 125;
+          if (i >= n || o + cnt > numRawBytes) return false;
+          std::memset(dst.data() + o, src[i++], cnt);
+          o += cnt;
+        }
+      }
+      return o == numRawBytes;
+    }
+
+    template <typename T> void grid_archive_put(std::vector<u8> &buf, const T &v) {
+      const auto *p = reinterpret_cast<const u8 *>(&v);
+      buf.insert(buf.end(), p, p + sizeof(T));
+    }
+    template <typename T> void grid_archive_get(std::istream &is, T &v) {
+      is.read(reinterpret_cast<char *>(&v), sizeof(T));
+    }
+
+    template <typename ValueT>
+    void grid_archive_encode_value(u8 *dst, ValueT v, const grid_archive_channel &codec) {
+      if (codec.quant == grid_quantization_e::none) {
+        std::memcpy(dst, &v, sizeof(ValueT));
+        return;
+      }
+      const f64 maxq = codec.quant == grid_quantization_e::q16 ? 65535. : 255.;
+      f64 q = codec.scale > 0 ? ((f64)v - codec.lo) / codec.scale + 0.5 : 0.;
+      q = q < 0 ? 0 : (q > maxq ? maxq : q);
+      if (codec.quant == grid_quantization_e::q16) {
+        u16 w = (u16)q;
+        std::memcpy(dst, &w, sizeof(u16));
+      } else
+        *dst = (u8)q;
+    }
+    template <typename ValueT>
+    ValueT grid_archive_decode_value(const u8 *src, const grid_archive_channel &codec) {
+      if (codec.quant == grid_quantization_e::none) {
+        ValueT v;
+        std::memcpy(&v, src, sizeof(ValueT));
+        return v;
+      }
+      f64 q = 0;
+      if (codec.quant == grid_quantization_e::q16) {
+        u16 w;
+        std::memcpy(&w, src, sizeof(u16));
+        q = w;
+      } else
+        q = *src;
+      return (ValueT)(codec.lo + q * codec.scale);
+    }
+
+    /// @brief per-layer (sparse grid, or one adaptive grid level) description
+    template <int dim, typename ValueT> struct grid_archive_layer {
+      size_t numBlocks, blockSize, numTopoBytes;
+      /// @note number of voxels a block covers along each axis
+      i32 blockExtent;
+      /// @note log2 of the voxels a cell covers along each axis
+      i32 cellBits;
+    };
+
+    /// @brief value range of active cells for quantization
+    template <typename ExecPol, int dim, typename ValueT, typename ValueF>
+    void grid_archive_value_range(ExecPol &pol, const grid_archive_layer<dim, ValueT> &layer,
+                                  size_t numChns, ValueT background, ValueF &&value,
+                                  std::vector<f64> &mins, std::vector<f64> &maxs) {
+      const size_t nbs = layer.numBlocks;
+      std::vector<f64> blockMins(nbs * numChns), blockMaxs(nbs * numChns);
+      pol(range(nbs), [&](size_t bno) {
+        for (size_t chn = 0; chn != numChns; ++chn) {
+          blockMins[bno * numChns + chn] = detail::deduce_numeric_max<f64>();
+          blockMaxs[bno * numChns + chn] = detail::deduce_numeric_lowest<f64>();
+        }
+        for (size_t cno = 0; cno != layer.blockSize; ++cno) {
+          bool active = false;
+          for (size_t chn = 0; chn != numChns && !active; ++chn)
+            active = value(chn, bno, cno) != background;
+          if (!active) continue;
+          for (size_t chn = 0; chn != numChns; ++chn) {
+            f64 v = (f64)value(chn, bno, cno);
+            auto &mi = blockMins[bno * numChns + chn];
+            auto &ma = blockMaxs[bno * numChns + chn];
+            mi = v < mi ? v : mi;
+            ma = v > ma ? v : ma;
+          }
+        }
+      });
+      for (size_t bno = 0; bno != nbs; ++bno)
+        for (size_t chn = 0; chn != numChns; ++chn) {
+          mins[chn] = blockMins[bno * numChns + chn] < mins[chn] ? blockMins[bno * numChns + chn]
+                                                                 : mins[chn];
+          maxs[chn] = blockMaxs[bno * numChns + chn] > maxs[chn] ? blockMaxs[bno * numChns + chn]
+                                                                 : maxs[chn];
+        }
+    }
+
+    /// @brief encode chunks of a layer in parallel (in waves) and append them to [os]
+    template <typename ExecPol, int dim, typename ValueT, typename OriginF, typename ValueF,
+              typename TopoF>
+    std::vector<grid_archive_chunk<dim>> grid_archive_write_layer(
+        ExecPol &pol, std::ostream &os, const grid_archive_layer<dim, ValueT> &layer,
+        size_t numBlocksPerChunk, ValueT background,
+        const std::vector<grid_archive_channel> &codecs, OriginF &&origin, ValueF &&value,
+        TopoF &&topo) {
+      const size_t nbs = layer.numBlocks, bs = layer.blockSize, numChns = codecs.size();
+      const size_t numMaskBytes = (bs + 7) / 8;
+      const size_t numChunks = (nbs + numBlocksPerChunk - 1) / numBlocksPerChunk;
+      std::vector<grid_archive_chunk<dim>> chunks(numChunks);
+      std::vector<std::vector<u8>> streams;
+
+      for (size_t waveSt = 0; waveSt < numChunks; waveSt += g_grid_archive_chunks_per_wave) {
+        const size_t waveSize = numChunks - waveSt < g_grid_archive_chunks_per_wave
+                                    ? numChunks - waveSt
+                                    : g_grid_archive_chunks_per_wave;
+        streams.assign(waveSize, {});
+        pol(range(waveSize), [&](size_t k) {
+          auto &chunk = chunks[waveSt + k];
+          const size_t st = (waveSt + k) * numBlocksPerChunk;
+          const size_t nb = nbs - st < numBlocksPerChunk ? nbs - st : numBlocksPerChunk;
+          chunk.numBlocks = nb;
+          for (int d = 0; d != dim; ++d) {
+            chunk.lo[d] = detail::deduce_numeric_max<i32>();
+            chunk.hi[d] = detail::deduce_numeric_lowest<i32>();
+          }
+          /// origins and masks
+          std::vector<i32> origins(nb * dim);
+          std::vector<u8> masks(nb * numMaskBytes, 0), topos(nb * layer.numTopoBytes);
+          size_t numActive = 0;
+          for (size_t i = 0; i != nb; ++i) {
+            const auto o = origin(st + i);
+            for (int d = 0; d != dim; ++d) {
+              origins[i * dim + d] = (i32)o[d];
+              chunk.lo[d] = (i32)o[d] < chunk.lo[d] ? (i32)o[d] : chunk.lo[d];
+              const i32 h = (i32)o[d] + layer.blockExtent - 1;
+              chunk.hi[d] = h > chunk.hi[d] ? h : chunk.hi[d];
+            }
+            u8 *mask = masks.data() + i * numMaskBytes;
+            for (size_t cno = 0; cno != bs; ++cno) {
+              bool active = false;
+              for (size_t chn = 0; chn != numChns && !active; ++chn)
+                active = value(chn, st + i, cno) != background;
+              if (active) {
+                mask[cno >> 3] |= (u8)(1u << (cno & 7));
+                ++numActive;
+              }
+            }
+            if (layer.numTopoBytes) topo(st + i, topos.data() + i * layer.numTopoBytes);
+          }
+          /// raw (shuffled) payload
+          size_t numRawBytes = origins.size() * sizeof(i32) + masks.size() + topos.size();
+          for (size_t chn = 0; chn != numChns; ++chn)
+            numRawBytes += numActive * grid_archive_quant_bytes(codecs[chn].quant, sizeof(ValueT));
+          std::vector<u8> raw(numRawBytes);
+          u8 *dst = raw.data();
+          grid_archive_shuffle(reinterpret_cast<const u8 *>(origins.data()), dst, origins.size(),
+                               sizeof(i32));
+          dst += origins.size() * sizeof(i32);
+          std::memcpy(dst, masks.data(), masks.size());
+          dst += masks.size();
+          if (topos.size()) std::memcpy(dst, topos.data(), topos.size());
+          dst += topos.size();
+          std::vector<u8> vals;
+          for (size_t chn = 0; chn != numChns; ++chn) {
+            const size_t stride = grid_archive_quant_bytes(codecs[chn].quant, sizeof(ValueT));
+            vals.resize(numActive * stride);
+            size_t n = 0;
+            for (size_t i = 0; i != nb; ++i) {
+              const u8 *mask = masks.data() + i * numMaskBytes;
+              for (size_t cno = 0; cno != bs; ++cno)
+                if (mask[cno >> 3] & (1u << (cno & 7)))
+                  grid_archive_encode_value(vals.data() + (n++) * stride,
+                                            (ValueT)value(chn, st + i, cno), codecs[chn]);
+            }
+            grid_archive_shuffle(vals.data(), dst, numActive, stride);
+            dst += numActive * stride;
+          }
+          chunk.numRawBytes = numRawBytes;
+          streams[k] = grid_archive_rle_encode(raw);
+          chunk.numBytes = streams[k].size();
+        });
+        for (size_t k = 0; k != waveSize; ++k) {
+          chunks[waveSt + k].offset = (u64)os.tellp();
+          os.write(reinterpret_cast<const char *>(streams[k].data()), streams[k].size());
+        }
+      }
+      if (!os) throw std::runtime_error("[write_grid] failed to write chunk streams");
+      return chunks;
+    }
+
+    /// @brief decode chunks of a layer (intersecting the box [lo, hi] when [boxed]) in parallel
+    /// @note insert(origin, topoBytes) returns the destination block number (negative to skip),
+    /// assign(chn, bno, cno, value) stores an active value
+    template <typename ExecPol, int dim, typename ValueT, typename InsertF, typename AssignF>
+    void grid_archive_read_layer(ExecPol &pol, const std::string &filename,
+                                 const grid_archive_layer<dim, ValueT> &layer,
+                                 const std::vector<grid_archive_chunk<dim>> &chunks,
+                                 const std::vector<grid_archive_channel> &codecs, bool boxed,
+                                 const i32 *lo, const i32 *hi, InsertF &&insert,
+                                 AssignF &&assign) {
+      auto overlaps = [&](const i32 *l, const i32 *h) {
+        if (!boxed) return true;
+        for (int d = 0; d != dim; ++d)
+          if (h[d] < lo[d] || l[d] > hi[d]) return false;
+        return true;
+      };
+      std::vector<size_t> selected;
+      for (size_t i = 0; i != chunks.size(); ++i)
+        if (overlaps(chunks[i].lo, chunks[i].hi)) selected.push_back(i);
+
+      const size_t bs = layer.blockSize, numChns = codecs.size();
+      const size_t numMaskBytes = (bs + 7) / 8;
+      std::vector<int> failed(selected.size(), 0);
+      pol(range(selected.size()), [&](size_t k) {
+        const auto &chunk = chunks[selected[k]];
+        std::ifstream is(filename, std::ios::binary);
+        std::vector<u8> stream(chunk.numBytes), raw;
+        is.seekg((std::streamoff)chunk.offset);
+        is.read(reinterpret_cast<char *>(stream.data()), chunk.numBytes);
+        if (!is || !grid_archive_rle_decode(stream.data(), stream.size(), raw, chunk.numRawBytes)) {
+          failed[k] = 1;
+          return;
+        }
+        const size_t nb = chunk.numBlocks;
+        const u8 *src = raw.data();
+        std::vector<i32> origins(nb * dim);
+        grid_archive_unshuffle(src, reinterpret_cast<u8 *>(origins.data()), origins.size(),
+                               sizeof(i32));
+        src += origins.size() * sizeof(i32);
+        const u8 *masks = src;
+        src += nb * numMaskBytes;
+        const u8 *topos = src;
+        src += nb * layer.numTopoBytes;
+
+        size_t numActive = 0;
+        for (size_t b = 0; b != nb * numMaskBytes; ++b) numActive += count_ones((u32)masks[b]);
+        /// destination block numbers
+        std::vector<long long> bnos(nb);
+        for (size_t i = 0; i != nb; ++i) {
+          const i32 *l = origins.data() + i * dim;
+          i32 h[dim];
+          for (int d = 0; d != dim; ++d) h[d] = l[d] + layer.blockExtent - 1;
+          bnos[i] = overlaps(l, h) ? (long long)insert(l, topos + i * layer.numTopoBytes) : -1;
+        }
+        std::vector<u8> vals;
+        for (size_t chn = 0; chn != numChns; ++chn) {
+          const size_t stride = grid_archive_quant_bytes(codecs[chn].quant, sizeof(ValueT));
+          vals.resize(numActive * stride);
+          grid_archive_unshuffle(src, vals.data(), numActive, stride);
+          src += numActive * stride;
+          size_t n = 0;
+          for (size_t i = 0; i != nb; ++i) {
+            const u8 *mask = masks + i * numMaskBytes;
+            for (size_t cno = 0; cno != bs; ++cno)
+              if (mask[cno >> 3] & (1u << (cno & 7))) {
+                if (bnos[i] >= 0)
+                  assign(chn, bnos[i], cno,
+                         grid_archive_decode_value<ValueT>(vals.data() + n * stride, codecs[chn]));
+                ++n;
+              }
+          }
+        }
+      });
+      for (auto f : failed)
+        if (f) throw std::runtime_error("[read_grid] corrupted chunk stream");
+    }
+
+    /// @brief shared header
+    template <int dim, typename ValueT, typename TransformT> struct grid_archive_header {
+      u8 kind;  // 0: sparse grid, 1: adaptive grid
+      std::vector<grid_archive_layer<dim, ValueT>> layers;
+      TransformT transform;
+      ValueT background;
+      std::vector<PropertyTag> tags;
+      std::vector<grid_archive_channel> codecs;
+      u64 tableOffset;
+    };
+
+    template <int dim, typename ValueT, typename TransformT>
+    void grid_archive_write_header(std::ostream &os,
+                                   const grid_archive_header<dim, ValueT, TransformT> &h) {
+      std::vector<u8> buf;
+      grid_archive_put(buf, g_grid_archive_magic);
+      grid_archive_put(buf, g_grid_archive_version);
+      grid_archive_put(buf, h.kind);
+      grid_archive_put(buf, (u8)dim);
+      grid_archive_put(buf, (u8)sizeof(ValueT));
+      grid_archive_put(buf, (u8)is_floating_point_v<ValueT>);
+      grid_archive_put(buf, (u32)h.layers.size());
+      for (const auto &layer : h.layers) {
+        grid_archive_put(buf, (u64)layer.numBlocks);
+        grid_archive_put(buf, (u64)layer.blockSize);
+        grid_archive_put(buf, (u64)layer.numTopoBytes);
+        grid_archive_put(buf, layer.blockExtent);
+        grid_archive_put(buf, layer.cellBits);
+      }
+      for (int r = 0; r != dim + 1; ++r)
+        for (int c = 0; c != dim + 1; ++c) grid_archive_put(buf, (f64)h.transform(r, c));
+      grid_archive_put(buf, h.background);
+      grid_archive_put(buf, (u32)h.tags.size());
+      for (const auto &tag : h.tags) {
+        const std::string name = tag.name.asChars();
+        grid_archive_put(buf, (u32)name.size());
+        buf.insert(buf.end(), name.begin(), name.end());
+        grid_archive_put(buf, (i32)tag.numChannels);
+      }
+      for (const auto &codec : h.codecs) {
+        grid_archive_put(buf, (u8)codec.quant);
+        grid_archive_put(buf, codec.lo);
+        grid_archive_put(buf, codec.scale);
+      }
+      grid_archive_put(buf, h.tableOffset);
+      os.write(reinterpret_cast<const char *>(buf.data()), buf.size());
+    }
+
+    template <int dim, typename ValueT, typename TransformT>
+    void grid_archive_read_header(std::istream &is,
+                                  grid_archive_header<dim, ValueT, TransformT> &h) {
+      u32 magic{}, version{};
+      u8 fileDim{}, valueBytes{}, isFloat{};
+      u32 numLayers{};
+      grid_archive_get(is, magic);
+      grid_archive_get(is, version);
+      if (!is || magic != g_grid_archive_magic || version != g_grid_archive_version)
+        throw std::runtime_error("[read_grid] not a zpc grid archive (or unsupported version)");
+      grid_archive_get(is, h.kind);
+      grid_archive_get(is, fileDim);
+      grid_archive_get(is, valueBytes);
+      grid_archive_get(is, isFloat);
+      if (fileDim != dim || valueBytes != sizeof(ValueT)
+          || (bool)isFloat != is_floating_point_v<ValueT>)
+        throw std::runtime_error("[read_grid] archive dimension/value type mismatch");
+      grid_archive_get(is, numLayers);
+      h.layers.resize(numLayers);
+      for (auto &layer : h.layers) {
+        u64 nbs{}, bs{}, ntb{};
+        grid_archive_get(is, nbs);
+        grid_archive_get(is, bs);
+        grid_archive_get(is, ntb);
+        layer.numBlocks = nbs;
+        layer.blockSize = bs;
+        layer.numTopoBytes = ntb;
+        grid_archive_get(is, layer.blockExtent);
+        grid_archive_get(is, layer.cellBits);
+      }
+      for (int r = 0; r != dim + 1; ++r)
+        for (int c = 0; c != dim + 1; ++c) {
+          f64 v{};
+          grid_archive_get(is, v);
+          h.transform(r, c) = v;
+        }
+      grid_archive_get(is, h.background);
+      u32 numTags{};
+      grid_archive_get(is, numTags);
+      h.tags.resize(numTags);
+      size_t numChns = 0;
+      for (auto &tag : h.tags) {
+        u32 len{};
+        grid_archive_get(is, len);
+        std::string name(len, '\0');
+        is.read(name.data(), len);
+        i32 nchns{};
+        grid_archive_get(is, nchns);
+        tag = PropertyTag{SmallString{name}, (int)nchns};
+        numChns += nchns;
+      }
+      h.codecs.resize(numChns);
+      for (auto &codec : h.codecs) {
+        u8 q{};
+        grid_archive_get(is, q);
+        codec.quant = static_cast<grid_quantization_e>(q);
+        grid_archive_get(is, codec.lo);
+        grid_archive_get(is, codec.scale);
+      }
+      grid_archive_get(is, h.tableOffset);
+      if (!is) throw std::runtime_error("[read_grid] truncated archive header");
+    }
+
+    template <int dim>
+    void grid_archive_write_table(std::ostream &os,
+                                  const std::vector<std::vector<grid_archive_chunk<dim>>> &tables) {
+      std::vector<u8> buf;
+      for (const auto &chunks : tables) {
+        grid_archive_put(buf, (u64)chunks.size());
+        for (const auto &chunk : chunks) grid_archive_put(buf, chunk);
+      }
+      os.write(reinterpret_cast<const char *>(buf.data()), buf.size());
+    }
+    template <int dim>
+    void grid_archive_read_table(std::istream &is, size_t numLayers,
+                                 std::vector<std::vector<grid_archive_chunk<dim>>> &tables) {
+      tables.resize(numLayers);
+      for (auto &chunks : tables) {
+        u64 n{};
+        grid_archive_get(is, n);
+        chunks.resize(n);
+        for (auto &chunk : chunks) grid_archive_get(is, chunk);
+      }
+      if (!is) throw std::runtime_error("[read_grid] truncated chunk table");
+    }
+
+    template <typename ValueT>
+    std::vector<grid_archive_channel> grid_archive_codecs(
+        size_t numChns, const std::vector<grid_quantization_e> &quant) {
+      std::vector<grid_archive_channel> ret(numChns);
+      for (size_t chn = 0; chn != numChns && chn != quant.size(); ++chn) {
+        if (quant[chn] != grid_quantization_e::none && !is_floating_point_v<ValueT>)
+          throw std::runtime_error("[write_grid] quantization requires floating point values");
+        ret[chn].quant = quant[chn];
+      }
+      return ret;
+    }
+    inline void grid_archive_fit_codecs(std::vector<grid_archive_channel> &codecs,
+                                        const std::vector<f64> &mins,
+                                        const std::vector<f64> &maxs) {
+      for (size_t chn = 0; chn != codecs.size(); ++chn) {
+        auto &codec = codecs[chn];
+        if (codec.quant == grid_quantization_e::none || mins[chn] > maxs[chn]) continue;
+        const f64 maxq = codec.quant == grid_quantization_e::q16 ? 65535. : 255.;
+        codec.lo = mins[chn];
+        codec.scale = (maxs[chn] - mins[chn]) / maxq;
+      }
+    }
+
+    template <typename F, size_t... Is>
+    void grid_archive_for_levels(F &&f, index_sequence<Is...>) {
+      ((void)f(wrapv<(int)Is>{}), ...);
+    }
+  }  // namespace detail
+
+  ///
+  /// @brief write a SparseGrid or AdaptiveGrid to [filename] in the native archive format
+  /// @param quant optional per-channel quantization (missing entries default to none)
+  ///
+  template <typename ExecPol, typename GridT, enable_if_t<is_spg_v<GridT> || is_ag_v<GridT>> = 0>
+  void write_grid(ExecPol &&pol, const GridT &grid, const std::string &filename,
+                  const std::vector<grid_quantization_e> &quant = {},
+                  size_t numBlocksPerChunk = 256) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_host_execution<space>(), "grid archive io requires a host execution policy");
+    using value_type = typename GridT::value_type;
+    static_assert(is_arithmetic_v<value_type>, "only scalar-valued grids are supported");
+    constexpr int dim = GridT::dim;
+    using layer_t = detail::grid_archive_layer<dim, value_type>;
+    using chunk_t = detail::grid_archive_chunk<dim>;
+
+    if (numBlocksPerChunk == 0)
+      throw std::runtime_error("[write_grid] numBlocksPerChunk should be positive");
+    if (!grid.memoryLocation().onHost()) {
+      write_grid(FWD(pol), grid.clone({memsrc_e::host, -1}), filename, quant, numBlocksPerChunk);
+      return;
+    }
+    std::ofstream os(filename, std::ios::binary | std::ios::trunc);
+    if (!os) throw std::runtime_error(fmt::format("[write_grid] unable to open {}", filename));
+
+    const size_t numChns = grid.numChannels();
+    detail::grid_archive_header<dim, value_type, typename GridT::transform_type> header{};
+    header.transform = grid._transform;
+    header.background = grid._background;
+    header.tags = grid.getPropertyTags();
+    header.codecs = detail::grid_archive_codecs<value_type>(numChns, quant);
+    header.tableOffset = 0;
+    std::vector<f64> mins(numChns, detail::deduce_numeric_max<f64>()),
+        maxs(numChns, detail::deduce_numeric_lowest<f64>());
+    std::vector<std::vector<chunk_t>> tables;
+
+    auto gv = proxy<space>(grid);
+    if constexpr (is_spg_v<GridT>) {
+      header.kind = 0;
+      header.layers.push_back(layer_t{grid.numBlocks(), (size_t)GridT::block_size, 0,
+                                      (i32)GridT::side_length, 0});
+      auto value = [&gv](size_t chn, size_t bno, size_t cno) { return gv._grid(chn, bno, cno); };
+      detail::grid_archive_value_range(pol, header.layers[0], numChns, grid._background, value,
+                                       mins, maxs);
+      detail::grid_archive_fit_codecs(header.codecs, mins, maxs);
+      detail::grid_archive_write_header(os, header);
+      tables.push_back(detail::grid_archive_write_layer(
+          pol, os, header.layers[0], numBlocksPerChunk, grid._background, header.codecs,
+          [&gv](size_t bno) { return gv._table._activeKeys[bno]; }, value, [](size_t, u8 *) {}));
+    } else {
+      header.kind = 1;
+      constexpr auto levels = make_index_sequence<GridT::num_levels>{};
+      auto levelValue = [&gv](auto lNo) {
+        return [&gv](size_t chn, size_t bno, size_t cno) {
+          return gv.level(RM_CVREF_T(lNo){}).grid(chn, bno, cno);
+        };
+      };
+      detail::grid_archive_for_levels(
+          [&](auto lNo) {
+            constexpr int I = RM_CVREF_T(lNo)::value;
+            using level_t = typename GridT::template Level<I>;
+            header.layers.push_back(layer_t{
+                (size_t)grid.numBlocks(lNo), (size_t)level_t::block_size,
+                sizeof(typename level_t::tile_mask_type::value_type)
+                    + sizeof(typename level_t::hierarchy_mask_type::value_type),
+                (i32)(level_t::cell_mask + 1), (i32)level_t::sbit});
+            detail::grid_archive_value_range(pol, header.layers[I], numChns, grid._background,
+                                             levelValue(lNo), mins, maxs);
+          },
+          levels);
+      detail::grid_archive_fit_codecs(header.codecs, mins, maxs);
+      detail::grid_archive_write_header(os, header);
+      detail::grid_archive_for_levels(
+          [&](auto lNo) {
+            constexpr int I = RM_CVREF_T(lNo)::value;
+            auto lv = gv.level(lNo);
+            tables.push_back(detail::grid_archive_write_layer(
+                pol, os, header.layers[I], numBlocksPerChunk, grid._background, header.codecs,
+                [lv](size_t bno) { return lv.table._activeKeys[bno]; }, levelValue(lNo),
+                [lv](size_t bno, u8 *dst) {
+                  const auto &vm = lv.valueMask[bno];
+                  const auto &cm = lv.childMask[bno];
+                  std::memcpy(dst, &vm, sizeof(vm));
+                  std::memcpy(dst + sizeof(vm), &cm, sizeof(cm));
+                }));
+          },
+          levels);
+    }
+    /// chunk table, then patch its offset into the header
+    header.tableOffset = (u64)os.tellp();
+    detail::grid_archive_write_table(os, tables);
+    os.seekp(0);
+    detail::grid_archive_write_header(os, header);
+    if (!os) throw std::runtime_error(fmt::format("[write_grid] failed writing {}", filename));
+  }
+
+  namespace detail {
+    template <typename ExecPol, typename GridT>
+    void read_grid_impl(ExecPol &pol, GridT &grid, const std::string &filename, bool boxed,
+                        const typename GridT::integer_coord_type &lo,
+                        const typename GridT::integer_coord_type &hi) {
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      static_assert(is_host_execution<space>(),
+                    "grid archive io requires a host execution policy");
+      using value_type = typename GridT::value_type;
+      static_assert(is_arithmetic_v<value_type>, "only scalar-valued grids are supported");
+      constexpr int dim = GridT::dim;
+      using chunk_t = grid_archive_chunk<dim>;
+      using integer_coord_type = typename GridT::integer_coord_type;
+
+      std::ifstream is(filename, std::ios::binary);
+      if (!is) throw std::runtime_error(fmt::format("[read_grid] unable to open {}", filename));
+      grid_archive_header<dim, value_type, typename GridT::transform_type> header{};
+      grid_archive_read_header(is, header);
+      std::vector<std::vector<chunk_t>> tables;
+      is.seekg((std::streamoff)header.tableOffset);
+      grid_archive_read_table(is, header.layers.size(), tables);
+
+      i32 boxLo[dim], boxHi[dim];
+      for (int d = 0; d != dim; ++d) {
+        boxLo[d] = (i32)lo[d];
+        boxHi[d] = (i32)hi[d];
+      }
+      /// upper bound of the number of loaded blocks per layer
+      auto numCandidateBlocks = [&](size_t l) {
+        size_t n = 0;
+        for (const auto &chunk : tables[l]) {
+          bool overlap = true;
+          for (int d = 0; d != dim && boxed; ++d)
+            if (chunk.hi[d] < boxLo[d] || chunk.lo[d] > boxHi[d]) overlap = false;
+          if (overlap) n += chunk.numBlocks;
+        }
+        return n;
+      };
+      auto toCoord = [](const i32 *o) {
+        return integer_coord_type::init([o](int d) { return o[d]; });
+      };
+      auto allocator = get_memory_source(memsrc_e::host, -1);
+
+      if constexpr (is_spg_v<GridT>) {
+        if (header.kind != 0 || header.layers.size() != 1
+            || header.layers[0].blockSize != (size_t)GridT::block_size)
+          throw std::runtime_error("[read_grid] archive does not hold a matching sparse grid");
+        const auto nbs = numCandidateBlocks(0);
+        grid = GridT{allocator, header.tags, nbs};
+        grid._transform = header.transform;
+        grid._background = header.background;
+        grid._grid.reset(pol, header.background);
+        auto gv = proxy<space>(grid);
+        grid_archive_read_layer(
+            pol, filename, header.layers[0], tables[0], header.codecs, boxed, boxLo, boxHi,
+            [&gv, &toCoord](const i32 *o, const u8 *) { return gv._table.insert(toCoord(o)); },
+            [&gv](size_t chn, size_t bno, size_t cno, value_type v) {
+              gv._grid(chn, bno, cno) = v;
+            });
+        grid.resizeGrid(grid.numBlocks());
+      } else {
+        if (header.kind != 1 || header.layers.size() != (size_t)GridT::num_levels)
+          throw std::runtime_error("[read_grid] archive does not hold a matching adaptive grid");
+        constexpr auto levels = make_index_sequence<GridT::num_levels>{};
+        grid = GridT{};
+        grid._transform = header.transform;
+        grid._background = header.background;
+        grid_archive_for_levels(
+            [&](auto lNo) {
+              constexpr int I = RM_CVREF_T(lNo)::value;
+              using level_t = typename GridT::template Level<I>;
+              if (header.layers[I].blockSize != (size_t)level_t::block_size
+                  || header.layers[I].cellBits != (i32)level_t::sbit)
+                throw std::runtime_error("[read_grid] adaptive grid level layout mismatch");
+              auto &l = grid.level(lNo);
+              l = level_t{allocator, header.tags, numCandidateBlocks(I)};
+              l.grid.reset(pol, header.background);
+              auto lv = proxy<space>(grid).level(lNo);
+              grid_archive_read_layer(
+                  pol, filename, header.layers[I], tables[I], header.codecs, boxed, boxLo, boxHi,
+                  [lv, &toCoord](const i32 *o, const u8 *topo) mutable {
+                    auto bno = lv.table.insert(toCoord(o));
+                    if (bno >= 0) {
+                      std::memcpy(&lv.valueMask[bno], topo, sizeof(lv.valueMask[bno]));
+                      std::memcpy(&lv.childMask[bno], topo + sizeof(lv.valueMask[bno]),
+                                  sizeof(lv.childMask[bno]));
+                    }
+                    return bno;
+                  },
+                  [lv](size_t chn, size_t bno, size_t cno, value_type v) mutable {
+                    lv.grid(chn, bno, cno) = v;
+                  });
+              l.refitToPartition();
+            },
+            levels);
+        /// drop children that fall outside of the loaded box
+        if (boxed)
+          grid_archive_for_levels(
+              [&](auto lNo) {
+                constexpr int I = RM_CVREF_T(lNo)::value;
+                if constexpr (I > 0) {
+                  auto agv = proxy<space>(grid);
+                  auto lv = agv.level(lNo);
+                  auto clv = agv.level(wrapv<I - 1>{});
+                  constexpr auto hierarchy_size = GridT::template get_hierarchy_size<I>();
+                  pol(range(lv.numBlocks()), [&](size_t bno) {
+                    auto &cm = lv.childMask[bno];
+                    const auto origin = lv.table._activeKeys[bno];
+                    for (typename GridT::size_type i = 0; i != hierarchy_size; ++i)
+                      if (cm.isOn(i)
+                          && clv.table.query(
+                                 origin + GridT::template hierarchy_offset_to_coord<I>(i))
+                                 == GridT::sentinel_v)
+                        cm.setOff(i);
+                  });
+                }
+              },
+              levels);
+        /// rebuild childOffset (and the matching block order)
+        if constexpr (GridT::num_levels > 1) grid.reorder(pol);
+      }
+    }
+  }  // namespace detail
+
+  /// @brief load a SparseGrid or AdaptiveGrid written by write_grid (host memory)
+  template <typename ExecPol, typename GridT, enable_if_t<is_spg_v<GridT> || is_ag_v<GridT>> = 0>
+  void read_grid(ExecPol &&pol, GridT &grid, const std::string &filename) {
+    typename GridT::integer_coord_type dummy{};
+    detail::read_grid_impl(pol, grid, filename, false, dummy, dummy);
+  }
+  /// @brief only load blocks intersecting the index-space box [lo, hi] (both inclusive)
+  /// @note for adaptive grids, coarser tiles covering the box are loaded as well
+  template <typename ExecPol, typename GridT, enable_if_t<is_spg_v<GridT> || is_ag_v<GridT>> = 0>
+  void read_grid(ExecPol &&pol, GridT &grid, const std::string &filename,
+                 const typename GridT::integer_coord_type &lo,
+                 const typename GridT::integer_coord_type &hi) {
+    detail::read_grid_impl(pol, grid, filename, true, lo, hi);
+  }
+
+}  // namespace zs
@@ -6,18 +6,14 @@ namespace zs {
 
   struct IO {
   private:
-    void wait() {
-      std::unique_lock<std::mutex> lk{mut};
-      cv.wait(lk, [this]() { return !this->bRunning || !this->jobs.empty(); });
-    };
     void worker() {
-      while (bRunning) {
-        wait();
-        auto job = jobs.try_pop();
-        if (job) (*job)();
+      // an empty job is the signal to quit
+      while (auto job = jobs.wait_and_pop()) {
+        job();
+        if (numPending.fetch_sub(1, std::memory_order_acq_rel) == 1) Futex::wake(&numPending);
       }
     }
-    IO() : bRunning{true} {
+    IO() : numPending{0} {
       th = std::thread([this]() { this->worker(); });
     }
 
@@ -27,25 +23,25 @@ namespace zs {
       return s_instance;
     }
     ~IO() {
-      while (!jobs.empty()) cv.notify_all();
-      bRunning = false;
+      jobs.push(zs::function<void()>{});
       th.join();
     }
 
+    /// blocks until every inserted job has finished
     static void flush() {
-      while (!instance().jobs.empty()) instance().cv.notify_all();
+      auto &numPending = instance().numPending;
+      for (u32 n = numPending.load(std::memory_order_acquire); n != 0;
+           n = numPending.load(std::memory_order_acquire))
+        Futex::wait(&numPending, n);
     }
     static void insert_job(zs::function<void()> job) {
-      std::unique_lock<std::mutex> lk{instance().mut};
-      instance().jobs.push(job);
-      lk.unlock();
-      instance().cv.notify_all();
+      if (!job) return;
+      instance().numPending.fetch_add(1, std::memory_order_acq_rel);
+      instance().jobs.push(zs::move(job));
     }
 
   private:
-    bool bRunning;
-    std::mutex mut;
-    std::condition_variable cv;
+    std::atomic<u32> numPending;
     threadsafe_queue<zs::function<void()>> jobs;
     std::thread th;
   };
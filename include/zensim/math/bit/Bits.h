@@ -127,6 +127,36 @@ namespace zs {
     return (expand_bits_64((u32)(x * 2097152.)) << 2) | (expand_bits_64((u32)(y * 2097152.)) << 1)
            | expand_bits_64((u32)(z * 2097152.));
   }
+  /// morton index of integer cell coordinates (lower 21 bits each)
+  constexpr u64 morton_3d_index_64(u32 x, u32 y, u32 z) noexcept {
+    return (expand_bits_64(x) << 2) | (expand_bits_64(y) << 1) | expand_bits_64(z);
+  }
+  /// hilbert index of integer cell coordinates, [bits] (<= 21) per axis
+  /// @note ref: Programming the Hilbert curve, John Skilling
+  constexpr u64 hilbert_3d_index_64(u32 x, u32 y, u32 z, int bits = 21) noexcept {
+    u32 X[3] = {x, y, z};
+    const u32 M = (u32)1 << (bits - 1);
+    // inverse undo excess work
+    for (u32 Q = M; Q > 1; Q >>= 1) {
+      const u32 P = Q - 1;
+      for (int i = 0; i != 3; ++i)
+        if (X[i] & Q)
+          X[0] ^= P;
+        else {
+          const u32 t = (X[0] ^ X[i]) & P;
+          X[0] ^= t;
+          X[i] ^= t;
+        }
+    }
+    // gray encode
+    for (int i = 1; i != 3; ++i) X[i] ^= X[i - 1];
+    u32 t = 0;
+    for (u32 Q = M; Q > 1; Q >>= 1)
+      if (X[2] & Q) t ^= Q - 1;
+    for (int i = 0; i != 3; ++i) X[i] ^= t;
+    // the transposed index, X[0] holds the most significant bit of each triple
+    return morton_3d_index_64(X[0], X[1], X[2]);
+  }
   template <typename T> constexpr auto morton_3d(T x, T y, T z) noexcept;
   template <> constexpr auto morton_3d<float>(float x, float y, float z) noexcept {
     return morton_3d_32(x, y, z);
@@ -266,6 +266,104 @@ namespace zs {
     return weights;
   }
 
+  /// @brief the (at most 2^dim) blocks touched by a stencil, kept across consecutive stencils
+  /// whose corners share the same block so that their hash lookups are skipped
+  template <typename IndexT, typename IntegerCoordT> struct StencilBlockCache {
+    static constexpr int dim = IntegerCoordT::extent;
+    static constexpr int num_blocks = 1 << dim;
+    IntegerCoordT origin{};
+    IndexT blocks[num_blocks]{};
+    u32 resolved{0};  // bit [c] is set once blocks[c] has been queried
+  };
+
+  namespace detail {
+    /// @brief gathers the width^dim nodes from [corner] on of a grid stored in SideLength^dim
+    /// blocks (power of two, last axis contiguous within a block) into [pad]
+    /// @note every touched block is resolved once through query(blockOrigin), the nodes along the
+    /// last axis are then read as rows of consecutive cells through fetch(blockno, cellno)
+    template <int SideLength, int width, typename PadT, typename VecT, typename CacheT,
+              typename QueryF, typename FetchF, typename IndexT, typename ValueT>
+    constexpr void gather_blocked_stencil(PadT &pad, const VecInterface<VecT> &corner,
+                                          CacheT &cache, QueryF &&query, FetchF &&fetch,
+                                          IndexT sentinel, ValueT defaultVal) noexcept {
+      constexpr int dim = VecT::extent;
+      constexpr int num_rows = math::pow_integral(width, dim - 1);
+      static_assert(width <= SideLength, "a stencil should span at most two blocks per axis");
+      static_assert((SideLength & (SideLength - 1)) == 0, "side length should be a power of 2");
+      int local[dim];
+      bool cross[dim];
+      auto origin = cache.origin;
+      bool sameOrigin = cache.resolved != 0;
+      for (int d = 0; d != dim; ++d) {
+        local[d] = (int)(corner[d] & (SideLength - 1));
+        cross[d] = local[d] + width > SideLength;
+        const auto o = corner[d] - local[d];
+        if (o != origin[d]) sameOrigin = false;
+        origin[d] = o;
+      }
+      if (!sameOrigin) {
+        cache.origin = origin;
+        cache.resolved = 0;
+      }
+      for (int c = 0; c != CacheT::num_blocks; ++c) {
+        bool required = true;
+        auto blockOrigin = origin;
+        for (int d = 0; d != dim; ++d)
+          if (c & (1 << (dim - 1 - d))) {
+            required = required && cross[d];
+            blockOrigin[d] += SideLength;
+          }
+        if (required && !(cache.resolved & (1u << c))) {
+          cache.blocks[c] = query(blockOrigin);
+          cache.resolved |= 1u << c;
+        }
+      }
+      const int l = local[dim - 1];
+      const int n0 = SideLength - l < width ? SideLength - l : width;
+      for (int r = 0; r != num_rows; ++r) {
+        int c = 0, cellBase = 0;
+        for (int d = 0, stride = num_rows / width; d != dim - 1; ++d, stride /= width) {
+          const int ld = local[d] + r / stride % width;
+          c = (c << 1) | (ld >= SideLength ? 1 : 0);
+          cellBase = cellBase * SideLength + (ld & (SideLength - 1));
+        }
+        cellBase = cellBase * SideLength + l;
+        if (const auto bno = cache.blocks[c << 1]; bno == sentinel)
+          for (int k = 0; k != n0; ++k) pad.val(r * width + k) = defaultVal;
+        else
+          for (int k = 0; k != n0; ++k) pad.val(r * width + k) = fetch(bno, cellBase + k);
+        if (n0 != width) {
+          if (const auto bno = cache.blocks[(c << 1) | 1]; bno == sentinel)
+            for (int k = n0; k != width; ++k) pad.val(r * width + k) = defaultVal;
+          else
+            for (int k = n0; k != width; ++k)
+              pad.val(r * width + k) = fetch(bno, cellBase + k - SideLength);
+        }
+      }
+    }
+
+    /// @brief sum over the stencil of prod_d w(d, loc[d]) * pad(loc), contracted one axis at a
+    /// time from the last one on, i.e. width^dim + width^(dim-1) + ... + width multiply-adds
+    template <int dim, int width, typename TWM, typename PadT>
+    constexpr auto contract_stencil(const TWM &w, const PadT &pad) noexcept {
+      using T = typename PadT::value_type;
+      constexpr int num_rows = math::pow_integral(width, dim - 1);
+      T buf[num_rows];
+      for (int r = 0; r != num_rows; ++r) {
+        T sum = 0;
+        for (int k = 0; k != width; ++k) sum += w(dim - 1, k) * pad.val(r * width + k);
+        buf[r] = sum;
+      }
+      for (int d = dim - 2, n = num_rows / width; d >= 0; --d, n /= width)
+        for (int r = 0; r != n; ++r) {
+          T sum = 0;
+          for (int k = 0; k != width; ++k) sum += w(d, k) * buf[r * width + k];
+          buf[r] = sum;
+        }
+      return buf[0];
+    }
+  }  // namespace detail
+
   template <typename T> struct is_grid_accessor : false_type {};
 
   template <typename GridViewT, kernel_e kt_ = kernel_e::linear, int drv_order = 0>
@@ -315,6 +413,20 @@ namespace zs {
     }
     template <typename ValT> using arena_type = RM_CVREF_T(deduce_arena_type<ValT, dim>());
 
+    /// SparseGrid stencils are gathered block-wise (detail::gather_blocked_stencil)
+    static constexpr bool deduce_blocked_storage() noexcept {
+      if constexpr (is_grid_accessor<remove_cvref_t<grid_view_type>>::value)
+        return false;
+      else if constexpr (is_spg_v<typename grid_view_type::container_type>)
+        return grid_view_type::side_length >= width;
+      else
+        return false;
+    }
+    static constexpr bool is_blocked_storage = deduce_blocked_storage();
+    using block_cache_type = conditional_t<
+        is_blocked_storage,
+        StencilBlockCache<typename grid_view_type::index_type, integer_coord_type>, void>;
+
     /// constructors
     /// index-space ctors
     // collocated grid
@@ -381,22 +493,41 @@ namespace zs {
     constexpr arena_type<value_type> arena(size_type chn,
                                            value_type defaultVal = {}) const noexcept {
       // ensure that chn's orientation is aligned with initialization if within a staggered grid
-      arena_type<value_type> pad{};
-      for (auto offset : ndrange<dim>(width)) {
-        if constexpr (is_grid_accessor<remove_cvref_t<grid_view_type>>::value) {
-          value_type val{};
-          bool found = const_cast<remove_cvref_t<grid_view_type> *>(gridPtr)->probeValue(
-              chn, iCorner + make_vec<integer_coord_component_type>(offset), val);
-          // if (!found) val = defaultVal;
-          pad.val(offset) = val;
-        } else if constexpr (is_ag_v<typename grid_view_type::container_type>) {
-          pad.val(offset) = gridPtr->value(
-              false_c, chn, iCorner + make_vec<integer_coord_component_type>(offset));
-        } else {
-          pad.val(offset) = gridPtr->valueOr(
-              false_c, chn, iCorner + make_vec<integer_coord_component_type>(offset), defaultVal);
+      if constexpr (is_blocked_storage) {
+        block_cache_type cache{};
+        return arena(chn, cache, defaultVal);
+      } else {
+        arena_type<value_type> pad{};
+        for (auto offset : ndrange<dim>(width)) {
+          if constexpr (is_grid_accessor<remove_cvref_t<grid_view_type>>::value) {
+            value_type val{};
+            bool found = const_cast<remove_cvref_t<grid_view_type> *>(gridPtr)->probeValue(
+                chn, iCorner + make_vec<integer_coord_component_type>(offset), val);
+            // if (!found) val = defaultVal;
+            pad.val(offset) = val;
+          } else if constexpr (is_ag_v<typename grid_view_type::container_type>) {
+            pad.val(offset) = gridPtr->value(
+                false_c, chn, iCorner + make_vec<integer_coord_component_type>(offset));
+          } else {
+            pad.val(offset) = gridPtr->valueOr(
+                false_c, chn, iCorner + make_vec<integer_coord_component_type>(offset), defaultVal);
+          }
         }
+        return pad;
       }
+    }
+    /// @note blocks already resolved in [cache] for the same corner block are reused, the ones
+    /// queried here are recorded for the next stencil
+    template <typename CacheT = block_cache_type, bool V = is_blocked_storage, enable_if_t<V> = 0>
+    constexpr arena_type<value_type> arena(size_type chn, CacheT &cache,
+                                           value_type defaultVal = {}) const noexcept {
+      arena_type<value_type> pad{};
+      const auto gv = gridPtr;
+      detail::gather_blocked_stencil<grid_view_type::side_length, width>(
+          pad, iCorner, cache,
+          [gv](const integer_coord_type &blockOrigin) { return gv->_table.query(blockOrigin); },
+          [gv, chn](auto bno, int cno) { return gv->_grid(chn, bno, cno); },
+          grid_view_type::sentinel_v, defaultVal);
       return pad;
     }
     constexpr arena_type<value_type> arena(const SmallString &propName, size_type chn = 0,
@@ -450,11 +581,17 @@ namespace zs {
       auto pad = arena(chn, defaultVal);
       if constexpr (kt == kernel_e::linear)
         return xlerp(iLocalPos, pad);
-      else {
-        value_type ret = 0;
-        for (auto offset : ndrange<dim>(width)) ret += weight(offset) * pad.val(offset);
-        return ret;
-      }
+      else
+        return detail::contract_stencil<dim, width>(get<0>(weights), pad);
+    }
+    template <typename CacheT = block_cache_type, bool V = is_blocked_storage, enable_if_t<V> = 0>
+    constexpr value_type isample(size_type chn, CacheT &cache,
+                                 value_type defaultVal = {}) const noexcept {
+      auto pad = arena(chn, cache, defaultVal);
+      if constexpr (kt == kernel_e::linear)
+        return xlerp(iLocalPos, pad);
+      else
+        return detail::contract_stencil<dim, width>(get<0>(weights), pad);
     }
     constexpr value_type isample(const SmallString &propName, size_type chn,
                                  value_type defaultVal = {}) const noexcept {
@@ -0,0 +1,117 @@
+#pragma once
+#include "SVD.hpp"
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+namespace zs {
+
+  namespace detail {
+    template <typename TileVectorT>
+    auto check_batched_svd_property(const TileVectorT &tv, const SmallString &tag, int size,
+                                    const char *fn) {
+      if (!tv.hasProperty(tag))
+        throw std::runtime_error(
+            fmt::format("[{}] property \"{}\" does not exist", fn, tag.asChars()));
+      if (tv.getPropertySize(tag) != size)
+        throw std::runtime_error(fmt::format("[{}] property \"{}\" should have {} channels", fn,
+                                             tag.asChars(), size));
+      return tv.getPropertyOffset(tag);
+    }
+  }  // namespace detail
+
+  /// @brief F = U diag(S) V^T for every 3x3 matrix stored in property [srcTag] of [tv]
+  /// @note on host each tile is processed as a whole by math::svd_3d_lanes (one matrix per lane),
+  /// results are bitwise identical to math::svd of the individual matrices.
+  template <typename ExecPol, typename T, size_t Length, typename Allocator>
+  void batched_svd(ExecPol &&pol, TileVector<T, Length, Allocator> &tv, const SmallString &srcTag,
+                   const SmallString &uTag, const SmallString &sTag, const SmallString &vTag) {
+    static_assert(is_same_v<T, float>, "batched svd currently only supports float");
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = typename TileVector<T, Length, Allocator>::size_type;
+    constexpr size_type lane_width = Length;
+
+    if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+      throw std::runtime_error(
+          "[batched_svd] current memory location not compatible with the execution policy");
+    const auto srcOffset = detail::check_batched_svd_property(tv, srcTag, 9, "batched_svd");
+    const auto uOffset = detail::check_batched_svd_property(tv, uTag, 9, "batched_svd");
+    const auto sOffset = detail::check_batched_svd_property(tv, sTag, 3, "batched_svd");
+    const auto vOffset = detail::check_batched_svd_property(tv, vTag, 9, "batched_svd");
+
+    const size_type n = tv.size();
+    if (n == 0) return;
+    if constexpr (is_host_execution<space>()) {
+      pol(range(tv.numTiles()), [tv = view<space>(tv), n, srcOffset, uOffset, sOffset,
+                                 vOffset](size_type tileNo) mutable {
+        const size_type base = tileNo * lane_width;
+        const size_type cnt = n - base < lane_width ? n - base : lane_width;
+        const T *a[9];
+        T *u[9], *s[3], *v[9];
+        for (int d = 0; d != 9; ++d) {
+          a[d] = &tv(srcOffset + d, base);
+          u[d] = &tv(uOffset + d, base);
+          v[d] = &tv(vOffset + d, base);
+        }
+        for (int d = 0; d != 3; ++d) s[d] = &tv(sOffset + d, base);
+        math::svd_3d_lanes(cnt, a, u, s, v);
+      });
+    } else {
+      pol(range(n), [tv = view<space>(tv), srcOffset, uOffset, sOffset,
+                     vOffset] ZS_LAMBDA(size_type i) mutable {
+        auto [U, S, V] = math::svd(tv.pack(dim_c<3, 3>, srcOffset, i));
+        tv.tuple(dim_c<3, 3>, uOffset, i) = U;
+        tv.tuple(dim_c<3>, sOffset, i) = S;
+        tv.tuple(dim_c<3, 3>, vOffset, i) = V;
+      });
+    }
+  }
+
+  /// @brief F = R S (R rotation, S symmetric) for every 3x3 matrix stored in property [srcTag]
+  /// of [tv], computed from the same svd as batched_svd
+  template <typename ExecPol, typename T, size_t Length, typename Allocator>
+  void batched_polar_decomposition(ExecPol &&pol, TileVector<T, Length, Allocator> &tv,
+                                   const SmallString &srcTag, const SmallString &rTag,
+                                   const SmallString &sTag) {
+    static_assert(is_same_v<T, float>, "batched polar decomposition currently only supports float");
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    using size_type = typename TileVector<T, Length, Allocator>::size_type;
+    constexpr size_type lane_width = Length;
+
+    if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+      throw std::runtime_error(
+          "[batched_polar_decomposition] current memory location not compatible with the "
+          "execution policy");
+    const auto srcOffset
+        = detail::check_batched_svd_property(tv, srcTag, 9, "batched_polar_decomposition");
+    const auto rOffset
+        = detail::check_batched_svd_property(tv, rTag, 9, "batched_polar_decomposition");
+    const auto sOffset
+        = detail::check_batched_svd_property(tv, sTag, 9, "batched_polar_decomposition");
+
+    const size_type n = tv.size();
+    if (n == 0) return;
+    if constexpr (is_host_execution<space>()) {
+      pol(range(tv.numTiles()),
+          [tv = view<space>(tv), n, srcOffset, rOffset, sOffset](size_type tileNo) mutable {
+            const size_type base = tileNo * lane_width;
+            const size_type cnt = n - base < lane_width ? n - base : lane_width;
+            const T *a[9];
+            T *r[9], *sym[9];
+            for (int d = 0; d != 9; ++d) {
+              a[d] = &tv(srcOffset + d, base);
+              r[d] = &tv(rOffset + d, base);
+              sym[d] = &tv(sOffset + d, base);
+            }
+            math::polar_3d_lanes(cnt, a, r, sym);
+          });
+    } else {
+      pol(range(n),
+          [tv = view<space>(tv), srcOffset, rOffset, sOffset] ZS_LAMBDA(size_type i) mutable {
+            auto [U, S, V] = math::svd(tv.pack(dim_c<3, 3>, srcOffset, i));
+            tv.tuple(dim_c<3, 3>, rOffset, i) = U * V.transpose();
+            tv.tuple(dim_c<3, 3>, sOffset, i) = diag_mul(V, S) * V.transpose();
+          });
+    }
+  }
+
+}  // namespace zs
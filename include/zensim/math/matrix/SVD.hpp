@@ -96,6 +96,9 @@ namespace zs {
       //###########################################################
       // Solve symmetric eigenproblem using Jacobi iteration
       //###########################################################
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC unroll 4
+#endif
       for (int i = 0; i < 4; i++) {
         Ssh.f = Ss21.f * 0.5f;
         Stmp5.f = (Ss11.f - Ss22.f);
@@ -691,8 +694,12 @@ namespace zs {
 
       Stmp5.f = 0.f;
       Sch.f = (Stmp5.f - Sa11.f);
-      Sch.f = math::max(Sch.f, Sa11.f);
-      Sch.f = math::max(Sch.f, gsmall_number);
+      // max(|a11|, small) as masked selects, keeps the lane loops free of branches
+      Stmp1.ui = (Sa11.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Sa11.ui) | (~Stmp1.ui & Sch.ui);
+      Stmp2.f = gsmall_number;
+      Stmp1.ui = (Stmp2.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Stmp2.ui) | (~Stmp1.ui & Sch.ui);
       Stmp5.ui = (Sa11.f >= Stmp5.f) ? 0xffffffff : 0;
 
       Stmp1.f = Sch.f * Sch.f;
@@ -796,8 +803,11 @@ namespace zs {
 
       Stmp5.f = 0.f;
       Sch.f = (Stmp5.f - Sa11.f);
-      Sch.f = math::max(Sch.f, Sa11.f);
-      Sch.f = math::max(Sch.f, gsmall_number);
+      Stmp1.ui = (Sa11.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Sa11.ui) | (~Stmp1.ui & Sch.ui);
+      Stmp2.f = gsmall_number;
+      Stmp1.ui = (Stmp2.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Stmp2.ui) | (~Stmp1.ui & Sch.ui);
       Stmp5.ui = (Sa11.f >= Stmp5.f) ? 0xffffffff : 0;
 
       Stmp1.f = Sch.f * Sch.f;
@@ -901,8 +911,11 @@ namespace zs {
 
       Stmp5.f = 0.f;
       Sch.f = (Stmp5.f - Sa22.f);
-      Sch.f = math::max(Sch.f, Sa22.f);
-      Sch.f = math::max(Sch.f, gsmall_number);
+      Stmp1.ui = (Sa22.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Sa22.ui) | (~Stmp1.ui & Sch.ui);
+      Stmp2.f = gsmall_number;
+      Stmp1.ui = (Stmp2.f > Sch.f) ? 0xffffffff : 0;
+      Sch.ui = (Stmp1.ui & Stmp2.ui) | (~Stmp1.ui & Sch.ui);
       Stmp5.ui = (Sa22.f >= Stmp5.f) ? 0xffffffff : 0;
 
       Stmp1.f = Sch.f * Sch.f;
@@ -1025,6 +1038,51 @@ namespace zs {
       s33 = Sa33.f;
     }
 
+    /// @brief svd_3d of [n] matrices stored as structure-of-arrays
+    /// @note entry (r, c) of the i-th matrix is a[r * 3 + c][i], U and V follow the same layout and
+    /// s holds the singular values. svd_3d is branch-free, hence the loop is vectorized across
+    /// matrices (one per lane) and each lane executes exactly the scalar instruction sequence.
+    /// The sqrt calls are only vectorized by gcc/clang when compiled with -fno-math-errno, without
+    /// it the lanes run one after another at about the speed of math::svd.
+    template <typename T, typename Ti>
+    [[gnu::flatten]] inline void svd_3d_lanes(Ti n, const T* const a[9], T* const u[9],
+                                              T* const s[3], T* const v[9]) noexcept {
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+      for (Ti i = 0; i < n; ++i)
+        svd_3d(a[0][i], a[1][i], a[2][i], a[3][i], a[4][i], a[5][i], a[6][i], a[7][i], a[8][i],
+               u[0][i], u[1][i], u[2][i], u[3][i], u[4][i], u[5][i], u[6][i], u[7][i], u[8][i],
+               s[0][i], s[1][i], s[2][i], v[0][i], v[1][i], v[2][i], v[3][i], v[4][i], v[5][i],
+               v[6][i], v[7][i], v[8][i]);
+    }
+
+    /// @brief polar decomposition A = R S (R = U V^T, S = V diag(s) V^T) of [n] matrices stored
+    /// as structure-of-arrays, laid out as in svd_3d_lanes
+    template <typename T, typename Ti>
+    [[gnu::flatten]] inline void polar_3d_lanes(Ti n, const T* const a[9], T* const r[9],
+                                                T* const sym[9]) noexcept {
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+      for (Ti i = 0; i < n; ++i) {
+        T U[9], S[3], V[9];
+        svd_3d(a[0][i], a[1][i], a[2][i], a[3][i], a[4][i], a[5][i], a[6][i], a[7][i], a[8][i],
+               U[0], U[1], U[2], U[3], U[4], U[5], U[6], U[7], U[8], S[0], S[1], S[2], V[0], V[1],
+               V[2], V[3], V[4], V[5], V[6], V[7], V[8]);
+        for (int row = 0; row != 3; ++row)
+          for (int col = 0; col != 3; ++col) {
+            T rr = 0, ss = 0;
+            for (int k = 0; k != 3; ++k) {
+              rr += U[row * 3 + k] * V[col * 3 + k];
+              ss += V[row * 3 + k] * S[k] * V[col * 3 + k];
+            }
+            r[row * 3 + col][i] = rr;
+            sym[row * 3 + col][i] = ss;
+          }
+      }
+    }
+
     template <typename VecT,
               enable_if_all<VecT::dim == 2, VecT::template range_t<0>::value <= 3,
                             VecT::template range_t<0>::value == VecT::template range_t<1>::value,
@@ -8,6 +8,11 @@
 #if defined(ZS_PLATFORM_UNIX)
 #  include <sys/mman.h>
 #  include <unistd.h>
+#  if defined(ZS_PLATFORM_LINUX)
+#    include <sys/syscall.h>
+
+#    include <cstdio>
+#  endif
 #elif defined(ZS_PLATFORM_WINDOWS)
 #  define NOMINMAX
 #  define WIN32_LEAN_AND_MEAN
@@ -220,7 +225,8 @@ namespace zs {
     return true;
   }
 
-  bool stack_virtual_memory_resource<host_mem_tag>::do_evict(size_t offset, size_t bytes) {
+  bool stack_virtual_memory_resource<host_mem_tag>::do_evict(size_t offset,
+                                                             [[maybe_unused]] size_t bytes) {
     ZS_WARN_IF(round_down(offset + bytes, s_chunk_granularity) < _allocatedSpace,
                "will evict more bytes (till the end) than asking");
     size_t st = round_up(offset, s_chunk_granularity);
@@ -239,12 +245,118 @@ namespace zs {
     return true;
   }
 
-  void *stack_virtual_memory_resource<host_mem_tag>::do_allocate(size_t bytes, size_t alignment) {
+  void *stack_virtual_memory_resource<host_mem_tag>::do_allocate(
+      [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) {
     return nullptr;
   }
 
-  void stack_virtual_memory_resource<host_mem_tag>::do_deallocate(void *ptr, size_t bytes,
-                                                                  size_t alignment) {}
+  void stack_virtual_memory_resource<host_mem_tag>::do_deallocate(
+      [[maybe_unused]] void *ptr, [[maybe_unused]] size_t bytes,
+      [[maybe_unused]] size_t alignment) {}
+
+  /// page_memory_resource
+#if defined(ZS_PLATFORM_LINUX)
+  namespace {
+    // <numaif.h> (libnuma) is not required for these
+    constexpr int s_mpol_bind = 2;
+    constexpr int s_mpol_interleave = 3;
+
+    /// parse "/sys/devices/system/node/online", e.g. "0-1,3"
+    u64 online_numa_nodes() {
+      u64 mask = 0;
+      if (FILE *f = std::fopen("/sys/devices/system/node/online", "r")) {
+        int st = 0, ed = 0;
+        char sep = 0;
+        while (std::fscanf(f, "%d", &st) == 1) {
+          ed = st;
+          if (std::fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (std::fscanf(f, "%d", &ed) != 1) break;
+            if (std::fscanf(f, "%c", &sep) != 1) sep = 0;
+          }
+          for (int n = st; n <= ed && n < 64; ++n) mask |= (u64)1 << n;
+          if (sep != ',') break;
+        }
+        std::fclose(f);
+      }
+      return mask ? mask : (u64)1;
+    }
+    bool bind_pages(void *addr, size_t bytes, int mode, u64 nodeMask) {
+      // the kernel reads [maxnode - 1] bits
+      return syscall(SYS_mbind, addr, bytes, mode, &nodeMask, sizeof(u64) * 8 + 1, 0) == 0;
+    }
+  }  // namespace
+#endif
+
+  page_memory_resource<host_mem_tag>::page_memory_resource(ProcID did, std::string_view option)
+      : _did{did} {
+    for (size_t st = 0; st < option.size();) {
+      auto ed = option.find('|', st);
+      if (ed == std::string_view::npos) ed = option.size();
+      const auto opt = option.substr(st, ed - st);
+      if (opt == "HUGE_PAGE")
+        _transparentHugePage = true;
+      else if (opt == "EXPLICIT_HUGE_PAGE")
+        _explicitHugePage = _transparentHugePage = true;
+      else if (opt == "INTERLEAVE")
+        _interleave = true;
+      else if (!opt.empty())
+        throw std::runtime_error(fmt::format("unknown page memory resource option [{}]", opt));
+      st = ed + 1;
+    }
+#if defined(ZS_PLATFORM_LINUX)
+    _nodeMask = online_numa_nodes();
+    if (did >= 64 || (did >= 0 && (_nodeMask & ((u64)1 << did)) == 0))
+      throw std::runtime_error(fmt::format("numa node [{}] is not online", (int)did));
+#endif
+  }
+
+  void *page_memory_resource<host_mem_tag>::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) return nullptr;
+#if defined(ZS_PLATFORM_LINUX)
+    if (bytes >= s_page_threshold && alignment <= s_page_threshold) {
+      const size_t numBytes = round_up(bytes, s_page_threshold);
+      void *ret = MAP_FAILED;
+      if (_explicitHugePage)
+        ret = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE,
+                   MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+      if (ret == MAP_FAILED) {
+        // over-reserve so that the range can be trimmed to a 2MB boundary, which allows the
+        // kernel to back it with transparent huge pages
+        char *addr = (char *)mmap(nullptr, numBytes + s_page_threshold, PROT_READ | PROT_WRITE,
+                                  MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (addr == MAP_FAILED) throw std::bad_alloc{};
+        char *st = (char *)round_up((size_t)addr, s_page_threshold);
+        if (st != addr) munmap(addr, st - addr);
+        if (auto tail = (addr + numBytes + s_page_threshold) - (st + numBytes); tail)
+          munmap(st + numBytes, tail);
+        ret = st;
+        if (_transparentHugePage) madvise(ret, numBytes, MADV_HUGEPAGE);
+      }
+      // placement is a hint, pages stay on the default policy if the binding fails
+      if (_did >= 0)
+        bind_pages(ret, numBytes, s_mpol_bind, (u64)1 << _did);
+      else if (_interleave)
+        bind_pages(ret, numBytes, s_mpol_interleave, _nodeMask);
+      return ret;
+    }
+#endif
+    // small allocations share pages with others, hence are not placed
+    auto ret = zs::allocate(mem_host, bytes, alignment);
+    if (ret == nullptr) throw std::bad_alloc{};
+    return ret;
+  }
+
+  void page_memory_resource<host_mem_tag>::do_deallocate(void *ptr, size_t bytes,
+                                                         size_t alignment) {
+    if (bytes == 0) return;
+#if defined(ZS_PLATFORM_LINUX)
+    if (bytes >= s_page_threshold && alignment <= s_page_threshold) {
+      munmap(ptr, round_up(bytes, s_page_threshold));
+      return;
+    }
+#endif
+    zs::deallocate(mem_host, ptr, bytes, alignment);
+  }
 
   /// handle_resource
   handle_resource::handle_resource(mr_t *upstream) noexcept : _upstream{upstream} {}
@@ -281,7 +393,8 @@ namespace zs {
     _head = ret + bytes;
     return ret;
   }
-  void handle_resource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+  void handle_resource::do_deallocate(void *p, [[maybe_unused]] size_t bytes,
+                                      [[maybe_unused]] size_t alignment) {
     if (p >= _head)
       throw std::bad_alloc{};
     else if (p < _handle)
@@ -125,6 +125,49 @@ namespace zs {
 
   extern template struct ZPC_CORE_TEMPLATE_IMPORT advisor_memory_resource<host_mem_tag>;
 
+  /// @brief host memory with page-level control over backing and numa placement
+  /// @note [option] is a '|'-separated combination of
+  /// "HUGE_PAGE" (transparent huge pages), "EXPLICIT_HUGE_PAGE" (reserved 2MB pages, falls back
+  /// to transparent ones), "INTERLEAVE" (pages interleaved across all numa nodes). A
+  /// non-negative [did] binds the pages to that numa node instead.
+  /// @note pages are left untouched, see first_touch() for placement by the executing threads
+  template <typename MemTag> struct page_memory_resource : mr_t {
+    template <typename... Args> page_memory_resource(Args...) {
+      throw std::runtime_error("page memory resource is only available for host memory!");
+    }
+    void *do_allocate(size_t, size_t) override { return nullptr; }
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
+  };
+
+  template <> struct page_memory_resource<host_mem_tag> : mr_t {
+    /// allocations of at least this size are mapped directly at 2MB granularity
+    static constexpr size_t s_page_threshold = vmr_t::s_chunk_granularity;
+
+    ZPC_CORE_API page_memory_resource(ProcID did = -1, std::string_view option = "HUGE_PAGE");
+    /// whether [option] only combines the options above
+    static constexpr bool is_option(std::string_view option) noexcept {
+      for (size_t st = 0; st < option.size();) {
+        auto ed = option.find('|', st);
+        if (ed == std::string_view::npos) ed = option.size();
+        const auto opt = option.substr(st, ed - st);
+        if (!opt.empty() && opt != "HUGE_PAGE" && opt != "EXPLICIT_HUGE_PAGE"
+            && opt != "INTERLEAVE")
+          return false;
+        st = ed + 1;
+      }
+      return true;
+    }
+    ~page_memory_resource() = default;
+    ZPC_CORE_API void *do_allocate(size_t bytes, size_t alignment) override;
+    ZPC_CORE_API void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const mr_t &other) const noexcept override { return this == &other; }
+
+    u64 _nodeMask{0};
+    bool _transparentHugePage{false}, _explicitHugePage{false}, _interleave{false};
+    ProcID _did;
+  };
+
   template <typename MemTag> struct stack_virtual_memory_resource
       : vmr_t {  // default impl falls back to
     template <typename... Args> stack_virtual_memory_resource(Args...) {
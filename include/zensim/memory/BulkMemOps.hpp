@@ -0,0 +1,108 @@
+#pragma once
+#include <cstring>
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/types/Iterator.h"
+
+namespace zs {
+
+  namespace detail {
+    /// transfers below this size are not worth splitting
+    constexpr size_t bulk_parallel_bytes = (size_t)1 << 22;
+    /// bytes moved per task, a multiple of the page size
+    constexpr size_t bulk_chunk_bytes = (size_t)1 << 20;
+    /// destinations larger than this (roughly the last level cache) bypass the cache
+    constexpr size_t bulk_streaming_bytes = (size_t)1 << 25;
+
+#if defined(__SSE2__)
+    /// 16-byte aligned part bypasses the cache, the unaligned head and tail are stored normally
+    inline void stream_copy_bytes(void *dst, const void *src, size_t bytes) {
+      auto d = (char *)dst;
+      auto s = (const char *)src;
+      size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+      if (head > bytes) head = bytes;
+      std::memcpy(d, s, head);
+      size_t k = head;
+      // a whole cache line per iteration keeps the write-combining buffers full
+      for (; k + 64 <= bytes; k += 64) {
+        const __m128i v0 = _mm_loadu_si128((const __m128i *)(s + k));
+        const __m128i v1 = _mm_loadu_si128((const __m128i *)(s + k + 16));
+        const __m128i v2 = _mm_loadu_si128((const __m128i *)(s + k + 32));
+        const __m128i v3 = _mm_loadu_si128((const __m128i *)(s + k + 48));
+        _mm_stream_si128((__m128i *)(d + k), v0);
+        _mm_stream_si128((__m128i *)(d + k + 16), v1);
+        _mm_stream_si128((__m128i *)(d + k + 32), v2);
+        _mm_stream_si128((__m128i *)(d + k + 48), v3);
+      }
+      for (; k + 16 <= bytes; k += 16)
+        _mm_stream_si128((__m128i *)(d + k), _mm_loadu_si128((const __m128i *)(s + k)));
+      std::memcpy(d + k, s + k, bytes - k);
+    }
+    inline void stream_fill_bytes(void *dst, int ch, size_t bytes) {
+      auto d = (char *)dst;
+      size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+      if (head > bytes) head = bytes;
+      std::memset(d, ch, head);
+      const __m128i v = _mm_set1_epi8((char)ch);
+      size_t k = head;
+      for (; k + 16 <= bytes; k += 16) _mm_stream_si128((__m128i *)(d + k), v);
+      std::memset(d + k, ch, bytes - k);
+    }
+#endif
+  }  // namespace detail
+
+  /// @brief memcpy split across the threads of a host policy
+  /// @note destinations larger than the last level cache are written with non-temporal stores
+  template <typename ExecPol>
+  void bulk_copy(ExecPol &&pol, void *dst, const void *src, size_t bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_host_execution<space>(), "bulk copy requires a host execution policy");
+    if (bytes < detail::bulk_parallel_bytes) {
+      std::memcpy(dst, src, bytes);
+      return;
+    }
+    const size_t numChunks = (bytes + detail::bulk_chunk_bytes - 1) / detail::bulk_chunk_bytes;
+    const bool stream = bytes >= detail::bulk_streaming_bytes;
+    pol(range(numChunks), [d = (char *)dst, s = (const char *)src, bytes, stream](size_t i) {
+      const size_t st = i * detail::bulk_chunk_bytes;
+      const size_t cnt
+          = bytes - st < detail::bulk_chunk_bytes ? bytes - st : detail::bulk_chunk_bytes;
+#if defined(__SSE2__)
+      if (stream) {
+        detail::stream_copy_bytes(d + st, s + st, cnt);
+        _mm_sfence();
+        return;
+      }
+#endif
+      std::memcpy(d + st, s + st, cnt);
+    });
+  }
+  /// @brief memset split across the threads of a host policy
+  template <typename ExecPol> void bulk_memset(ExecPol &&pol, void *dst, int ch, size_t bytes) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_host_execution<space>(), "bulk memset requires a host execution policy");
+    if (bytes < detail::bulk_parallel_bytes) {
+      std::memset(dst, ch, bytes);
+      return;
+    }
+    const size_t numChunks = (bytes + detail::bulk_chunk_bytes - 1) / detail::bulk_chunk_bytes;
+    const bool stream = bytes >= detail::bulk_streaming_bytes;
+    pol(range(numChunks), [d = (char *)dst, ch, bytes, stream](size_t i) {
+      const size_t st = i * detail::bulk_chunk_bytes;
+      const size_t cnt
+          = bytes - st < detail::bulk_chunk_bytes ? bytes - st : detail::bulk_chunk_bytes;
+#if defined(__SSE2__)
+      if (stream) {
+        detail::stream_fill_bytes(d + st, ch, cnt);
+        _mm_sfence();
+        return;
+      }
+#endif
+      std::memset(d + st, ch, cnt);
+    });
+  }
+
+}  // namespace zs
@@ -0,0 +1,57 @@
+#pragma once
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/resource/Resource.h"
+#include "zensim/types/Iterator.h"
+
+namespace zs {
+
+  /// @brief place the pages of [ptr, ptr + bytes) on the numa nodes of the threads of [pol]
+  /// @note pages are distributed the same way as pol(range(n), ...) distributes n elements, so
+  /// later kernels over the same range mostly access local memory. Only pages not yet touched
+  /// (e.g. freshly allocated from page_memory_resource) are placed, contents are preserved.
+  template <typename ExecPol> void first_touch(ExecPol &&pol, void *ptr, size_t bytes,
+                                               size_t pageBytes = 4096) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_host_execution<space>(), "first touch requires a host execution policy");
+    if (bytes == 0) return;
+    const auto base = (size_t)ptr;
+    const auto st = base / pageBytes, ed = (base + bytes - 1) / pageBytes + 1;
+    pol(range(ed - st), [base, bytes, st, pageBytes](size_t i) {
+      // an untouched page is only allocated upon the write
+      auto addr = (st + i) * pageBytes;
+      if (addr < base) addr = base;
+      if (addr >= base + bytes) return;
+      volatile char *p = (volatile char *)addr;
+      *p = *p;
+    });
+  }
+  /// @brief place the (reserved) storage of a Vector or TileVector
+  /// @note storage mapped with huge pages by page_memory_resource is placed page by page (2MB)
+  template <typename ExecPol, typename ContainerT>
+  auto first_touch(ExecPol &&pol, ContainerT &c)
+      -> decltype(c.data(), c.capacity(), c.get_allocator(), void()) {
+    using page_resource_t = page_memory_resource<host_mem_tag>;
+    const auto allocator = c.get_allocator();
+    if (!valid_memspace_for_execution(pol, allocator))
+      throw std::runtime_error(
+          "[first_touch] current memory location not compatible with the execution policy");
+    void *ptr = nullptr;
+    size_t bytes = 0;
+    constexpr auto hasBuffer = is_valid([](auto &t) -> decltype((void)t.refBuffer()) {});
+    if constexpr (decltype(hasBuffer(c))::value) {
+      auto &buffer = c.refBuffer();
+      ptr = (void *)buffer.data();
+      bytes = buffer.capacity() * sizeof(*buffer.data());
+    } else {
+      ptr = (void *)c.data();
+      bytes = c.capacity() * sizeof(*c.data());
+    }
+    // a huge page is placed as a whole by its first touch, smaller allocations are not mapped
+    size_t pageBytes = 4096;
+    if (auto res = dynamic_cast<const page_resource_t *>(allocator.resource());
+        res && res->_transparentHugePage && bytes >= page_resource_t::s_page_threshold)
+      pageBytes = page_resource_t::s_page_threshold;
+    first_touch(FWD(pol), ptr, bytes, pageBytes);
+  }
+
+}  // namespace zs
@@ -1,15 +1,32 @@
 #include "MemOps.hpp"
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 
 namespace zs {
 
+  namespace {
+    std::atomic<host_copy_func> g_hostBulkCopy{nullptr};
+    std::atomic<host_memset_func> g_hostBulkMemset{nullptr};
+    std::atomic<size_t> g_hostBulkThreshold{~(size_t)0};
+  }  // namespace
+
+  void set_host_bulk_memops(host_copy_func copyFunc, host_memset_func memsetFunc,
+                            size_t threshold) {
+    g_hostBulkCopy.store(copyFunc, std::memory_order_relaxed);
+    g_hostBulkMemset.store(memsetFunc, std::memory_order_relaxed);
+    g_hostBulkThreshold.store(threshold, std::memory_order_release);
+  }
+
   void *allocate(host_mem_tag, size_t size, size_t alignment, const source_location &loc) {
     void *ret{nullptr};
 #ifdef _MSC_VER
     ret = _aligned_malloc(size, alignment);
 #else
-    // ret = std::aligned_alloc(alignment, size);
-    ret = std::malloc(size);
+    if (alignment <= alignof(std::max_align_t))
+      ret = std::malloc(size);
+    else  // size is required to be a multiple of alignment
+      ret = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
 #endif
 #if ZS_ENABLE_OFB_ACCESS_CHECK
     if (ret == nullptr) {
@@ -33,9 +50,19 @@ namespace zs {
 #endif
   }
   void memset(host_mem_tag, void *addr, int chval, size_t size, const source_location &loc) {
+    if (size >= g_hostBulkThreshold.load(std::memory_order_acquire))
+      if (auto f = g_hostBulkMemset.load(std::memory_order_relaxed)) {
+        f(addr, chval, size);
+        return;
+      }
     std::memset(addr, chval, size);
   }
   void copy(host_mem_tag, void *dst, void *src, size_t size, const source_location &loc) {
+    if (size >= g_hostBulkThreshold.load(std::memory_order_acquire))
+      if (auto f = g_hostBulkCopy.load(std::memory_order_relaxed)) {
+        f(dst, src, size);
+        return;
+      }
     std::memcpy(dst, src, size);
   }
 
@@ -16,6 +16,14 @@ namespace zs {
   ZPC_CORE_API void copy(host_mem_tag, void *dst, void *src, size_t size,
                          const source_location &loc = source_location::current());
 
+  /// @brief let a parallel host backend take over host copy/memset of at least [threshold] bytes
+  /// @note registered by the openmp backend, hence picked by Resource::copy/memset and all
+  /// Vector/TileVector paths relying on them
+  using host_copy_func = void (*)(void *dst, const void *src, size_t size);
+  using host_memset_func = void (*)(void *addr, int chval, size_t size);
+  ZPC_CORE_API void set_host_bulk_memops(host_copy_func copyFunc, host_memset_func memsetFunc,
+                                         size_t threshold);
+
 #if 0
   /// dispatch mem op calls
   void *allocate_dispatch(mem_tags tag, size_t size, size_t alignment);
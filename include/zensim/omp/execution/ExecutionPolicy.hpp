@@ -11,6 +11,8 @@
 #  error "ZS_ENABLE_OPENMP defined but the compiler is not defining the _OPENMP macro as expected"
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <thread>
 
 #include "zensim/ZpcFunction.hpp"
@@ -24,6 +26,170 @@ namespace zs {
   struct OmpExecutionPolicy;
   ZPC_API extern ZSPmrAllocator<> get_temporary_memory_source(const OmpExecutionPolicy &pol);
 
+  namespace detail {
+    /// 11-bit digits, the 16KB histogram of a thread still fits in L1
+    constexpr int radix_max_digit_bits = 11;
+    constexpr size_t segmented_insertion_sort_size = 16;
+
+    /// digits of a radix sort, only covering the bits in which the keys differ
+    struct radix_digits {
+      int num{0};
+      int st[64]{}, bits[64]{};
+    };
+    /// @note wide digits pay off once a thread has enough keys to amortize its histogram
+    template <typename UKeyT>
+    radix_digits plan_radix_digits(UKeyT varying, int sbit, int ebit, size_t keysPerThread) {
+      constexpr int numBits = sizeof(UKeyT) * 8;
+      radix_digits ret{};
+      if (sbit < 0) sbit = 0;
+      if (ebit > numBits) ebit = numBits;
+      if (sbit >= ebit) return ret;
+      if (ebit < numBits) varying &= ((UKeyT)1 << ebit) - 1;
+      varying &= ~(UKeyT)0 << sbit;
+      if (varying == 0) return ret;
+      int lo = 0, hi = numBits;
+      while (!((varying >> lo) & 1)) ++lo;
+      while (!((varying >> (hi - 1)) & 1)) --hi;
+      const int maxBits = keysPerThread >= ((size_t)1 << 14) ? radix_max_digit_bits : 8;
+      const int numPasses = (hi - lo + maxBits - 1) / maxBits;
+      const int digitBits = (hi - lo + numPasses - 1) / numPasses;
+      for (int st = lo; st < hi; st += digitBits) {
+        while (!((varying >> st) & 1)) ++st;  // constant bits need no pass
+        ret.st[ret.num] = st;
+        ret.bits[ret.num++] = digitBits < hi - st ? digitBits : hi - st;
+      }
+      return ret;
+    }
+
+    /// stable, [vals] may be null (key-only)
+    template <typename KeyIter, typename ValueIter, typename CompareOpT>
+    void insertion_sort_pair(KeyIter keys, ValueIter vals, size_t n, CompareOpT &compOp) {
+      for (size_t i = 1; i < n; ++i) {
+        auto key = zs::move(keys[i]);
+        size_t j = i;
+        if constexpr (is_pointer_v<ValueIter>) {
+          if (vals == nullptr) {
+            for (; j > 0 && compOp(key, keys[j - 1]); --j) keys[j] = zs::move(keys[j - 1]);
+            keys[j] = zs::move(key);
+            continue;
+          }
+        }
+        auto val = zs::move(vals[i]);
+        for (; j > 0 && compOp(key, keys[j - 1]); --j) {
+          keys[j] = zs::move(keys[j - 1]);
+          vals[j] = zs::move(vals[j - 1]);
+        }
+        keys[j] = zs::move(key);
+        vals[j] = zs::move(val);
+      }
+    }
+
+    /// single-threaded radix sort of one bucket by the bits [sbit, ebit), result stays in keys
+    template <typename UKeyT, typename ValueT, typename DiffT>
+    void radix_sort_seq(UKeyT *keys, UKeyT *tmpKeys, ValueT *vals, ValueT *tmpVals, DiffT n,
+                        int sbit, int ebit, DiffT *hist) {
+      constexpr bool hasValues = !is_same_v<ValueT, void>;
+      if ((size_t)n <= segmented_insertion_sort_size) {
+        const UKeyT rangeMask = (ebit < (int)sizeof(UKeyT) * 8 ? ((UKeyT)1 << ebit) - 1 : ~(UKeyT)0)
+                                & (~(UKeyT)0 << sbit);
+        auto compOp = [rangeMask](UKeyT a, UKeyT b) { return (a & rangeMask) < (b & rangeMask); };
+        if constexpr (hasValues)
+          insertion_sort_pair(keys, vals, (size_t)n, compOp);
+        else
+          insertion_sort_pair(keys, (int *)nullptr, (size_t)n, compOp);
+        return;
+      }
+      UKeyT orBits = 0, andBits = ~(UKeyT)0;
+      for (DiffT i = 0; i < n; ++i) {
+        orBits |= keys[i];
+        andBits &= keys[i];
+      }
+      const auto digits = plan_radix_digits((UKeyT)(orBits ^ andBits), sbit, ebit, (size_t)n);
+      UKeyT *cur = keys, *next = tmpKeys;
+      ValueT *curVals = vals, *nextVals = tmpVals;
+      for (int d = 0; d != digits.num; ++d) {
+        const int st = digits.st[d];
+        const int binCount = 1 << digits.bits[d];
+        const UKeyT binMask = (UKeyT)(binCount - 1);
+        for (int b = 0; b != binCount; ++b) hist[b] = 0;
+        for (DiffT i = 0; i < n; ++i) hist[(cur[i] >> st) & binMask]++;
+        DiffT offset = 0;
+        for (int b = 0; b != binCount; ++b) {
+          const DiffT cnt = hist[b];
+          hist[b] = offset;
+          offset += cnt;
+        }
+        for (DiffT i = 0; i < n; ++i) {
+          const DiffT loc = hist[(cur[i] >> st) & binMask]++;
+          next[loc] = cur[i];
+          if constexpr (hasValues) nextVals[loc] = curVals[i];
+        }
+        std::swap(cur, next);
+        std::swap(curVals, nextVals);
+      }
+      if (cur != keys) {
+        std::memcpy(keys, cur, sizeof(UKeyT) * n);
+        if constexpr (hasValues) std::memcpy((void *)vals, curVals, sizeof(ValueT) * n);
+      }
+    }
+
+    /// grow-only buffers of the sorts issued from the calling thread, this spares the allocation
+    /// and page faults of fresh double buffers on every call
+    struct omp_sort_scratch {
+      static constexpr size_t alignment = 64;
+
+      static omp_sort_scratch &instance() {
+        thread_local omp_sort_scratch s_scratch{};
+        return s_scratch;
+      }
+      static void release() { instance()._buffer = Vector<u8>{}; }
+
+      template <typename UKeyT, typename ValueT, typename DiffT>
+      static size_t bytes(size_t n, int nths) {
+        size_t ret = 2 * (n * sizeof(UKeyT) + alignment);
+        if constexpr (!is_same_v<ValueT, void>) ret += 2 * (n * sizeof(ValueT) + alignment);
+        // histograms, plus the bucket bounds of the msd pass
+        ret += (((size_t)nths + 2) << radix_max_digit_bits) * sizeof(DiffT) + alignment;
+        return ret;
+      }
+
+      /// a nested request while the buffer is taken gets its own allocation
+      struct lease {
+        lease(size_t bytes, const ZSPmrAllocator<> &allocator) {
+          auto &scratch = instance();
+          if (!scratch._inUse) {
+            if (scratch._buffer.size() < bytes)
+              scratch._buffer = Vector<u8>{allocator, bytes + bytes / 2};
+            scratch._inUse = true;
+            _owner = &scratch;
+            _ptr = scratch._buffer.data();
+          } else {
+            _own = Vector<u8>{allocator, bytes};
+            _ptr = _own.data();
+          }
+        }
+        ~lease() {
+          if (_owner) _owner->_inUse = false;
+        }
+        lease(const lease &) = delete;
+        lease &operator=(const lease &) = delete;
+
+        template <typename T> T *carve(size_t n) {
+          auto addr = ((uintptr_t)_ptr + alignment - 1) & ~(uintptr_t)(alignment - 1);
+          _ptr = (u8 *)(addr + n * sizeof(T));
+          return (T *)addr;
+        }
+
+        omp_sort_scratch *_owner{nullptr};
+        Vector<u8> _own{};
+        u8 *_ptr{nullptr};
+      };
+
+      Vector<u8> _buffer{};
+      bool _inUse{false};
+    };
+  }  // namespace detail
+
   /// use pragma syntax instead of attribute syntax
   struct OmpExecutionPolicy : ExecutionPolicyInterface<OmpExecutionPolicy> {
     using exec_tag = omp_exec_tag;
@@ -887,6 +1053,9 @@ namespace zs {
     }
 
     /// radix sort
+    /// @note only the digits in which the keys actually differ are processed. 64-bit keys
+    /// spanning more than 32 bits (e.g. morton codes) are first split by their leading digit,
+    /// the buckets are then sorted independently while they stay in cache.
     template <class InputIt, class OutputIt>
     void radix_sort_impl(std::random_access_iterator_tag, InputIt &&first, InputIt &&last,
                          OutputIt &&d_first, int sbit, int ebit, const source_location &loc) const {
@@ -895,6 +1064,7 @@ namespace zs {
       using DiffT = typename std::iterator_traits<IterT>::difference_type;
       using InputValueT = typename std::iterator_traits<IterT>::value_type;
       using ValueT = typename std::iterator_traits<DstIterT>::value_type;
+      using UKeyT = make_unsigned_t<InputValueT>;
       static_assert(
           std::is_convertible_v<DiffT, typename std::iterator_traits<DstIterT>::difference_type>,
           "diff type not compatible");
@@ -903,114 +1073,35 @@ namespace zs {
 
       CppTimer timer;
       if (shouldProfile()) timer.tick();
-      const auto dist = last - first;
-      DiffT nths{}, nwork{};
-      // const int binBits = bit_length(_dop);
-      bool skip = false;
-      constexpr int binBits = 8;  // by byte
-      int binCount = 1 << binBits;
-      int binMask = binCount - 1;
-
-      auto allocator = get_temporary_memory_source(*this);
-      Vector<DiffT> binGlobalSizes{allocator, (size_t)binCount};
-      Vector<DiffT> binOffsets{allocator, (size_t)binCount};
-      std::vector<Vector<DiffT>> binSizes{};
-
-      /// double buffer strategy
-      Vector<InputValueT> buffers[2] = {{allocator, (size_t)dist}, {allocator, (size_t)dist}};
-      InputValueT *cur{buffers[0].data()}, *next{buffers[1].data()};
-
-      /// move to local buffer first (bit hack for signed type)
-#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+      const DiffT dist = last - first;
+      if (dist <= 0) return;
+      const int nths = num_threads_for(dist);
+      constexpr UKeyT signBit = is_signed_v<InputValueT> ? (UKeyT)1 << (sizeof(UKeyT) * 8 - 1) : 0;
+
+      /// double buffer and histograms, reused across the sorts of the calling thread
+      detail::omp_sort_scratch::lease scratch{
+          detail::omp_sort_scratch::bytes<UKeyT, void, DiffT>(dist, nths),
+          get_temporary_memory_source(*this)};
+      UKeyT *cur = scratch.template carve<UKeyT>(dist), *next = scratch.template carve<UKeyT>(dist);
+      DiffT *hist = scratch.template carve<DiffT>((size_t)nths << detail::radix_max_digit_bits);
+      void *curVals = nullptr, *nextVals = nullptr;
+
+      /// move to local buffer first (bit hack for signed type), record the bits that vary
+      UKeyT orBits = 0, andBits = ~(UKeyT)0;
+#pragma omp parallel for num_threads(nths) if (nths > 1) reduction(| : orBits) \
+    reduction(& : andBits)
       for (DiffT i = 0; i < dist; ++i) {
-        if constexpr (is_signed_v<InputValueT>)
-          cur[i] = *(first + i) ^ ((InputValueT)1 << (sizeof(InputValueT) * 8 - 1));
-        else
-          cur[i] = *(first + i);
+        const UKeyT key = (UKeyT)(*(first + i)) ^ signBit;
+        cur[i] = key;
+        orBits |= key;
+        andBits &= key;
       }
 
-      /// LSB style (outmost loop)
-      for (int st = sbit; st < ebit; st += binBits) {
-        if (st + binBits > ebit) {
-          binMask >>= (st + binBits - ebit);
-          binCount >>= (st + binBits - ebit);
-        }
-
-        /// init
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
-    shared(skip, nths, nwork, binSizes, binGlobalSizes, binOffsets, cur, next)
-        {
-#pragma omp single
-          {
-            nths = omp_get_num_threads();
-            nwork = (dist + nths - 1) / nths;
-            binSizes.resize(nths);
-            for (auto &v : binSizes) v = Vector<DiffT>{allocator, (size_t)0};
-            skip = false;
-          }
-#pragma omp barrier
-          /// work block partition
-          DiffT tid = omp_get_thread_num();
-          DiffT l = nwork * tid;
-          DiffT r = l + nwork;
-          if (r > dist) r = dist;
-          /// init
-          binSizes[tid].resize(binCount);
-
-          /// local count
-          for (DiffT i = 0; i < binCount; ++i) binSizes[tid][i] = 0;
-          if (l < dist)
-            for (auto i = l; i < r; ++i) binSizes[tid][(cur[i] >> st) & binMask]++;
-
-#pragma omp barrier
-
-#pragma omp single
-          {
-            /// reduce binSizes from all threads
-            for (int i = 0; i < binCount; ++i) {
-              binGlobalSizes[i] = 0;
-              for (int j = 0; j < nths; ++j) binGlobalSizes[i] += binSizes[j][i];
-              if (binGlobalSizes[i] == dist) {
-                skip = true;
-                break;
-              }
-            }
-
-            if (!skip) {
-              /// exclusive scan
-              binOffsets[0] = 0;
-              for (int i = 1; i < binCount; ++i)
-                binOffsets[i] = binOffsets[i - 1] + binGlobalSizes[i - 1];
-
-              /// update local offsets
-              for (int i = 0; i < binCount; i++) {
-                binSizes[0][i] += binOffsets[i];
-                for (int j = 1; j < nths; j++) binSizes[j][i] += binSizes[j - 1][i];
-              }
-            }
-          }
-
-          if (!skip) {
-/// distribute
-#pragma omp barrier
-            if (l < dist)
-              for (auto i = r - 1; i >= l; --i)
-                next[--binSizes[tid][(cur[i] >> st) & binMask]] = cur[i];
-#pragma omp barrier
-#pragma omp single
-            { std::swap(cur, next); }
-          }
-#pragma omp barrier
-        }
-      }
+      radix_sort_buffers(cur, next, curVals, nextVals, dist, sbit, ebit, orBits ^ andBits, hist,
+                         nths);
 
-#pragma omp parallel for if (_dop < dist) num_threads(_dop)
-      for (DiffT i = 0; i < dist; ++i) {
-        if constexpr (is_signed_v<InputValueT>)
-          *(d_first + i) = cur[i] ^ ((InputValueT)1 << (sizeof(InputValueT) * 8 - 1));
-        else
-          *(d_first + i) = cur[i];
-      }
+#pragma omp parallel for num_threads(nths) if (nths > 1)
+      for (DiffT i = 0; i < dist; ++i) *(d_first + i) = (InputValueT)(cur[i] ^ signBit);
       if (shouldProfile())
         timer.tock(fmt::format("[Omp Exec | File {}, Ln {}, Col {}]", loc.file_name(), loc.line(),
                                loc.column()));
@@ -1032,126 +1123,43 @@ namespace zs {
       using KeyT = typename std::iterator_traits<remove_reference_t<KeyIter>>::value_type;
       using ValueT = typename std::iterator_traits<remove_reference_t<ValueIter>>::value_type;
       using DiffT = typename std::iterator_traits<remove_reference_t<KeyIter>>::difference_type;
+      using UKeyT = make_unsigned_t<KeyT>;
       static_assert(is_integral_v<KeyT>, "key type not integral");
 
       CppTimer timer;
       if (shouldProfile()) timer.tick();
-      const auto dist = count;
-      DiffT nths{}, nwork{};
-      // const int binBits = bit_length(_dop);
-      bool skip = false;
-      constexpr int binBits = 8;  // by byte
-      int binCount = 1 << binBits;
-      int binMask = binCount - 1;
-
-      auto allocator = get_temporary_memory_source(*this);
-      Vector<DiffT> binGlobalSizes{allocator, (size_t)binCount};
-      Vector<DiffT> binOffsets{allocator, (size_t)binCount};
-      std::vector<Vector<DiffT>> binSizes{};
-
-      /// double buffer strategy
-      Vector<KeyT> keyBuffers[2] = {{allocator, (size_t)count}, {allocator, (size_t)count}};
-      Vector<ValueT> valBuffers[2] = {{allocator, (size_t)count}, {allocator, (size_t)count}};
-      KeyT *cur{keyBuffers[0].data()}, *next{keyBuffers[1].data()};
-      ValueT *curVals{valBuffers[0].data()}, *nextVals{valBuffers[1].data()};
-
-      /// move to local buffer first (bit hack for signed type)
-#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+      const DiffT dist = count;
+      if (dist <= 0) return;
+      const int nths = num_threads_for(dist);
+      constexpr UKeyT signBit = is_signed_v<KeyT> ? (UKeyT)1 << (sizeof(UKeyT) * 8 - 1) : 0;
+
+      /// double buffers and histograms, reused across the sorts of the calling thread
+      detail::omp_sort_scratch::lease scratch{
+          detail::omp_sort_scratch::bytes<UKeyT, ValueT, DiffT>(dist, nths),
+          get_temporary_memory_source(*this)};
+      UKeyT *cur = scratch.template carve<UKeyT>(dist), *next = scratch.template carve<UKeyT>(dist);
+      ValueT *curVals = scratch.template carve<ValueT>(dist);
+      ValueT *nextVals = scratch.template carve<ValueT>(dist);
+      DiffT *hist = scratch.template carve<DiffT>((size_t)nths << detail::radix_max_digit_bits);
+
+      /// move to local buffer first (bit hack for signed type), record the bits that vary
+      UKeyT orBits = 0, andBits = ~(UKeyT)0;
+#pragma omp parallel for num_threads(nths) if (nths > 1) reduction(| : orBits) \
+    reduction(& : andBits)
       for (DiffT i = 0; i < dist; ++i) {
-        if constexpr (is_signed_v<KeyT>)
-          cur[i] = *(keysIn + i) ^ ((KeyT)1 << (sizeof(KeyT) * 8 - 1));
-        else
-          cur[i] = *(keysIn + i);
+        const UKeyT key = (UKeyT)(*(keysIn + i)) ^ signBit;
+        cur[i] = key;
+        orBits |= key;
+        andBits &= key;
         curVals[i] = *(valsIn + i);
       }
 
-      /// LSB style (outmost loop)
-      for (int st = sbit; st < ebit; st += binBits) {
-        if (st + binBits > ebit) {
-          binMask >>= (st + binBits - ebit);
-          binCount >>= (st + binBits - ebit);
-        }
+      radix_sort_buffers(cur, next, curVals, nextVals, dist, sbit, ebit, orBits ^ andBits, hist,
+                         nths);
 
-        /// init
-#pragma omp parallel if (_dop < dist) num_threads(_dop) \
-    shared(skip, nths, nwork, binSizes, binGlobalSizes, binOffsets, cur, next, curVals, nextVals)
-        {
-#pragma omp single
-          {
-            nths = omp_get_num_threads();
-            nwork = (dist + nths - 1) / nths;
-            binSizes.resize(nths);
-            for (auto &v : binSizes) v = Vector<DiffT>{allocator, (size_t)0};
-            skip = false;
-          }
-#pragma omp barrier
-          /// work block partition
-          DiffT tid = omp_get_thread_num();
-          DiffT l = nwork * tid;
-          DiffT r = l + nwork;
-          if (r > dist) r = dist;
-          /// init
-          binSizes[tid].resize(binCount);
-
-          /// local count
-          for (DiffT i = 0; i < binCount; ++i) binSizes[tid][i] = 0;
-          if (l < dist)
-            for (auto i = l; i < r; ++i) binSizes[tid][(cur[i] >> st) & binMask]++;
-
-#pragma omp barrier
-
-#pragma omp single
-          {
-            /// reduce binSizes from all threads
-            for (int i = 0; i < binCount; ++i) {
-              binGlobalSizes[i] = 0;
-              for (int j = 0; j < nths; ++j) binGlobalSizes[i] += binSizes[j][i];
-              if (binGlobalSizes[i] == dist) {
-                skip = true;
-                break;
-              }
-            }
-
-            if (!skip) {
-              /// exclusive scan
-              binOffsets[0] = 0;
-              for (int i = 1; i < binCount; ++i)
-                binOffsets[i] = binOffsets[i - 1] + binGlobalSizes[i - 1];
-
-              /// update local offsets
-              for (int i = 0; i < binCount; i++) {
-                binSizes[0][i] += binOffsets[i];
-                for (int j = 1; j < nths; j++) binSizes[j][i] += binSizes[j - 1][i];
-              }
-            }
-          }
-
-          if (!skip) {
-/// distribute
-#pragma omp barrier
-            if (l < dist)
-              for (auto i = r - 1; i >= l; --i) {
-                const auto loc = --binSizes[tid][(cur[i] >> st) & binMask];
-                next[loc] = cur[i];
-                nextVals[loc] = curVals[i];
-              }
-#pragma omp barrier
-#pragma omp single
-            {
-              std::swap(cur, next);
-              std::swap(curVals, nextVals);
-            }
-          }
-#pragma omp barrier
-        }
-      }
-
-#pragma omp parallel for if (_dop < dist) num_threads(_dop)
+#pragma omp parallel for num_threads(nths) if (nths > 1)
       for (DiffT i = 0; i < dist; ++i) {
-        if constexpr (is_signed_v<KeyT>)
-          *(keysOut + i) = cur[i] ^ ((KeyT)1 << (sizeof(KeyT) * 8 - 1));
-        else
-          *(keysOut + i) = cur[i];
+        *(keysOut + i) = (KeyT)(cur[i] ^ signBit);
         *(valsOut + i) = curVals[i];
       }
       if (shouldProfile())
@@ -1173,6 +1181,310 @@ namespace zs {
       radix_sort_pair_impl(std::random_access_iterator_tag{}, FWD(keysIn), FWD(valsIn),
                            FWD(keysOut), FWD(valsOut), count, sbit, ebit, loc);
     }
+    /// release the sort buffers kept by the calling thread
+    static void release_sort_scratch() { detail::omp_sort_scratch::release(); }
+
+    /// segmented sort, [first + offsets[i], first + offsets[i + 1]) are sorted independently
+    /// @note meant for many small ranges (e.g. per-cell sorts), segments are distributed among
+    /// threads. The few segments that are too large for one thread use the parallel sort.
+    template <class KeyIter, class OffsetIter,
+              typename CompareOpT
+              = std::less<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    void segmented_sort(KeyIter &&first, OffsetIter &&offsets, size_t numSegments,
+                        CompareOpT &&compOp = {},
+                        const source_location &loc = source_location::current()) const {
+      static_assert(
+          is_ra_iter_v<remove_cvref_t<KeyIter>> && is_ra_iter_v<remove_cvref_t<OffsetIter>>,
+          "keys and offsets should both be random access iterators");
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (numSegments == 0) return;
+      const size_t total = (size_t)(offsets[numSegments] - offsets[0]);
+      const size_t largeSize = segmented_sort_large_size(total);
+      const int nths = num_threads_for(numSegments);
+#pragma omp parallel for num_threads(nths) if (nths > 1) schedule(dynamic, 16)
+      for (i64 i = 0; i < (i64)numSegments; ++i) {
+        const auto st = offsets[i], ed = offsets[i + 1];
+        const auto n = (size_t)(ed - st);
+        if (n < 2 || n >= largeSize) continue;
+        if (n <= detail::segmented_insertion_sort_size)
+          detail::insertion_sort_pair(first + st, (int *)nullptr, n, compOp);
+        else
+          std::sort(first + st, first + ed, compOp);
+      }
+      for (size_t i = 0; i != numSegments; ++i)
+        if ((size_t)(offsets[i + 1] - offsets[i]) >= largeSize)
+          merge_sort_impl(first + offsets[i], first + offsets[i + 1], compOp, false_c, loc);
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp segmented_sort | File {}, Ln {}, Col {}]", loc.file_name(),
+                               loc.line(), loc.column()));
+    }
+    /// segmented sort of key-value pairs, stable within each segment
+    template <class KeyIter, class ValueIter, class OffsetIter,
+              typename CompareOpT
+              = std::less<typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type>>
+    void segmented_sort_pair(KeyIter &&keys, ValueIter &&vals, OffsetIter &&offsets,
+                             size_t numSegments, CompareOpT &&compOp = {},
+                             const source_location &loc = source_location::current()) const {
+      static_assert(is_ra_iter_v<remove_cvref_t<KeyIter>> && is_ra_iter_v<remove_cvref_t<ValueIter>>
+                        && is_ra_iter_v<remove_cvref_t<OffsetIter>>,
+                    "keys, values and offsets should all be random access iterators");
+      using KeyT = typename std::iterator_traits<remove_cvref_t<KeyIter>>::value_type;
+      using ValueT = typename std::iterator_traits<remove_cvref_t<ValueIter>>::value_type;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (numSegments == 0) return;
+      const size_t total = (size_t)(offsets[numSegments] - offsets[0]);
+      const size_t largeSize = segmented_sort_large_size(total);
+      const int nths = num_threads_for(numSegments);
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        std::vector<std::pair<KeyT, ValueT>> pairs{};
+#pragma omp for schedule(dynamic, 16)
+        for (i64 i = 0; i < (i64)numSegments; ++i) {
+          const auto st = offsets[i], ed = offsets[i + 1];
+          const auto n = (size_t)(ed - st);
+          if (n < 2 || n >= largeSize) continue;
+          if (n <= detail::segmented_insertion_sort_size) {
+            detail::insertion_sort_pair(keys + st, vals + st, n, compOp);
+            continue;
+          }
+          pairs.resize(n);
+          for (size_t j = 0; j != n; ++j) pairs[j] = std::make_pair(keys[st + j], vals[st + j]);
+          std::stable_sort(pairs.begin(), pairs.end(), [&compOp](const auto &a, const auto &b) {
+            return compOp(a.first, b.first);
+          });
+          for (size_t j = 0; j != n; ++j) {
+            keys[st + j] = pairs[j].first;
+            vals[st + j] = pairs[j].second;
+          }
+        }
+      }
+      for (size_t i = 0; i != numSegments; ++i) {
+        const auto st = offsets[i], n = offsets[i + 1] - offsets[i];
+        if ((size_t)n >= largeSize)
+          merge_sort_pair_impl(keys + st, vals + st, n, compOp, true_c, loc);
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp segmented_sort_pair | File {}, Ln {}, Col {}]",
+                               loc.file_name(), loc.line(), loc.column()));
+    }
+
+    /// segmented reduce, segment i spans [first + offsets[i], first + offsets[i + 1])
+    /// @note threads split the elements evenly regardless of the segment lengths, a segment
+    /// crossing a block boundary is completed by a short fix-up pass
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_reduce(
+        InputIt &&first, OffsetIt &&offsets, size_t numSegments, OutputIt &&d_first,
+        remove_cvref_t<decltype(*declval<InputIt>())> init
+        = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+        BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) const {
+      static_assert(is_ra_iter_v<remove_cvref_t<InputIt>> && is_ra_iter_v<remove_cvref_t<OffsetIt>>
+                        && is_ra_iter_v<remove_cvref_t<OutputIt>>,
+                    "input, offset and output iterators should all be random access iterators");
+      using ValueT = remove_cvref_t<decltype(*first)>;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (numSegments == 0) return;
+      const auto lo = offsets[0];
+      const size_t dist = (size_t)(offsets[numSegments] - lo);
+      const int nths = num_threads_for(dist);
+      auto allocator = get_temporary_memory_source(*this);
+      Vector<ValueT> headVals{allocator, (size_t)nths};
+      Vector<size_t> headSegs{allocator, (size_t)nths};
+      ValueT *partials = headVals.data();
+      size_t *partialSegs = headSegs.data();
+      auto segOffsets = offsets;
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        const int nt = omp_get_num_threads(), tid = omp_get_thread_num();
+        const size_t nwork = (dist + nt - 1) / nt;
+        const size_t st = nwork * tid < dist ? nwork * tid : dist;
+        const size_t ed = st + nwork < dist ? st + nwork : dist;
+        const auto blockSt = lo + st, blockEd = lo + ed;
+        /// segments starting in this block are owned by this thread
+        const size_t sLo
+            = std::lower_bound(segOffsets, segOffsets + numSegments, blockSt) - segOffsets;
+        const size_t sHi
+            = tid == nt - 1
+                  ? numSegments
+                  : std::lower_bound(segOffsets + sLo, segOffsets + numSegments, blockEd)
+                        - segOffsets;
+        /// the head of the block belongs to a segment started by a previous thread
+        partialSegs[tid] = numSegments;
+        const auto headEd
+            = sLo < numSegments && segOffsets[sLo] < blockEd ? segOffsets[sLo] : blockEd;
+        if (blockSt < headEd) {
+          ValueT res = *(first + blockSt);
+          for (auto i = blockSt + 1; i < headEd; ++i) res = binary_op(res, *(first + i));
+          partials[tid] = res;
+          partialSegs[tid] = sLo - 1;
+        }
+        for (size_t seg = sLo; seg < sHi; ++seg) {
+          const auto segEd = segOffsets[seg + 1] < blockEd ? segOffsets[seg + 1] : blockEd;
+          ValueT res = init;
+          for (auto i = segOffsets[seg]; i < segEd; ++i) res = binary_op(res, *(first + i));
+          *(d_first + seg) = res;
+        }
+#pragma omp barrier
+#pragma omp single
+        for (int t = 0; t < nt; ++t)
+          if (partialSegs[t] != numSegments)
+            *(d_first + partialSegs[t]) = binary_op(*(d_first + partialSegs[t]), partials[t]);
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp SegReduce | File {}, Ln {}, Col {}]", loc.file_name(),
+                               loc.line(), loc.column()));
+    }
+    /// segmented scans, [d_first] may alias [first]
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_inclusive_scan(InputIt &&first, OffsetIt &&offsets, size_t numSegments,
+                                  OutputIt &&d_first, BinaryOp &&binary_op = {},
+                                  const source_location &loc = source_location::current()) const {
+      segmented_scan_impl(FWD(first), FWD(offsets), numSegments, FWD(d_first),
+                          remove_cvref_t<decltype(*first)>{}, binary_op, true_c, loc);
+    }
+    template <class InputIt, class OffsetIt, class OutputIt,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    void segmented_exclusive_scan(
+        InputIt &&first, OffsetIt &&offsets, size_t numSegments, OutputIt &&d_first,
+        remove_cvref_t<decltype(*declval<InputIt>())> init
+        = deduce_identity<BinaryOp, remove_cvref_t<decltype(*declval<InputIt>())>>(),
+        BinaryOp &&binary_op = {}, const source_location &loc = source_location::current()) const {
+      segmented_scan_impl(FWD(first), FWD(offsets), numSegments, FWD(d_first), init, binary_op,
+                          false_c, loc);
+    }
+
+    /// stream compaction, returns the number of elements written
+    /// @note selected elements keep their relative order (deterministic output)
+    template <class InputIt, class OutputIt, class Predicate>
+    size_t copy_if(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred,
+                   const source_location &loc = source_location::current()) const {
+      return compact_impl(
+          (size_t)(last - first), [&](size_t i) -> bool { return pred(*(first + i)); },
+          [&](size_t i, size_t rank, bool selected, size_t) {
+            if (selected) *(d_first + rank) = *(first + i);
+          },
+          "CopyIf", loc);
+    }
+    /// stable, returns the number of elements satisfying [pred]
+    template <class InputIt, class OutputIt0, class OutputIt1, class Predicate>
+    size_t partition_copy(InputIt &&first, InputIt &&last, OutputIt0 &&d_true,
+                          OutputIt1 &&d_false, Predicate &&pred,
+                          const source_location &loc = source_location::current()) const {
+      return compact_impl(
+          (size_t)(last - first), [&](size_t i) -> bool { return pred(*(first + i)); },
+          [&](size_t i, size_t rank, bool selected, size_t) {
+            if (selected)
+              *(d_true + rank) = *(first + i);
+            else
+              *(d_false + (i - rank)) = *(first + i);
+          },
+          "PartitionCopy", loc);
+    }
+    /// stable, elements satisfying [pred] precede the others in [d_first]
+    template <class InputIt, class OutputIt, class Predicate>
+    size_t partition(InputIt &&first, InputIt &&last, OutputIt &&d_first, Predicate &&pred,
+                     const source_location &loc = source_location::current()) const {
+      return compact_impl(
+          (size_t)(last - first), [&](size_t i) -> bool { return pred(*(first + i)); },
+          [&](size_t i, size_t rank, bool selected, size_t total) {
+            *(d_first + (selected ? rank : total + i - rank)) = *(first + i);
+          },
+          "Partition", loc);
+    }
+    /// keeps the first element of each run of equal elements
+    template <class InputIt, class OutputIt,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<InputIt>())>>>
+    size_t unique(InputIt &&first, InputIt &&last, OutputIt &&d_first, EqualOp &&eq = {},
+                  const source_location &loc = source_location::current()) const {
+      return compact_impl(
+          (size_t)(last - first),
+          [&](size_t i) -> bool { return i == 0 || !eq(*(first + (i - 1)), *(first + i)); },
+          [&](size_t i, size_t rank, bool selected, size_t) {
+            if (selected) *(d_first + rank) = *(first + i);
+          },
+          "Unique", loc);
+    }
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+    size_t unique_by_key(KeyIter &&keys, ValueIter &&vals, size_t count, KeyOutIter &&keysOut,
+                         ValueOutIter &&valsOut, EqualOp &&eq = {},
+                         const source_location &loc = source_location::current()) const {
+      return compact_impl(
+          count, [&](size_t i) -> bool { return i == 0 || !eq(*(keys + (i - 1)), *(keys + i)); },
+          [&](size_t i, size_t rank, bool selected, size_t) {
+            if (selected) {
+              *(keysOut + rank) = *(keys + i);
+              *(valsOut + rank) = *(vals + i);
+            }
+          },
+          "UniqueByKey", loc);
+    }
+    /// reduces the values of each run of equal keys, returns the number of runs
+    template <class KeyIter, class ValueIter, class KeyOutIter, class ValueOutIter,
+              class BinaryOp = plus<remove_cvref_t<decltype(*declval<ValueIter>())>>,
+              class EqualOp = std::equal_to<remove_cvref_t<decltype(*declval<KeyIter>())>>>
+    size_t reduce_by_key(KeyIter &&keys, ValueIter &&vals, size_t count, KeyOutIter &&keysOut,
+                         ValueOutIter &&valsOut, BinaryOp &&binary_op = {}, EqualOp &&eq = {},
+                         const source_location &loc = source_location::current()) const {
+      using ValueT = remove_cvref_t<decltype(*vals)>;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (count == 0) return 0;
+      const int nths = num_threads_for(count);
+      auto allocator = get_temporary_memory_source(*this);
+      Vector<size_t> ranks{allocator, (size_t)nths + 1};
+      Vector<ValueT> headVals{allocator, (size_t)nths};
+      size_t *cnts = ranks.data();
+      ValueT *partials = headVals.data();
+      size_t total = 0;
+      auto isHead = [&](size_t i) { return i == 0 || !eq(*(keys + (i - 1)), *(keys + i)); };
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        const int nt = omp_get_num_threads(), tid = omp_get_thread_num();
+        const size_t nwork = (count + nt - 1) / nt;
+        const size_t st = nwork * tid < count ? nwork * tid : count;
+        const size_t ed = st + nwork < count ? st + nwork : count;
+        size_t cnt = 0;
+        for (size_t i = st; i < ed; ++i) cnt += isHead(i) ? 1 : 0;
+        cnts[tid + 1] = cnt;
+#pragma omp barrier
+#pragma omp single
+        {
+          cnts[0] = 0;
+          for (int t = 0; t < nt; ++t) cnts[t + 1] += cnts[t];
+          total = cnts[nt];
+        }
+        /// the run entering this block is finished by the fix-up below
+        size_t rank = cnts[tid];
+        size_t i = st;
+        if (i < ed && !isHead(i)) {
+          ValueT res = *(vals + i);
+          for (++i; i < ed && !isHead(i); ++i) res = binary_op(res, *(vals + i));
+          partials[tid] = res;
+        }
+        while (i < ed) {
+          *(keysOut + rank) = *(keys + i);
+          ValueT res = *(vals + i);
+          for (++i; i < ed && !isHead(i); ++i) res = binary_op(res, *(vals + i));
+          *(valsOut + rank++) = res;
+        }
+#pragma omp barrier
+#pragma omp single
+        for (int t = 1; t < nt; ++t) {
+          const size_t tst = nwork * t;
+          if (tst < count && !isHead(tst))
+            *(valsOut + (cnts[t] - 1)) = binary_op(*(valsOut + (cnts[t] - 1)), partials[t]);
+        }
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp ReduceByKey | File {}, Ln {}, Col {}]", loc.file_name(),
+                               loc.line(), loc.column()));
+      return total;
+    }
 
     OmpExecutionPolicy &threads(int numThreads) noexcept {
       _dop = numThreads;
@@ -1182,6 +1494,268 @@ namespace zs {
   protected:
     friend struct ExecutionPolicyInterface<OmpExecutionPolicy>;
 
+    template <typename DiffT> int num_threads_for(DiffT n) const noexcept {
+      return _dop > 1 && (DiffT)_dop < n ? _dop : 1;
+    }
+
+    /// counts the selected elements per thread block, then [emit](i, rank, selected, total) is
+    /// called for every element, rank being the number of selected elements before i
+    template <typename SelectF, typename EmitF>
+    size_t compact_impl(size_t dist, SelectF &&select, EmitF &&emit, const char *tag,
+                        const source_location &loc) const {
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (dist == 0) return 0;
+      const int nths = num_threads_for(dist);
+      auto allocator = get_temporary_memory_source(*this);
+      Vector<size_t> ranks{allocator, (size_t)nths + 1};
+      size_t *cnts = ranks.data();
+      size_t total = 0;
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        const int nt = omp_get_num_threads(), tid = omp_get_thread_num();
+        const size_t nwork = (dist + nt - 1) / nt;
+        const size_t st = nwork * tid < dist ? nwork * tid : dist;
+        const size_t ed = st + nwork < dist ? st + nwork : dist;
+        size_t cnt = 0;
+        for (size_t i = st; i < ed; ++i) cnt += select(i) ? 1 : 0;
+        cnts[tid + 1] = cnt;
+#pragma omp barrier
+#pragma omp single
+        {
+          cnts[0] = 0;
+          for (int t = 0; t < nt; ++t) cnts[t + 1] += cnts[t];
+          total = cnts[nt];
+        }
+        size_t rank = cnts[tid];
+        for (size_t i = st; i < ed; ++i) {
+          const bool selected = select(i);
+          emit(i, rank, selected, total);
+          rank += selected ? 1 : 0;
+        }
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp {} | File {}, Ln {}, Col {}]", tag, loc.file_name(),
+                               loc.line(), loc.column()));
+      return total;
+    }
+
+    /// per-block aggregates first, then every block rescans with the carry of its head segment
+    template <class InputIt, class OffsetIt, class OutputIt, typename T, class BinaryOp,
+              bool Inclusive>
+    void segmented_scan_impl(InputIt &&first, OffsetIt &&offsets, size_t numSegments,
+                             OutputIt &&d_first, T init, BinaryOp &binary_op, wrapv<Inclusive>,
+                             const source_location &loc) const {
+      static_assert(is_ra_iter_v<remove_cvref_t<InputIt>> && is_ra_iter_v<remove_cvref_t<OffsetIt>>
+                        && is_ra_iter_v<remove_cvref_t<OutputIt>>,
+                    "input, offset and output iterators should all be random access iterators");
+      using ValueT = remove_cvref_t<decltype(*first)>;
+      CppTimer timer;
+      if (shouldProfile()) timer.tick();
+      if (numSegments == 0) return;
+      const auto lo = offsets[0];
+      const size_t dist = (size_t)(offsets[numSegments] - lo);
+      if (dist == 0) return;
+      const int nths = num_threads_for(dist);
+      auto allocator = get_temporary_memory_source(*this);
+      Vector<ValueT> aggregates{allocator, (size_t)nths * 2};
+      Vector<int> flags{allocator, (size_t)nths};
+      ValueT *tails = aggregates.data(), *carries = tails + nths;
+      int *tailStartsInBlock = flags.data();
+      auto segOffsets = offsets;
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        const int nt = omp_get_num_threads(), tid = omp_get_thread_num();
+        const size_t nwork = (dist + nt - 1) / nt;
+        const size_t st = nwork * tid < dist ? nwork * tid : dist;
+        const size_t ed = st + nwork < dist ? st + nwork : dist;
+        const auto blockSt = lo + st, blockEd = lo + ed;
+        /// the segment of the first element, empty segments share its offset
+        const size_t segSt
+            = std::upper_bound(segOffsets, segOffsets + numSegments, blockSt) - segOffsets - 1;
+        if (blockSt < blockEd) {
+          size_t seg = segSt;
+          ValueT acc = *(first + blockSt);
+          for (auto i = blockSt + 1; i < blockEd; ++i) {
+            while (segOffsets[seg + 1] <= i) ++seg;
+            if (segOffsets[seg] == i)
+              acc = *(first + i);
+            else
+              acc = binary_op(acc, *(first + i));
+          }
+          while (segOffsets[seg + 1] <= blockEd - 1) ++seg;
+          tails[tid] = acc;
+          tailStartsInBlock[tid] = segOffsets[seg] >= blockSt;
+        }
+#pragma omp barrier
+#pragma omp single
+        for (int t = 1; t < nt; ++t) {
+          if (nwork * t >= dist) break;
+          carries[t] = tailStartsInBlock[t - 1] || t == 1 ? tails[t - 1]
+                                                          : binary_op(carries[t - 1], tails[t - 1]);
+        }
+        if (blockSt < blockEd) {
+          size_t seg = segSt;
+          ValueT acc{};
+          for (auto i = blockSt; i < blockEd; ++i) {
+            while (segOffsets[seg + 1] <= i) ++seg;
+            const ValueT v = *(first + i);  // in-place safe
+            if constexpr (Inclusive) {
+              if (segOffsets[seg] == i)
+                acc = v;
+              else if (i == blockSt)
+                acc = binary_op(carries[tid], v);
+              else
+                acc = binary_op(acc, v);
+              *(d_first + i) = acc;
+            } else {
+              if (segOffsets[seg] == i)
+                acc = init;
+              else if (i == blockSt)
+                acc = binary_op(init, carries[tid]);
+              *(d_first + i) = acc;
+              acc = binary_op(acc, v);
+            }
+          }
+        }
+      }
+      if (shouldProfile())
+        timer.tock(fmt::format("[Omp SegScan | File {}, Ln {}, Col {}]", loc.file_name(),
+                               loc.line(), loc.column()));
+    }
+    size_t segmented_sort_large_size(size_t total) const noexcept {
+      const size_t share = total / (size_t)(_dop > 1 ? _dop : 1);
+      return share > ((size_t)1 << 16) ? share : ((size_t)1 << 16);
+    }
+
+    /// sorts [cur, cur + dist) by the bits [sbit, ebit), the result ends up in [cur]
+    /// @note [ValueT] is void for a key-only sort
+    template <typename UKeyT, typename ValueT, typename DiffT>
+    void radix_sort_buffers(UKeyT *&cur, UKeyT *&next, ValueT *&curVals, ValueT *&nextVals,
+                            DiffT dist, int sbit, int ebit, UKeyT varying, DiffT *hist,
+                            int nths) const {
+      const auto digits
+          = detail::plan_radix_digits(varying, sbit, ebit, (size_t)dist / (size_t)nths);
+      if (digits.num == 0) return;
+      const int lo = digits.st[0];
+      const int hi = digits.st[digits.num - 1] + digits.bits[digits.num - 1];
+      if (sizeof(UKeyT) == 8 && hi - lo > 32 && dist >= ((DiffT)1 << 16))
+        radix_sort_msd(cur, next, curVals, nextVals, dist, lo, hi, hist, nths);
+      else
+        radix_sort_lsd(cur, next, curVals, nextVals, dist, digits, hist, nths);
+    }
+
+    /// one counting pass per digit, threads scatter their own blocks (stable)
+    template <typename UKeyT, typename ValueT, typename DiffT>
+    void radix_sort_lsd(UKeyT *&cur, UKeyT *&next, ValueT *&curVals, ValueT *&nextVals,
+                        DiffT dist, const detail::radix_digits &digits, DiffT *hist,
+                        int nths) const {
+      for (int d = 0; d != digits.num; ++d) {
+        const int st = digits.st[d];
+        const int binCount = 1 << digits.bits[d];
+        const UKeyT binMask = (UKeyT)(binCount - 1);
+#pragma omp parallel num_threads(nths) if (nths > 1)
+        {
+          const DiffT nt = omp_get_num_threads(), tid = omp_get_thread_num();
+          const DiffT nwork = (dist + nt - 1) / nt;
+          const DiffT l = nwork * tid < dist ? nwork * tid : dist;
+          const DiffT r = l + nwork < dist ? l + nwork : dist;
+          DiffT *localHist = hist + (size_t)tid * binCount;
+          for (int b = 0; b != binCount; ++b) localHist[b] = 0;
+          for (DiffT i = l; i < r; ++i) localHist[(cur[i] >> st) & binMask]++;
+#pragma omp barrier
+#pragma omp single
+          {
+            /// exclusive scan in (bin, thread) order
+            DiffT offset = 0;
+            for (int b = 0; b != binCount; ++b)
+              for (DiffT t = 0; t != nt; ++t) {
+                const DiffT cnt = hist[(size_t)t * binCount + b];
+                hist[(size_t)t * binCount + b] = offset;
+                offset += cnt;
+              }
+          }
+          for (DiffT i = l; i < r; ++i) {
+            const DiffT loc = localHist[(cur[i] >> st) & binMask]++;
+            next[loc] = cur[i];
+            if constexpr (!is_same_v<ValueT, void>) nextVals[loc] = curVals[i];
+          }
+        }
+        std::swap(cur, next);
+        std::swap(curVals, nextVals);
+      }
+    }
+
+    /// split by the leading digit, then sort the buckets one per thread
+    template <typename UKeyT, typename ValueT, typename DiffT>
+    void radix_sort_msd(UKeyT *&cur, UKeyT *&next, ValueT *&curVals, ValueT *&nextVals,
+                        DiffT dist, int lo, int hi, DiffT *hist, int nths) const {
+      detail::radix_digits top{};
+      top.num = 1;
+      top.bits[0] = hi - lo < detail::radix_max_digit_bits ? hi - lo : detail::radix_max_digit_bits;
+      top.st[0] = hi - top.bits[0];
+      radix_sort_lsd(cur, next, curVals, nextVals, dist, top, hist, nths);
+
+      const int numBuckets = 1 << top.bits[0];
+      const int st = top.st[0];
+      const UKeyT binMask = (UKeyT)(numBuckets - 1);
+      /// bucket boundaries, cur is now ordered by the leading digit
+      DiffT *bounds = hist;
+      bounds[0] = 0;
+      for (int b = 1; b != numBuckets; ++b)
+        bounds[b] = std::partition_point(cur + bounds[b - 1], cur + dist,
+                                         [st, binMask, b](UKeyT key) {
+                                           return (int)((key >> st) & binMask) < b;
+                                         })
+                    - cur;
+      bounds[numBuckets] = dist;
+
+      const DiffT largeSize = dist / nths > ((DiffT)1 << 16) ? dist / nths : ((DiffT)1 << 16);
+#pragma omp parallel num_threads(nths) if (nths > 1)
+      {
+        DiffT localHist[1 << detail::radix_max_digit_bits];
+#pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < numBuckets; ++b) {
+          const DiffT l = bounds[b], n = bounds[b + 1] - bounds[b];
+          if (n < 2 || n >= largeSize) continue;
+          if constexpr (is_same_v<ValueT, void>)
+            detail::radix_sort_seq(cur + l, next + l, (void *)nullptr, (void *)nullptr, n, lo, st,
+                                   localHist);
+          else
+            detail::radix_sort_seq(cur + l, next + l, curVals + l, nextVals + l, n, lo, st,
+                                   localHist);
+        }
+      }
+      /// skewed distributions, the oversized buckets use all threads
+      for (int b = 0; b != numBuckets; ++b) {
+        const DiffT l = bounds[b], n = bounds[b + 1] - bounds[b];
+        if (n < largeSize) continue;
+        UKeyT orBits = 0, andBits = ~(UKeyT)0;
+#pragma omp parallel for num_threads(nths) if (nths > 1) reduction(| : orBits) \
+    reduction(& : andBits)
+        for (DiffT i = l; i < l + n; ++i) {
+          orBits |= cur[i];
+          andBits &= cur[i];
+        }
+        UKeyT *c = cur + l, *nx = next + l;
+        ValueT *cv = nullptr, *nv = nullptr;
+        if constexpr (!is_same_v<ValueT, void>) {
+          cv = curVals + l;
+          nv = nextVals + l;
+        }
+        const auto digits = detail::plan_radix_digits((UKeyT)(orBits ^ andBits), lo, st,
+                                                      (size_t)n / (size_t)nths);
+        radix_sort_lsd(c, nx, cv, nv, n, digits, hist + numBuckets + 1, nths);
+        if (c != cur + l) {
+#pragma omp parallel for num_threads(nths) if (nths > 1)
+          for (DiffT i = 0; i < n; ++i) {
+            cur[l + i] = c[i];
+            if constexpr (!is_same_v<ValueT, void>) curVals[l + i] = cv[i];
+          }
+        }
+      }
+    }
+
     int _dop{1};
   };
 
@@ -0,0 +1,156 @@
+#pragma once
+#include "zensim/container/TileVector.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "ConstitutiveModel.hpp"
+#include "plasticity_models/NonAssociativeCamClay.hpp"
+#include "plasticity_models/SnowPlasticity.hpp"
+
+namespace zs {
+
+  namespace detail {
+    struct no_plasticity {};
+
+    template <typename PM> struct is_snow_plasticity : false_type {};
+    template <typename T> struct is_snow_plasticity<SnowPlasticity<T>> : true_type {};
+    template <typename PM> struct is_camclay_plasticity : false_type {};
+    template <typename T> struct is_camclay_plasticity<NonAssociativeCamClay<T>> : true_type {};
+
+    /// @brief return mapping on the singular values followed by P = U dpsi/dsigma V^T
+    /// @note U, S, V come from the svd of F, S holds the elastic singular values afterwards
+    template <typename Model, typename PM, typename T, typename MatT, typename VecT>
+    constexpr MatT fused_first_piola(const Model &model, const PM &pm, const MatT &U, VecT &S,
+                                     const MatT &V, T *logJp) noexcept {
+      if constexpr (is_same_v<PM, no_plasticity>) {
+        return diag_mul(U, model.dpsi_dsigma(S)) * V.transpose();
+      } else if constexpr (is_snow_plasticity<PM>::value) {
+        // hardened lame parameters
+        Model m = model;
+        zs::tie(m.mu, m.lam) = pm.project_sigma(S, model.mu, model.lam);
+        return diag_mul(U, m.dpsi_dsigma(S)) * V.transpose();
+      } else if constexpr (is_camclay_plasticity<PM>::value) {
+        pm.project_sigma(S, model, *logJp);
+        return diag_mul(U, model.dpsi_dsigma(S)) * V.transpose();
+      } else {
+        pm.project_sigma(S, model);
+        return diag_mul(U, model.dpsi_dsigma(S)) * V.transpose();
+      }
+    }
+
+    template <typename TileVectorT>
+    auto check_stress_property(const TileVectorT &tv, const SmallString &tag, int size) {
+      if (!tv.hasProperty(tag))
+        throw std::runtime_error(
+            fmt::format("[evaluate_stress] property \"{}\" does not exist", tag.asChars()));
+      if (tv.getPropertySize(tag) != size)
+        throw std::runtime_error(fmt::format(
+            "[evaluate_stress] property \"{}\" should have {} channels", tag.asChars(), size));
+      return tv.getPropertyOffset(tag);
+    }
+
+    template <typename ExecPol, typename Model, typename PM, typename T, size_t Length,
+              typename Allocator>
+    void evaluate_stress_impl(ExecPol &&pol, const Model &model, const PM &pm,
+                              TileVector<T, Length, Allocator> &tv, const SmallString &FTag,
+                              const SmallString &PTag, const SmallString &logJpTag) {
+      static_assert(is_same_v<T, float>, "batched stress evaluation currently only supports float");
+      constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+      constexpr bool has_plasticity = !is_same_v<PM, no_plasticity>;
+      constexpr bool require_logJp = is_camclay_plasticity<PM>::value;
+      using size_type = typename TileVector<T, Length, Allocator>::size_type;
+      using mat3 = vec<T, 3, 3>;
+      using vec3 = vec<T, 3>;
+      constexpr size_type lane_width = Length;
+
+      if (!valid_memspace_for_execution(pol, tv.get_allocator()))
+        throw std::runtime_error(
+            "[evaluate_stress] current memory location not compatible with the execution policy");
+      const auto FOffset = check_stress_property(tv, FTag, 9);
+      const auto POffset = check_stress_property(tv, PTag, 9);
+      int logJpOffset = -1;
+      if constexpr (require_logJp) logJpOffset = check_stress_property(tv, logJpTag, 1);
+
+      const size_type n = tv.size();
+      if (n == 0) return;
+      if constexpr (is_host_execution<space>()) {
+        pol(range(tv.numTiles()), [tv = view<space>(tv), n, model, pm, FOffset, POffset,
+                                   logJpOffset](size_type tileNo) mutable {
+          const size_type base = tileNo * lane_width;
+          const size_type cnt = n - base < lane_width ? n - base : lane_width;
+          // F is read once, svd of the whole tile in simd lanes
+          T us[9][lane_width], ss[3][lane_width], vs[9][lane_width];
+          const T *a[9];
+          T *u[9], *s[3], *v[9];
+          for (int d = 0; d != 9; ++d) {
+            a[d] = &tv(FOffset + d, base);
+            u[d] = us[d];
+            v[d] = vs[d];
+          }
+          for (int d = 0; d != 3; ++d) s[d] = ss[d];
+          math::svd_3d_lanes(cnt, a, u, s, v);
+
+          T *logJp = nullptr;
+          if constexpr (require_logJp) logJp = &tv(logJpOffset, base);
+          T *f[9], *p[9];
+          for (int d = 0; d != 9; ++d) {
+            f[d] = &tv(FOffset + d, base);
+            p[d] = &tv(POffset + d, base);
+          }
+#if defined(_OPENMP)
+#  pragma omp simd
+#endif
+          for (size_type i = 0; i < cnt; ++i) {
+            mat3 U, V;
+            vec3 S;
+            for (int d = 0; d != 9; ++d) {
+              U.val(d) = us[d][i];
+              V.val(d) = vs[d][i];
+            }
+            for (int d = 0; d != 3; ++d) S.val(d) = ss[d][i];
+            const auto P = fused_first_piola(model, pm, U, S, V,
+                                             require_logJp ? logJp + i : (T *)nullptr);
+            for (int d = 0; d != 9; ++d) p[d][i] = P.val(d);
+            if constexpr (has_plasticity) {
+              const auto Fe = diag_mul(U, S) * V.transpose();
+              for (int d = 0; d != 9; ++d) f[d][i] = Fe.val(d);
+            }
+          }
+        });
+      } else {
+        pol(range(n), [tv = view<space>(tv), model, pm, FOffset, POffset,
+                       logJpOffset] ZS_LAMBDA(size_type i) mutable {
+          auto [U, S, V] = math::svd(tv.pack(dim_c<3, 3>, FOffset, i));
+          T *logJp = nullptr;
+          if constexpr (require_logJp) logJp = &tv(logJpOffset, i);
+          tv.tuple(dim_c<3, 3>, POffset, i) = fused_first_piola(model, pm, U, S, V, logJp);
+          if constexpr (has_plasticity)
+            tv.tuple(dim_c<3, 3>, FOffset, i) = diag_mul(U, S) * V.transpose();
+        });
+      }
+    }
+  }  // namespace detail
+
+  /// @brief first piola stress P of every particle of [tv] from its deformation gradient F
+  /// @note fuses the svd and the energy derivative in one pass, F is read and P written once per
+  /// particle. On host a whole tile is decomposed at once (math::svd_3d_lanes).
+  template <typename ExecPol, typename Model, typename T, size_t Length, typename Allocator>
+  void evaluate_stress(ExecPol &&pol, const IsotropicConstitutiveModelInterface<Model> &model,
+                       TileVector<T, Length, Allocator> &tv, const SmallString &FTag,
+                       const SmallString &PTag) {
+    detail::evaluate_stress_impl(FWD(pol), static_cast<const Model &>(model),
+                                 detail::no_plasticity{}, tv, FTag, PTag, SmallString{});
+  }
+  /// @brief elasto-plastic variant, F is projected back to the yield surface (return mapping)
+  /// and overwritten by its elastic part before P is evaluated, all within the same pass.
+  /// @note [logJpTag] names the (1-channel) hardening state required by NonAssociativeCamClay
+  template <typename ExecPol, typename Model, typename Plasticity, typename T, size_t Length,
+            typename Allocator>
+  void evaluate_stress(ExecPol &&pol, const IsotropicConstitutiveModelInterface<Model> &model,
+                       const PlasticityModelInterface<Plasticity> &plasticity,
+                       TileVector<T, Length, Allocator> &tv, const SmallString &FTag,
+                       const SmallString &PTag, const SmallString &logJpTag = "logJp") {
+    detail::evaluate_stress_impl(FWD(pol), static_cast<const Model &>(model),
+                                 static_cast<const Plasticity &>(plasticity), tv, FTag, PTag,
+                                 logJpTag);
+  }
+
+}  // namespace zs
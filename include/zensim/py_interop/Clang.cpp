@@ -5,21 +5,31 @@
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/ExecutionEngine/GenericValue.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/InitializePasses.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
 #if ZS_LLVM_VERSION_MAJOR < 18
 #include <llvm/Support/Host.h>
 #else
 #include <llvm/TargetParser/Host.h>
 #endif
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/xxhash.h>
+#include <llvm/Target/TargetMachine.h>
 
 #include "zensim/io/Filesystem.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -56,23 +66,120 @@ namespace {
     }
     llvm::orc::LLJIT *_jit = nullptr;
   };
+
+  /// code generation settings of a single compilation
+  struct JitSettings {
+    int optLevel{3};
+    std::string cpu{}, cacheDir{};
+    std::vector<std::string> features{};
+  };
+
+  /// code generation options, initialized from ZPC_JIT_OPT_LEVEL (0-3, default 3), ZPC_JIT_CPU
+  /// ("native" by default, "generic" for portable objects) and ZPC_JIT_CACHE_DIR (an empty
+  /// string disables the object cache)
+  struct JitOptions : JitSettings {
+    static JitOptions &instance() {
+      static JitOptions s_instance{};
+      return s_instance;
+    }
+    void setCpu(const std::string &name) {
+      features.clear();
+      if (name.empty() || name == "native") {
+        cpu = llvm::sys::getHostCPUName().str();
+        llvm::StringMap<bool> hostFeatures;
+#if ZS_LLVM_VERSION_MAJOR < 19
+        if (!llvm::sys::getHostCPUFeatures(hostFeatures)) hostFeatures.clear();
+#else
+        hostFeatures = llvm::sys::getHostCPUFeatures();
+#endif
+        for (const auto &feature : hostFeatures)
+          features.push_back((feature.second ? "+" : "-") + feature.first().str());
+        // keep the key (hence the cache) independent of the hash map order
+        std::sort(features.begin(), features.end());
+      } else
+        cpu = name;
+    }
+
+    /// a copy taken under the lock, compilations do not hold it
+    JitSettings snapshot() {
+      std::lock_guard<std::mutex> lk(mutex);
+      return static_cast<const JitSettings &>(*this);
+    }
+
+    std::mutex mutex{};
+
+  private:
+    JitOptions() {
+      if (const char *level = std::getenv("ZPC_JIT_OPT_LEVEL"))
+        optLevel = std::max(0, std::min(3, std::atoi(level)));
+      const char *cpuName = std::getenv("ZPC_JIT_CPU");
+      setCpu(cpuName ? cpuName : "native");
+      if (const char *dir = std::getenv("ZPC_JIT_CACHE_DIR"))
+        cacheDir = dir;
+      else {
+        llvm::SmallString<256> tmp;
+        llvm::sys::path::system_temp_directory(true, tmp);
+        llvm::sys::path::append(tmp, "zpc_jit_cache");
+        cacheDir = std::string(tmp);
+      }
+    }
+  };
+
+  llvm::OptimizationLevel to_optimization_level(int level) {
+    switch (level) {
+      case 0:
+        return llvm::OptimizationLevel::O0;
+      case 1:
+        return llvm::OptimizationLevel::O1;
+      case 2:
+        return llvm::OptimizationLevel::O2;
+      default:
+        return llvm::OptimizationLevel::O3;
+    }
+  }
+
+  /// content-addressed object name, covering everything that affects the emitted object
+  /// @note the (per program) input path is left out, identical sources share the cached object
+  std::string object_cache_key(const std::vector<const char *> &args, const char *input_file,
+                               const char *cpp_src) {
+    std::string key = LLVM_VERSION_STRING;
+    key += '\0';
+    for (const char *arg : args)
+      if (arg != input_file) (key += arg) += '\0';
+    key += cpp_src;
+    // headers under the include directory are versioned by the zpc build they ship with
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(zs::abs_module_path(), status))
+      key += std::to_string(status.getLastModificationTime().time_since_epoch().count());
+    const auto h0 = llvm::xxHash64(key);
+    const auto h1 = llvm::xxHash64(key + std::to_string(key.size()));
+    return llvm::utohexstr(h0, true) + llvm::utohexstr(h1, true);
+  }
 }
 
 namespace zs {
 
-  static std::unique_ptr<llvm::Module> compile_cpp_to_llvm(const std::string &input_file,
-                                                           const char *cpp_src,
-                                                           const char *include_dir,
-                                                           llvm::LLVMContext &context) {
+  static std::vector<const char *> compile_cpp_args(const std::string &input_file,
+                                                   const char *include_dir,
+                                                   const JitSettings &options) {
+    static const char *s_opt_flags[] = {"-O0", "-O1", "-O2", "-O3"};
     std::vector<const char *> args;
     args.push_back("-x");
     args.push_back("c++");
     args.push_back(input_file.c_str());
+    args.push_back("-target-cpu");
+    args.push_back(options.cpu.c_str());
+    for (const auto &feature : options.features) {
+      args.push_back("-target-feature");
+      args.push_back(feature.c_str());
+    }
 
 #if defined(ZS_ENABLE_OPENMP) && ZS_ENABLE_OPENMP
     args.push_back("-fopenmp");
 #endif
-    args.push_back("-O3");
+    args.push_back(s_opt_flags[options.optLevel]);
+    // the middle end runs afterwards with the target machine (see optimize_module)
+    args.push_back("-disable-llvm-passes");
     args.push_back("-I");
     args.push_back(include_dir);
     args.push_back("-std=c++17");
@@ -83,7 +190,13 @@ namespace zs {
     args.push_back("-DPYZPC_EXEC_TAG=::zs::seq_c");
 #endif
     args.push_back("-DZPC_JIT_MODE");
+    return args;
+  }
 
+  static std::unique_ptr<llvm::Module> compile_cpp_to_llvm(const std::vector<const char *> &args,
+                                                           const std::string &input_file,
+                                                           const char *cpp_src,
+                                                           llvm::LLVMContext &context) {
     clang::IntrusiveRefCntPtr<clang::DiagnosticOptions> diagnostic_options
         = new clang::DiagnosticOptions();
     std::unique_ptr<clang::TextDiagnosticPrinter> text_diagnostic_printer
@@ -120,6 +233,26 @@ namespace zs {
     return success ? std::move(emit_llvm_only_action.takeModule()) : nullptr;
   }
 
+  /// the default per-module pipeline of the new pass manager, with the target machine informing
+  /// the cost models (e.g. vector widths for the vectorizers)
+  static void optimize_module(llvm::Module &module, llvm::TargetMachine *target_machine,
+                              int opt_level) {
+    if (opt_level <= 0) return;
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pass_builder(target_machine);
+    pass_builder.registerModuleAnalyses(mam);
+    pass_builder.registerCGSCCAnalyses(cgam);
+    pass_builder.registerFunctionAnalyses(fam);
+    pass_builder.registerLoopAnalyses(lam);
+    pass_builder.crossRegisterProxies(lam, fam, cgam, mam);
+    llvm::ModulePassManager mpm
+        = pass_builder.buildPerModuleDefaultPipeline(to_optimization_level(opt_level));
+    mpm.run(module, mam);
+  }
+
 }  // namespace zs
 
 extern "C" {
@@ -136,10 +269,22 @@ ZENSIM_EXPORT int cpp_compile_program(const char *cpp_src, const char *include_d
       = std::string(output_file).substr(0, std::strlen(output_file) - std::strlen(obj_ext));
 
   (void)LLVM::instance();
+  const auto options = JitOptions::instance().snapshot();
+
+  const auto args = zs::compile_cpp_args(input_file, include_dir, options);
+  std::string cached_file{};
+  if (!options.cacheDir.empty()) {
+    llvm::SmallString<256> path{options.cacheDir};
+    llvm::sys::path::append(path, object_cache_key(args, input_file.c_str(), cpp_src) + obj_ext);
+    cached_file = std::string(path);
+    // a failed copy falls back to compiling the program
+    if (llvm::sys::fs::exists(cached_file) && !llvm::sys::fs::copy_file(cached_file, output_file))
+      return 0;
+  }
 
   llvm::LLVMContext context;
   std::unique_ptr<llvm::Module> module
-      = zs::compile_cpp_to_llvm(input_file, cpp_src, include_dir, context);
+      = zs::compile_cpp_to_llvm(args, input_file, cpp_src, context);
 
   if (!module) {
     return -1;
@@ -149,16 +294,30 @@ ZENSIM_EXPORT int cpp_compile_program(const char *cpp_src, const char *include_d
   std::string Error;
   const llvm::Target *target = llvm::TargetRegistry::lookupTarget(target_triple, Error);
 
-  const char *CPU = "generic";
-  const char *features = "";
+  std::string features = llvm::join(options.features, ",");
   llvm::TargetOptions target_options;
   llvm::Reloc::Model relocation_model = llvm::Reloc::PIC_;  // DLLs need Position Independent Code
   llvm::CodeModel::Model code_model
       = llvm::CodeModel::Large;  // Don't make assumptions about displacement sizes
-  llvm::TargetMachine *target_machine = target->createTargetMachine(
-      target_triple, CPU, features, target_options, relocation_model, code_model);
+#if ZS_LLVM_VERSION_MAJOR < 18
+  using codegen_level_t = llvm::CodeGenOpt::Level;
+  namespace codegen_levels = llvm::CodeGenOpt;
+#else
+  using codegen_level_t = llvm::CodeGenOptLevel;
+  using codegen_levels = llvm::CodeGenOptLevel;
+#endif
+  codegen_level_t codegen_level = options.optLevel == 0   ? codegen_levels::None
+                                  : options.optLevel == 1 ? codegen_levels::Less
+                                  : options.optLevel == 2 ? codegen_levels::Default
+                                                          : codegen_levels::Aggressive;
+  llvm::TargetMachine *target_machine
+      = target->createTargetMachine(target_triple, options.cpu, features, target_options,
+                                    relocation_model, code_model, codegen_level);
 
   module->setDataLayout(target_machine->createDataLayout());
+  module->setTargetTriple(target_triple);
+
+  zs::optimize_module(*module, target_machine, options.optLevel);
 
   std::error_code error_code;
   llvm::raw_fd_ostream output(output_file, error_code, llvm::sys::fs::OF_None);
@@ -176,6 +335,26 @@ ZENSIM_EXPORT int cpp_compile_program(const char *cpp_src, const char *include_d
 
   delete target_machine;
 
+  // publish through a unique temporary, concurrent processes may compile the same program
+  if (!cached_file.empty() && !error_code
+      && !llvm::sys::fs::create_directories(options.cacheDir)) {
+    llvm::SmallString<256> tmp;
+    if (!llvm::sys::fs::createUniqueFile(cached_file + ".%%%%%%", tmp)
+        && !llvm::sys::fs::copy_file(output_file, tmp))
+      if (llvm::sys::fs::rename(tmp, cached_file)) llvm::sys::fs::remove(tmp);
+  }
+
+  return 0;
+}
+
+/// @brief override the code generation options (see JitOptions) for later compilations
+/// @note a negative [opt_level] or a null string keeps the current setting
+ZENSIM_EXPORT int jit_configure(int opt_level, const char *cpu, const char *cache_dir) {
+  auto &options = JitOptions::instance();
+  std::lock_guard<std::mutex> lk(options.mutex);
+  if (opt_level >= 0) options.optLevel = opt_level > 3 ? 3 : opt_level;
+  if (cpu) options.setCpu(cpu);
+  if (cache_dir) options.cacheDir = cache_dir;
   return 0;
 }
 
@@ -1,6 +1,9 @@
 #include "Resource.h"
 
-#include "zensim/execution/Concurrency.h"
+#include <mutex>
+#include <unordered_map>
+
+#include "zensim/execution/ConcurrencyPrimitive.hpp"
 #include "zensim/memory/MemoryResource.h"
 
 namespace zs {
@@ -8,8 +11,114 @@ namespace zs {
   template struct ZPC_TEMPLATE_EXPORT ZSPmrAllocator<false, byte>;
   template struct ZPC_TEMPLATE_EXPORT ZSPmrAllocator<true, byte>;
 
-  static std::shared_mutex g_resource_rw_mutex{};
-  static concurrent_map<void *, Resource::AllocationRecord> g_resource_records;
+  namespace detail {
+    std::atomic<bool> g_allocationTracking{false};
+    std::atomic<size_t> g_numAllocationRecords{0};
+  }  // namespace detail
+
+  namespace {
+    /// counters are updated without locks, the peak is maintained by cas
+    struct alignas(64) StatCounters {
+      std::atomic<size_t> liveBytes{0}, peakBytes{0}, numLive{0}, numAllocations{0};
+
+      void add(size_t bytes) noexcept {
+        const auto cur = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = peakBytes.load(std::memory_order_relaxed);
+        while (cur > peak
+               && !peakBytes.compare_exchange_weak(peak, cur, std::memory_order_relaxed));
+        numLive.fetch_add(1, std::memory_order_relaxed);
+        numAllocations.fetch_add(1, std::memory_order_relaxed);
+      }
+      void sub(size_t bytes) noexcept {
+        liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        numLive.fetch_sub(1, std::memory_order_relaxed);
+      }
+      void resetPeak() noexcept {
+        peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      void accumulate(Resource::AllocationStats &stats) const noexcept {
+        stats.liveBytes += liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes += peakBytes.load(std::memory_order_relaxed);
+        stats.numLive += numLive.load(std::memory_order_relaxed);
+        stats.numAllocations += numAllocations.load(std::memory_order_relaxed);
+      }
+    };
+
+    /// the registry is split by address, so that concurrent (de)allocations rarely contend
+    constexpr size_t g_num_record_shards = 64;
+    struct alignas(64) RecordShard {
+      Mutex mutex{};
+      std::unordered_map<void *, Resource::AllocationRecord> records{};
+    };
+    RecordShard g_recordShards[g_num_record_shards];
+
+    constexpr size_t shard_index(const void *ptr, size_t numShards) noexcept {
+      // allocations are at least 16-byte aligned
+      auto v = (u64)(std::uintptr_t)ptr >> 4;
+      v *= (u64)0x9E3779B97F4A7C15ull;
+      return (size_t)(v >> 32) % numShards;
+    }
+
+    /// statistics keyed by rarely changing keys (telemetry tags, call sites)
+    template <typename Key, typename Hash = std::hash<Key>> struct ShardedStats {
+      static constexpr size_t num_shards = 16;
+      struct alignas(64) Shard {
+        Mutex mutex{};
+        std::unordered_map<Key, StatCounters, Hash> stats{};
+      };
+      StatCounters &acquire(const Key &key) {
+        auto &shard = _shards[Hash{}(key) % num_shards];
+        std::lock_guard<Mutex> lk(shard.mutex);
+        // nodes are not relocated upon rehashing
+        return shard.stats[key];
+      }
+      template <typename F> void forEach(F &&f) {
+        for (auto &shard : _shards) {
+          std::lock_guard<Mutex> lk(shard.mutex);
+          for (auto &[key, counters] : shard.stats) f(key, counters);
+        }
+      }
+      Shard _shards[num_shards];
+    };
+    struct CallSiteHash {
+      size_t operator()(const std::pair<const char *, u32> &site) const noexcept {
+        return std::hash<const char *>{}(site.first) ^ ((size_t)site.second * 0x9E3779B1u);
+      }
+    };
+
+    /// [-1, max) devices are tracked individually, the rest share the last slot
+    constexpr int g_max_tracked_devices = 16;
+    StatCounters g_locationStats[3][g_max_tracked_devices + 1];
+    ShardedStats<const char *> g_tagStats;
+    ShardedStats<std::pair<const char *, u32>, CallSiteHash> g_callSiteStats;
+
+    std::atomic<bool> g_trackCallSites{false};
+    thread_local const char *g_statTag = nullptr;
+
+    StatCounters &location_stats(memsrc_e mre, ProcID devid) noexcept {
+      int slot = (int)devid + 1;
+      if (slot < 0 || slot > g_max_tracked_devices) slot = g_max_tracked_devices;
+      return g_locationStats[(int)mre][slot];
+    }
+    void account(const Resource::AllocationRecord &r, bool allocate) {
+      const memsrc_e mre = match([](auto tag) { return RM_CVREF_T(tag)::value; })(r.tag);
+      auto update = [&r, allocate](StatCounters &c) {
+        if (allocate)
+          c.add(r.size);
+        else
+          c.sub(r.size);
+      };
+      update(location_stats(mre, r.devid));
+      if (r.statTag) update(g_tagStats.acquire(r.statTag));
+      if (r.file) update(g_callSiteStats.acquire(std::make_pair(r.file, r.line)));
+    }
+  }  // namespace
+
+  void track_allocation(const MemoryLocation &location, void *ptr, size_t bytes, size_t alignment,
+                        const source_location &loc) {
+    Resource::instance().record(location, ptr, std::string_view{}, bytes, alignment, loc);
+  }
+  void track_deallocation(void *ptr) { Resource::instance().erase(ptr); }
 
 #if 0
   static Resource g_resource;
@@ -45,13 +154,13 @@ namespace zs {
 #endif
   }
   Resource::~Resource() {
-    for (auto &&record : g_resource_records) {
-      const auto &[ptr, info] = record;
-      fmt::print("recycling allocation [{}], tag [{}], size [{}], alignment [{}], allocator [{}]\n",
-                 (std::uintptr_t)ptr,
-                 match([](auto &tag) { return get_memory_tag_name(tag); })(info.tag), info.size,
-                 info.alignment, info.allocatorType);
-    }
+    for (auto &shard : g_recordShards)
+      for (auto &&[ptr, info] : shard.records)
+        fmt::print(
+            "recycling allocation [{}], tag [{}], size [{}], alignment [{}], allocator [{}]\n",
+            (std::uintptr_t)ptr,
+            match([](auto &tag) { return get_memory_tag_name(tag); })(info.tag), info.size,
+            info.alignment, info.allocatorType);
 #if 0
 #  if ZS_ENABLE_CUDA
     deinitialize_backend(cuda_c);
@@ -69,20 +178,113 @@ namespace zs {
 #endif
   }
   void Resource::record(mem_tags tag, void *ptr, std::string_view name, size_t size,
-                        size_t alignment) {
-    g_resource_records.set(ptr, AllocationRecord{tag, size, alignment, std::string(name)});
+                        size_t alignment, const source_location &loc) {
+    const memsrc_e mre = match([](auto t) { return RM_CVREF_T(t)::value; })(tag);
+    record(MemoryLocation{mre, mre == memsrc_e::host ? (ProcID)-1 : (ProcID)0}, ptr, name, size,
+           alignment, loc);
+  }
+  void Resource::record(const MemoryLocation &location, void *ptr, std::string_view name,
+                        size_t size, size_t alignment, const source_location &loc) {
+    const bool trackSite = g_trackCallSites.load(std::memory_order_relaxed);
+    AllocationRecord r{location.getTag(),
+                       size,
+                       alignment,
+                       std::string(name),
+                       location.devid(),
+                       g_statTag,
+                       trackSite ? loc.file_name() : nullptr,
+                       trackSite ? (u32)loc.line() : 0u};
+    account(r, true);
+    auto &shard = g_recordShards[shard_index(ptr, g_num_record_shards)];
+    std::unique_lock<Mutex> lk(shard.mutex);
+    auto [it, inserted] = shard.records.try_emplace(ptr, r);
+    if (inserted)
+      detail::g_numAllocationRecords.fetch_add(1, std::memory_order_relaxed);
+    else {
+      // a stale record (freed without being erased)
+      auto prev = zs::move(it->second);
+      it->second = zs::move(r);
+      lk.unlock();
+      account(prev, false);
+    }
+  }
+  void Resource::erase(void *ptr) {
+    auto &shard = g_recordShards[shard_index(ptr, g_num_record_shards)];
+    std::unique_lock<Mutex> lk(shard.mutex);
+    if (auto it = shard.records.find(ptr); it != shard.records.end()) {
+      auto r = zs::move(it->second);
+      shard.records.erase(it);
+      detail::g_numAllocationRecords.fetch_sub(1, std::memory_order_relaxed);
+      lk.unlock();
+      account(r, false);
+    }
   }
-  void Resource::erase(void *ptr) { g_resource_records.erase(ptr); }
 
   void Resource::deallocate(void *ptr) {
-    if (g_resource_records.find(ptr) != nullptr) {
-      std::unique_lock lk(g_resource_rw_mutex);
-      const auto &r = g_resource_records.get(ptr);
-      match([&r, ptr](auto &tag) { zs::deallocate(tag, ptr, r.size, r.alignment); })(r.tag);
-    } else
-      throw std::runtime_error(
-          fmt::format("allocation record {} not found in records!", (std::uintptr_t)ptr));
-    g_resource_records.erase(ptr);
+    auto &shard = g_recordShards[shard_index(ptr, g_num_record_shards)];
+    AllocationRecord r{};
+    {
+      std::lock_guard<Mutex> lk(shard.mutex);
+      auto it = shard.records.find(ptr);
+      if (it == shard.records.end())
+        throw std::runtime_error(
+            fmt::format("allocation record {} not found in records!", (std::uintptr_t)ptr));
+      r = zs::move(it->second);
+      shard.records.erase(it);
+      detail::g_numAllocationRecords.fetch_sub(1, std::memory_order_relaxed);
+    }
+    match([&r, ptr](auto &tag) { zs::deallocate(tag, ptr, r.size, r.alignment); })(r.tag);
+    account(r, false);
+  }
+
+  Resource::TagScope::TagScope(const char *tag) noexcept : _prevTag{g_statTag} {
+    g_statTag = tag;
+  }
+  Resource::TagScope::~TagScope() { g_statTag = _prevTag; }
+
+  void Resource::enable_tracking(bool enable, bool trackCallSites) noexcept {
+    g_trackCallSites.store(trackCallSites, std::memory_order_relaxed);
+    detail::g_allocationTracking.store(enable, std::memory_order_relaxed);
+  }
+  bool Resource::tracking_enabled() noexcept { return allocation_tracking_enabled(); }
+
+  Resource::AllocationStats Resource::stats(memsrc_e mre) noexcept {
+    AllocationStats ret{};
+    size_t peak = 0;
+    for (auto &c : g_locationStats[(int)mre]) {
+      c.accumulate(ret);
+      peak = std::max(peak, c.peakBytes.load(std::memory_order_relaxed));
+    }
+    // peaks of different devices are not simultaneous
+    ret.peakBytes = std::max(peak, ret.liveBytes);
+    return ret;
+  }
+  Resource::AllocationStats Resource::stats(memsrc_e mre, ProcID devid) noexcept {
+    AllocationStats ret{};
+    location_stats(mre, devid).accumulate(ret);
+    return ret;
+  }
+  Resource::AllocationStats Resource::stats(std::string_view tag) {
+    AllocationStats ret{};
+    g_tagStats.forEach([&ret, tag](const char *key, StatCounters &c) {
+      if (tag == key) c.accumulate(ret);
+    });
+    return ret;
+  }
+  std::vector<Resource::CallSiteStats> Resource::call_site_stats() {
+    std::vector<CallSiteStats> ret;
+    g_callSiteStats.forEach([&ret](const auto &site, StatCounters &c) {
+      CallSiteStats entry{site.first, site.second};
+      c.accumulate(entry.stats);
+      ret.push_back(entry);
+    });
+    return ret;
+  }
+  void Resource::reset_peaks() noexcept {
+    for (auto &cs : g_locationStats)
+      for (auto &c : cs) c.resetPeak();
+    g_tagStats.forEach([](const char *, StatCounters &c) { c.resetPeak(); });
+    g_callSiteStats.forEach([](const auto &, StatCounters &c) { c.resetPeak(); });
   }
 
 }  // namespace zs
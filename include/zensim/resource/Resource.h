@@ -27,6 +27,23 @@
 
 namespace zs {
 
+  namespace detail {
+    ZPC_API extern std::atomic<bool> g_allocationTracking;
+    ZPC_API extern std::atomic<size_t> g_numAllocationRecords;
+  }  // namespace detail
+
+  /// allocation telemetry hooks of ZSPmrAllocator, see Resource::enable_tracking
+  inline bool allocation_tracking_enabled() noexcept {
+    return detail::g_allocationTracking.load(std::memory_order_relaxed);
+  }
+  /// recorded allocations are still erased after tracking is disabled
+  inline bool allocation_records_pending() noexcept {
+    return detail::g_numAllocationRecords.load(std::memory_order_relaxed) != 0;
+  }
+  ZPC_API void track_allocation(const MemoryLocation &location, void *ptr, size_t bytes,
+                                size_t alignment, const source_location &loc);
+  ZPC_API void track_deallocation(void *ptr);
+
   template <bool is_virtual_ = false, typename T = byte> struct ZPC_API ZSPmrAllocator {
     using value_type = T;
     using size_type = size_t;
@@ -53,10 +70,16 @@ namespace zs {
     }
 
     constexpr resource_type *resource() noexcept { return res.get(); }
-    [[nodiscard]] void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
-      return res->allocate(bytes, alignment);
+    constexpr const resource_type *resource() const noexcept { return res.get(); }
+    [[nodiscard]] void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t),
+                                 const source_location &loc = source_location::current()) {
+      void *ret = res->allocate(bytes, alignment);
+      if (ret && allocation_tracking_enabled())
+        track_allocation(location, ret, bytes, alignment, loc);
+      return ret;
     }
     void deallocate(void *p, size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+      if (p && allocation_records_pending()) track_deallocation(p);
       res->deallocate(p, bytes, alignment);
     }
     bool is_equal(const ZSPmrAllocator &other) const noexcept {
@@ -231,6 +254,13 @@ namespace zs {
         })(tag);
         // ret.setNonOwningUpstream<raw_memory_resource>(tag);
       }
+    } else if (mre == memsrc_e::host) {
+      if (page_memory_resource<host_mem_tag>::is_option(advice))
+        // page backing and numa placement (e.g. "HUGE_PAGE|INTERLEAVE"), [devid] a numa node
+        ret.setOwningUpstream<page_memory_resource>(mem_host, devid, std::string{advice});
+      else
+        // device advices (e.g. "READ_MOSTLY") do not apply to host memory
+        ret.setOwningUpstream<default_memory_resource>(mem_host, devid);
     } else
       match([&ret, &advice, devid](auto tag) {
         if constexpr (is_memory_source_available(tag) || is_same_v<RM_CVREF_T(tag), mem_tags>)
@@ -307,15 +337,59 @@ namespace zs {
       mem_tags tag{};
       size_t size{0}, alignment{0};
       std::string allocatorType{};
+      ProcID devid{-1};
+      /// telemetry tag (see TagScope) and call site
+      const char *statTag{nullptr};
+      const char *file{nullptr};
+      u32 line{0};
+    };
+    /// live/peak bytes are exact at any time, peaks include transient allocations
+    struct AllocationStats {
+      size_t liveBytes{0}, peakBytes{0};
+      size_t numLive{0}, numAllocations{0};
     };
+    struct CallSiteStats {
+      const char *file{nullptr};
+      u32 line{0};
+      AllocationStats stats{};
+    };
+    /// allocations made by this thread within the scope are accounted under [tag]
+    /// @note [tag] should outlive the registry, e.g. a string literal
+    struct TagScope {
+      explicit TagScope(const char *tag) noexcept;
+      ~TagScope();
+      TagScope(const TagScope &) = delete;
+      TagScope &operator=(const TagScope &) = delete;
+
+    private:
+      const char *_prevTag;
+    };
+
     Resource();
     ~Resource();
 
-    void record(mem_tags tag, void *ptr, std::string_view name, size_t size, size_t alignment);
+    void record(mem_tags tag, void *ptr, std::string_view name, size_t size, size_t alignment,
+                const source_location &loc = source_location::current());
+    void record(const MemoryLocation &location, void *ptr, std::string_view name, size_t size,
+                size_t alignment, const source_location &loc = source_location::current());
     void erase(void *ptr);
 
     void deallocate(void *ptr);
 
+    /// @brief record every ZSPmrAllocator allocation (off by default)
+    /// @note per-call-site statistics additionally cost a lookup per allocation
+    static void enable_tracking(bool enable = true, bool trackCallSites = false) noexcept;
+    static bool tracking_enabled() noexcept;
+
+    /// statistics of all recorded allocations in [mre], optionally of device [devid] only
+    static AllocationStats stats(memsrc_e mre) noexcept;
+    static AllocationStats stats(memsrc_e mre, ProcID devid) noexcept;
+    /// statistics of the recorded allocations made within a TagScope of [tag]
+    static AllocationStats stats(std::string_view tag);
+    static std::vector<CallSiteStats> call_site_stats();
+    /// peaks restart from the current live bytes
+    static void reset_peaks() noexcept;
+
   private:
     mutable std::atomic_ullong _counter{0};
   };
@@ -1,7 +1,30 @@
 #include "zensim/omp/execution/ExecutionPolicy.hpp"
 
+#include "zensim/memory/BulkMemOps.hpp"
+
 namespace zs {
 
+  namespace {
+    /// large host copies and fills (Resource::copy/memset, Vector growth...) use all threads,
+    /// unless issued from within a parallel region already or with a single thread available
+    void omp_host_bulk_copy(void *dst, const void *src, size_t size) {
+      if (omp_in_parallel() || omp_get_max_threads() == 1)
+        std::memcpy(dst, src, size);
+      else
+        bulk_copy(omp_exec(), dst, src, size);
+    }
+    void omp_host_bulk_memset(void *addr, int chval, size_t size) {
+      if (omp_in_parallel() || omp_get_max_threads() == 1)
+        std::memset(addr, chval, size);
+      else
+        bulk_memset(omp_exec(), addr, chval, size);
+    }
+    [[maybe_unused]] const bool g_ompHostBulkMemOpsRegistered = [] {
+      set_host_bulk_memops(omp_host_bulk_copy, omp_host_bulk_memset, detail::bulk_parallel_bytes);
+      return true;
+    }();
+  }  // namespace
+
   ZPC_API ZSPmrAllocator<> get_temporary_memory_source(const OmpExecutionPolicy &pol) {
     return get_memory_source(memsrc_e::host, (ProcID)-1);
   }
@@ -4,6 +4,7 @@
 #include "zensim/execution/Atomics.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
 #include "zensim/geometry/Collider.h"
+#include "zensim/geometry/SparseLevelSet.hpp"
 #include "zensim/geometry/Structure.hpp"
 
 namespace zs {
@@ -93,7 +94,7 @@ namespace zs {
       value_type mass = block(0, cellid);
       if (mass != (value_type)0) {
         mass = (value_type)1 / mass;
-        TV vel = block.pack<grids_t::dim>(1, cellid) * mass + extf * dt;
+        TV vel = block.template pack<grids_t::dim>(1, cellid) * mass + extf * dt;
         /// write back
         // for (int d = 0; d != grids_t::dim; ++d) block(1 + d, cellid) = vel[d];
         block.set(1, cellid, vel);
@@ -139,7 +140,7 @@ namespace zs {
       auto block = grids[blockid];
 
       if (block(0, cellid) > 0) {
-        auto vel = block.pack<grids_t::dim>(1, cellid);
+        auto vel = block.template pack<grids_t::dim>(1, cellid);
         auto pos = (blockkey * (value_type)grids_t::side_length + grids_t::cellid_to_coord(cellid))
                    * grids._dx;
 
@@ -198,7 +199,7 @@ namespace zs {
       value_type mass = block(mChn, cellid);
       if (mass != (value_type)0) {
         mass = (value_type)1 / mass;
-        auto vel = block.pack<dim>(mvChn, cellid) * mass;
+        auto vel = block.template pack<dim>(mvChn, cellid) * mass;
         /// write back
         // for (int d = 0; d != grids_t::dim; ++d) block(1 + d, cellid) = vel[d];
         block.set(mvChn, cellid, vel);
@@ -239,7 +240,7 @@ namespace zs {
         auto x = (blockkey * (value_type)grid_view_t::side_length
                   + grid_view_t::cellid_to_coord(cellid))
                  * grid.dx;
-        auto mv = block.pack<dim>(mvChn, cellid);
+        auto mv = block.template pack<dim>(mvChn, cellid);
         /// x cross mv;
         if constexpr (dim == 3) {
           auto res = x.cross(mv);
@@ -289,7 +290,7 @@ namespace zs {
       auto block = grids[blockid];
 
       if (block(0, cellid) > 0) {
-        auto vel = block.pack<grids_t::dim>(1, cellid);
+        auto vel = block.template pack<grids_t::dim>(1, cellid);
         auto pos = (blockkey * (value_type)grids_t::side_length + grids_t::cellid_to_coord(cellid))
                    * grids._dx;
 
@@ -0,0 +1,334 @@
+#pragma once
+#include "zensim/container/HashTable.hpp"
+#include "zensim/execution/Atomics.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+#include "zensim/geometry/Structure.hpp"
+#include "zensim/geometry/Structurefree.hpp"
+#include "zensim/profile/CppTimers.hpp"
+#include "zensim/simulation/grid/GridOp.hpp"
+#include "zensim/simulation/mpm/Simulator.hpp"
+#include "zensim/simulation/sparsity/SparsityOp.hpp"
+#include "zensim/simulation/transfer/G2P.hpp"
+#include "zensim/simulation/transfer/P2G.hpp"
+
+namespace zs {
+
+  /// @brief explicit (symplectic euler, apic) time integration driver of a MPMSimulator
+  /// @note partitions, grid blocks and particle sorting buffers are recycled across steps. Each
+  /// substep only reads back the active block count and the max grid velocity from the device.
+  struct ExplicitMPMSystem {
+    enum stage_e : int { rebuild_stage = 0, resort_stage, p2g_stage, grid_stage, g2p_stage,
+                         num_stages };
+    struct Statistics {
+      double stageTimes[num_stages]{};  ///< accumulated wall time (ms) per stage
+      double totalTime{0};              ///< accumulated wall time (ms)
+      size_t numSubsteps{0};
+      size_t numParticleSteps{0};  ///< sum of particle counts over all substeps
+
+      /// particles * steps per second
+      double throughput() const noexcept {
+        return totalTime > 0 ? (double)numParticleSteps / (totalTime * 1e-3) : 0.;
+      }
+    };
+
+    explicit ExplicitMPMSystem(MPMSimulator& simulator) : simulator{simulator} {
+      sortBuffers.resize(simulator.particles.size());
+      blockKeys.resize(simulator.particles.size());
+    }
+
+    /// @brief largest admissible substep from the sound speed and the current max velocity
+    float suggestDt() const {
+      const auto dx = simulator.simOptions.dx;
+      const auto cfl = simulator.simOptions.cfl;
+      float dt = simulator.evaluatedDt;
+      float maxVelSqr = 0.f;
+      for (size_t partI = 0; partI != simulator.numPartitions(); ++partI)
+        if (auto v = simulator.getMaxVel(partI); v > maxVelSqr) maxVelSqr = v;
+      if (maxVelSqr > 0.f)
+        if (auto v = cfl * dx / std::sqrt(maxVelSqr); v < dt) dt = v;
+      return dt;
+    }
+
+    /// @brief advance the simulation by [dt] in (adaptive) substeps
+    /// @return number of substeps taken
+    template <class ExecutionPolicy> int step(ExecutionPolicy&& policy, float dt) {
+      if (!(dt > 0.f) || !std::isfinite(dt))
+        throw std::runtime_error(
+            fmt::format("[ExplicitMPMSystem] step size {} should be positive and finite", dt));
+      if (!initialized) {
+        for (size_t partI = 0; partI != simulator.numPartitions(); ++partI)
+          initMaxVel(policy, partI);
+        initialized = true;
+      }
+      int numSubsteps = 0;
+      for (float remaining = dt; remaining > 0.f; ++numSubsteps) {
+        float subdt = suggestDt();
+        if (!(subdt > 0.f))
+          throw std::runtime_error(
+              fmt::format("[ExplicitMPMSystem] degenerate substep {}", subdt));
+        if (subdt >= remaining)
+          subdt = remaining;
+        else if (subdt * 2 > remaining)  // avoid a tiny trailing substep
+          subdt = remaining * 0.5f;
+        for (size_t partI = 0; partI != simulator.numPartitions(); ++partI)
+          substep(policy, partI, subdt);
+        remaining -= subdt;
+        curTime += subdt;
+        stats.numSubsteps++;
+      }
+      return numSubsteps;
+    }
+
+    /// seed the max velocity from particles so that the first substep respects cfl
+    template <class ExecutionPolicy> void initMaxVel(ExecutionPolicy&& policy, size_t partI) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      simulator.maxVelSqrNorms[partI].setVal(0.f);
+      for (auto&& [modelId, objId] : simulator.groups[partI])
+        match([&policy, maxVel = simulator.maxVelPtr(partI)](auto& obj) {
+          if (!obj.hasAttr("v")) return;
+          policy(range(obj.size()), [vel = view<space>(obj.attrVector("v")),
+                                     maxVel] ZS_LAMBDA(typename RM_CVREF_T(obj)::size_type i) {
+            atomic_max(wrapv<space>{}, maxVel, (float)vel[i].l2NormSqr());
+          });
+        })(simulator.particles[objId]);
+    }
+
+    template <class ExecutionPolicy>
+    void substep(ExecutionPolicy&& policy, size_t partI, float dt) {
+      match(
+          [&, this](auto& partition, auto& grids)
+              -> enable_if_type<RM_CVREF_T(partition)::dim == 3
+                                && RM_CVREF_T(grids)::dim == 3> {
+            CppTimer timer;
+            auto timed = [this, &timer](stage_e stage, auto&& f) {
+              timer.tick();
+              f();
+              timer.tock();
+              stats.stageTimes[stage] += timer.elapsed();
+              stats.totalTime += timer.elapsed();
+            };
+            timed(rebuild_stage, [&] { rebuildPartition(policy, partI, partition, grids); });
+            timed(resort_stage, [&] { resortParticles(policy, partI, partition, grids); });
+            timed(p2g_stage, [&] { p2g(policy, partI, partition, grids, dt); });
+            timed(grid_stage, [&] { updateGrid(policy, partI, partition, grids, dt); });
+            timed(g2p_stage, [&] { g2p(policy, partI, partition, grids, dt); });
+            for (auto&& [modelId, objId] : simulator.groups[partI])
+              stats.numParticleSteps
+                  += match([](auto& obj) -> size_t { return obj.size(); })(
+                      simulator.particles[objId]);
+          },
+          [](...) {
+            throw std::runtime_error("[ExplicitMPMSystem] only 3d partitions are supported");
+          })(simulator.partitions[partI], simulator.grids[partI]);
+    }
+
+    /// @brief reset and refill the partition in place, then fit grid blocks to it
+    template <class ExecutionPolicy, typename TableT, typename GridsT>
+    void rebuildPartition(ExecutionPolicy&& policy, size_t partI, TableT& partition,
+                          GridsT& grids) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      constexpr auto execTag = wrapv<space>{};
+      constexpr int dim = TableT::dim;
+      const auto dx = simulator.simOptions.dx;
+      partition.reset(policy, true);
+      // block orders of the previous partition are stale
+      for (auto&& [modelId, objId] : simulator.groups[partI]) blockKeys[objId].resize(0);
+      for (auto&& [modelId, objId] : simulator.groups[partI])
+        match(
+            [&](auto& obj) -> enable_if_type<RM_CVREF_T(obj)::dim == dim> {
+              // block of the (quadratic) stencil corner
+              policy(range(obj.size()), ComputeSparsity{execTag, dx, (int)GridsT::side_length,
+                                                        partition, obj.attrVector("x"), -1});
+            },
+            [](...) {})(simulator.particles[objId]);
+      // the stencil may reach into the (+) neighbors, which at most multiplies entries by 2^dim
+      auto nbs = partition.size();
+      if (partition.evaluateTableSize(nbs << dim) > (size_t)partition._tableSize)
+        partition.resize(policy, nbs << dim);
+      policy(range(nbs), EnlargeSparsity{execTag, partition, vec<int, dim>::constant(0),
+                                         vec<int, dim>::constant(2)});
+      nbs = partition.size();
+      grids.grid().resize(nbs);
+      policy(Collapse{(size_t)nbs, (size_t)GridsT::block_space()},
+             CleanGridBlocks{execTag, grids});
+    }
+
+    /// @brief reorder particle attributes by their owning block for coherent transfers
+    /// @note the sorted block numbers are kept for the blocked p2g of the same substep
+    template <class ExecutionPolicy, typename TableT, typename GridsT>
+    void resortParticles(ExecutionPolicy&& policy, size_t partI, TableT& partition, GridsT&) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      const auto dx = simulator.simOptions.dx;
+      for (auto&& [modelId, objId] : simulator.groups[partI])
+        match(
+            [&, this, objId = objId](auto& obj)
+                -> enable_if_type<RM_CVREF_T(obj)::dim == TableT::dim> {
+              using particles_t = RM_CVREF_T(obj);
+              using size_type = typename particles_t::size_type;
+              using TV = typename particles_t::TV;
+              constexpr int side_length = GridsT::side_length;
+              const size_type n = obj.size();
+              if (n == 0) return;
+              for (auto buf : {&keys, &sortedKeys, &indices, &sortedIndices})
+                if (buf->memoryLocation() == obj.memoryLocation())
+                  buf->resize(n);
+                else
+                  *buf = Vector<u32>{obj.get_allocator(), n};
+              policy(range(n), [pos = view<space>(obj.attrVector("x")),
+                                partition = proxy<space>(partition), keys = view<space>(keys),
+                                indices = view<space>(indices),
+                                dx] ZS_LAMBDA(size_type i) mutable {
+                auto arena = make_local_arena(dx, TV{pos[i]});
+                auto [blockno, loc] = unpack_coord_in_grid(arena.corner, side_length, partition);
+                keys[i] = (u32)blockno;
+                indices[i] = (u32)i;
+              });
+              radix_sort_pair(policy, keys.begin(), indices.begin(), sortedKeys.begin(),
+                              sortedIndices.begin(), n);
+              std::swap(sortedKeys, blockKeys[objId]);
+              // gather into the recycled buffers then swap them in
+              auto& buffer = sortBuffers[objId];
+              if (!std::holds_alternative<particles_t>(buffer)
+                  || std::get<particles_t>(buffer).memoryLocation() != obj.memoryLocation())
+                buffer = particles_t{obj.get_allocator(), n};
+              auto& dstParticles = std::get<particles_t>(buffer);
+              for (auto&& [name, attrib] : obj.attrs()) {
+                if (!dstParticles.hasAttr(name))
+                  dstParticles.addAttr(name, particles_t::get_attribute_enum(attrib));
+              }
+              dstParticles.resize(n);
+              for (auto&& [name, attrib] : obj.attrs()) {
+                auto& dstAttrib = dstParticles.attr(name);
+                match(
+                    [&](auto& src, auto& dst)
+                        -> enable_if_type<is_same_v<RM_CVREF_T(src), RM_CVREF_T(dst)>> {
+                      policy(range(n), [src = view<space>(src), dst = view<space>(dst),
+                                        perm = view<space>(sortedIndices)] ZS_LAMBDA(
+                                           size_type i) mutable { dst[i] = src[perm[i]]; });
+                      std::swap(src, dst);
+                    },
+                    [](...) {})(attrib, dstAttrib);
+              }
+            },
+            [](...) {})(simulator.particles[objId]);
+    }
+
+    template <class ExecutionPolicy, typename TableT, typename GridsT>
+    void p2g(ExecutionPolicy&& policy, size_t partI, TableT& partition, GridsT& grids, float dt) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      constexpr auto execTag = wrapv<space>{};
+      if (grids.grid().numChannels() < 1 + GridsT::dim * 2)
+        throw std::runtime_error("[ExplicitMPMSystem] grid requires (m, mv, f * dt) channels");
+      forEachModel(partI, [&](auto& model, auto& obj, size_t objId) {
+        if constexpr (is_host_execution<space>()) {
+          // particles are still in the block order of resortParticles
+          const auto& keys = blockKeys[objId];
+          if (auto drops = p2g_transfer_blocked(policy, wrapv<transfer_scheme_e::apic>{}, dt,
+                                                model, obj, partition, grids,
+                                                keys.size() == obj.size() ? &keys : nullptr))
+            throw std::runtime_error(
+                fmt::format("[ExplicitMPMSystem] {} particles and {} grid cells fell outside of "
+                            "the partition",
+                            drops.numParticles, drops.numHaloCells));
+        } else
+          policy(range(obj.size()), P2GTransfer{execTag, wrapv<transfer_scheme_e::apic>{}, dt,
+                                                model, obj, partition, grids});
+      });
+    }
+
+    /// @brief momentum to velocity (with forces and gravity), then boundary conditions
+    template <class ExecutionPolicy, typename TableT, typename GridsT>
+    void updateGrid(ExecutionPolicy&& policy, size_t partI, TableT& partition, GridsT& grids,
+                    float dt) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      constexpr auto execTag = wrapv<space>{};
+      constexpr int dim = GridsT::dim;
+      using grids_t = RM_CVREF_T(proxy<space>(grids));
+      using value_type = typename grids_t::value_type;
+      using TV = vec<value_type, dim>;
+      const size_t nbs = partition.size();
+      simulator.maxVelSqrNorms[partI].setVal(0.f);
+      TV extf{};
+      for (int d = 0; d != dim; ++d) extf[d] = gravity[d] * dt;
+      policy(Collapse{nbs, (size_t)GridsT::block_space()},
+             [grids = proxy<space>(grids), extf, maxVel = simulator.maxVelPtr(partI)] ZS_LAMBDA(
+                 typename grids_t::size_type blockid,
+                 typename grids_t::cell_index_type cellid) mutable {
+               auto block = grids[blockid];
+               value_type mass = block(0, cellid);
+               if (mass != (value_type)0) {
+                 TV vel = (block.template pack<dim>(1, cellid)
+                           + block.template pack<dim>(1 + dim, cellid))
+                              / mass
+                          + extf;
+                 block.set(1, cellid, vel);
+                 atomic_max(wrapv<space>{}, maxVel, (float)vel.l2NormSqr());
+               }
+             });
+      for (auto& boundary : simulator.boundaries)
+        match(
+            [&](auto& collider)
+                -> enable_if_type<RM_CVREF_T(collider)::dim == dim
+                                  && !is_levelset_boundary<RM_CVREF_T(collider)>::value> {
+              policy(Collapse{nbs, (size_t)GridsT::block_space()},
+                     ApplyBoundaryConditionOnGridBlocks{execTag, collider, partition, grids,
+                                                        curTime});
+            },
+            [&](auto& boundary)
+                -> enable_if_type<is_levelset_boundary<RM_CVREF_T(boundary)>::value
+                                  && RM_CVREF_T(boundary)::dim == dim> {
+              if (!valid_memspace_for_execution(policy, boundary.levelset.get_allocator()))
+                throw std::runtime_error(
+                    "[ExplicitMPMSystem] level set boundary not accessible by the policy");
+              // sampled through a view, with the motion of the boundary
+              Collider collider{proxy<space>(boundary.levelset), boundary.type};
+              collider.s = boundary.s;
+              collider.dsdt = boundary.dsdt;
+              collider.setRotation(boundary.R, boundary.omega);
+              collider.setTranslation(boundary.b, boundary.dbdt);
+              policy(Collapse{nbs, (size_t)GridsT::block_space()},
+                     ApplyBoundaryConditionOnGridBlocks{execTag, collider, partition, grids,
+                                                        curTime});
+            },
+            [](...) {})(boundary);
+    }
+
+    template <class ExecutionPolicy, typename TableT, typename GridsT>
+    void g2p(ExecutionPolicy&& policy, size_t partI, TableT& partition, GridsT& grids, float dt) {
+      constexpr execspace_e space = RM_REF_T(policy)::exec_tag::value;
+      constexpr auto execTag = wrapv<space>{};
+      forEachModel(partI, [&](auto& model, auto& obj, size_t) {
+        policy(range(obj.size()), G2PTransfer{execTag, wrapv<transfer_scheme_e::apic>{}, dt,
+                                              model, grids, partition, obj});
+      });
+    }
+
+    /// invoke f(model, particles, objId) for every 3d particle group of the partition
+    template <typename F> void forEachModel(size_t partI, F&& f) {
+      for (auto&& [modelId, objId] : simulator.groups[partI]) {
+        auto& [model, objId_] = simulator.models[modelId];
+        if (objId_ != objId)
+          throw std::runtime_error("[ExplicitMPMSystem] model-object id conflicts, error build");
+        match([&f, objId = objId](auto& constitutiveModel, auto& obj)
+                  -> enable_if_type<RM_CVREF_T(obj)::dim == 3> {
+                f(constitutiveModel, obj, objId);
+              },
+              [](...) {})(model, simulator.particles[objId]);
+      }
+    }
+
+    MPMSimulator& simulator;
+    vec<float, 3> gravity{0.f, -9.8f, 0.f};
+    float curTime{0.f};
+    Statistics stats{};
+
+  protected:
+    bool initialized{false};
+    /// recycled sorting buffers
+    Vector<u32> keys{}, sortedKeys{}, indices{}, sortedIndices{};
+    std::vector<GeneralParticles> sortBuffers{};
+    /// block number of every (sorted) particle per object, valid until the partition is rebuilt
+    std::vector<Vector<u32>> blockKeys{};
+  };
+
+}  // namespace zs
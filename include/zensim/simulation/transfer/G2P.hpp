@@ -60,7 +60,7 @@ namespace zs {
           auto xixp = arena.diff(loc);
           float W = arena.weight(loc);
 
-          vec3 vi = grid_block.pack<particles_t::dim>(1, grids_t::coord_to_cellid(local_index));
+          vec3 vi = grid_block.template pack<particles_t::dim>(1, grids_t::coord_to_cellid(local_index));
           vel += vi * W;
           for (int d = 0; d < 9; ++d) C[d] += W * vi(d % 3) * xixp(d / 3) * D_inv;
         }
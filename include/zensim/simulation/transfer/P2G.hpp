@@ -42,20 +42,15 @@ namespace zs {
 
     constexpr float dxinv() const { return static_cast<decltype(grids._dx)>(1.0) / grids._dx; }
 
-    constexpr void operator()(typename particles_t::size_type parid) noexcept {
-      float const dx = grids._dx;
+    /// @brief stress contribution (already scaled by -dt * D^-1) of a particle
+    /// @note also updates logJp for plasticity models
+    constexpr auto stress_contrib(typename particles_t::size_type parid) noexcept {
+      using vec9 = vec<float, particles_t::dim * particles_t::dim>;
+      vec9 contrib{vec9::zeros()};
       float const dx_inv = dxinv();
       if constexpr (particles_t::dim == 3) {
         float const D_inv = 4.f * dx_inv * dx_inv;
-        using ivec3 = vec<int, particles_t::dim>;
-        using vec3 = vec<float, particles_t::dim>;
-        using vec9 = vec<float, particles_t::dim * particles_t::dim>;
-        using vec3x3 = vec<float, particles_t::dim, particles_t::dim>;
-
-        vec3 local_pos{particles.pos(parid)};
-        vec3 vel{particles.vel(parid)};
-        float mass = particles.mass(parid);
-        vec9 contrib{vec9::zeros()}, C{particles.C(parid)};
+        vec9 C{particles.C(parid)};
 
         if constexpr (is_same_v<model_t, EquationOfStateConfig>) {
           float J = particles.J(parid);
@@ -102,6 +97,21 @@ namespace zs {
         }
 
         contrib = contrib * -dt * D_inv;
+      }
+      return contrib;
+    }
+
+    constexpr void operator()(typename particles_t::size_type parid) noexcept {
+      float const dx = grids._dx;
+      if constexpr (particles_t::dim == 3) {
+        using vec3 = vec<float, particles_t::dim>;
+        using vec9 = vec<float, particles_t::dim * particles_t::dim>;
+
+        vec3 local_pos{particles.pos(parid)};
+        vec3 vel{particles.vel(parid)};
+        float mass = particles.mass(parid);
+        vec9 C{particles.C(parid)};
+        vec9 contrib = stress_contrib(parid);
 
         using VT = typename grids_t::value_type;
         auto arena = make_local_arena((VT)dx, local_pos);
@@ -133,4 +143,213 @@ namespace zs {
     float dt;
   };
 
+  /// @brief contributions p2g_transfer_blocked could not deposit into the grid
+  template <typename SizeT> struct P2GDropCounts {
+    SizeT numParticles{0};  ///< particles whose stencil corner block is not in the partition
+    SizeT numHaloCells{0};  ///< halo cells carrying mass whose (+) neighbor block is missing
+    constexpr explicit operator bool() const noexcept { return numParticles || numHaloCells; }
+  };
+
+  ///
+  /// @brief atomic-free P2G for host backends
+  /// @note particles are radix-sorted by the grid block holding their stencil corner. Each block
+  /// then accumulates its particles into a thread-private buffer padded by the stencil halo, writes
+  /// the interior directly and stashes the halo. Halos are merged afterwards color by color, blocks
+  /// of the same coordinate parity never touch the same neighbor block.
+  /// @return P2GDropCounts of the particles outside of [table] and of the halo cells carrying
+  /// mass whose (+) neighbor block is not in [table], all their contributions are dropped. The
+  /// partition should hold the block of every particle and the (+) neighbors of every block.
+  /// @param sortedBlockKeys optional block number (in [table]) of every particle when the particles
+  /// are already ordered by it, e.g. the sorted keys of a preceding reorder. The sort is skipped.
+  ///
+  template <typename ExecPol, transfer_scheme_e scheme, typename ModelT, typename ParticlesT,
+            typename TableT, typename GridsT>
+  auto p2g_transfer_blocked(ExecPol &&pol, wrapv<scheme>, float dt, const ModelT &model,
+                            ParticlesT &particles, TableT &table, GridsT &grids,
+                            const Vector<u32> *sortedBlockKeys = nullptr) {
+    constexpr execspace_e space = RM_REF_T(pol)::exec_tag::value;
+    static_assert(is_host_execution<space>(),
+                  "[p2g_transfer_blocked] thread-private block buffers require host execution");
+    static_assert(ParticlesT::dim == 3, "[p2g_transfer_blocked] only 3d transfer is supported");
+    using transfer_t = RM_CVREF_T(
+        P2GTransfer{wrapv<space>{}, wrapv<scheme>{}, dt, model, particles, table, grids});
+    using grids_t = typename transfer_t::grids_t;
+    using value_type = typename grids_t::value_type;
+    using size_type = typename ParticlesT::size_type;
+    constexpr int dim = ParticlesT::dim;
+    using ivec = vec<int, dim>;
+    using vec3 = vec<float, dim>;
+    using vec9 = vec<float, dim * dim>;
+    using arena_t = RM_CVREF_T(make_local_arena((value_type)1, vec3{}));
+
+    constexpr int side_length = grids_t::side_length;
+    constexpr int halo = arena_t::width - 1;
+    constexpr int padded_side = side_length + halo;
+    constexpr int padded_size = math::pow_integral(padded_side, dim);
+    constexpr int num_chns = 1 + dim + dim;  // m, mv, f * dt
+    constexpr int num_colors = 1 << dim;
+    static_assert(halo <= side_length, "stencil halo should not exceed a grid block");
+
+    auto transfer = transfer_t{wrapv<space>{}, wrapv<scheme>{}, dt, model, particles, table, grids};
+    const size_type n = particles.size();
+    const size_type nbs = table.size();
+    if (n == 0 || nbs == 0) return P2GDropCounts<size_type>{nbs == 0 ? n : 0, 0};
+
+    const bool presorted = sortedBlockKeys != nullptr;
+    if (presorted
+        && (sortedBlockKeys->size() != n
+            || !valid_memspace_for_execution(pol, sortedBlockKeys->get_allocator())))
+      throw std::runtime_error(
+          "[p2g_transfer_blocked] sorted block keys do not match the particles or the policy");
+
+    auto allocator = get_temporary_memory_source(pol);
+    /// sort particles by their owning block, unless they already are
+    const size_type numSorted = presorted ? 0 : n;
+    Vector<u32> keys{allocator, numSorted}, sortedKeys{allocator, numSorted};
+    Vector<size_type> indices{allocator, numSorted}, sortedIndices{allocator, numSorted};
+    if (!presorted) {
+      pol(range(n), [transfer, keys = view<space>(keys),
+                     indices = view<space>(indices)](size_type parid) mutable {
+        auto arena = make_local_arena(transfer.grids._dx, vec3{transfer.particles.pos(parid)});
+        auto [blockno, loc] = unpack_coord_in_grid(arena.corner, side_length, transfer.partition);
+        // particles outside of the partition are sorted to the end and skipped
+        keys[parid] = (u32)blockno;
+        indices[parid] = parid;
+      });
+      radix_sort_pair(pol, keys.begin(), indices.begin(), sortedKeys.begin(),
+                      sortedIndices.begin(), n);
+    }
+    Vector<size_type> blockSts{allocator, nbs}, blockEds{allocator, nbs}, numInside{allocator, 1};
+    blockSts.reset(0);
+    blockEds.reset(0);
+    numInside.setVal(0);
+    const auto &blockKeys = presorted ? *sortedBlockKeys : sortedKeys;
+    pol(range(n), [keys = view<space>(blockKeys), blockSts = view<space>(blockSts),
+                   blockEds = view<space>(blockEds), numInside = view<space>(numInside), n,
+                   nbs](size_type i) mutable {
+      const auto key = keys[i];
+      if (key >= nbs) return;
+      if (i == 0 || keys[i - 1] != key) blockSts[key] = i;
+      if (i == n - 1 || keys[i + 1] != key) {
+        blockEds[key] = i + 1;
+        if (i == n - 1 || keys[i + 1] >= nbs) numInside[0] = i + 1;
+      }
+    });
+    P2GDropCounts<size_type> drops{n - numInside.getVal(), 0};
+
+    /// only blocks holding particles stash a halo
+    Vector<size_type> marks{allocator, nbs}, haloIds{allocator, nbs};
+    pol(range(nbs), [blockSts = view<space>(blockSts), blockEds = view<space>(blockEds),
+                     marks = view<space>(marks)](size_type blockno) mutable {
+      marks[blockno] = blockEds[blockno] != blockSts[blockno] ? 1 : 0;
+    });
+    exclusive_scan(pol, std::begin(marks), std::end(marks), std::begin(haloIds));
+    const size_type numHaloBlocks = haloIds.getVal(nbs - 1) + marks.getVal(nbs - 1);
+
+    /// accumulate per block, interior goes to the grid, halo is stashed
+    Vector<value_type> halos{allocator, (size_t)numHaloBlocks * num_chns * padded_size};
+    pol(range(nbs), [transfer, indices = view<space>(sortedIndices),
+                     blockSts = view<space>(blockSts), blockEds = view<space>(blockEds),
+                     haloIds = view<space>(haloIds), halos = view<space>(halos),
+                     presorted](size_type blockno) mutable {
+      if (blockSts[blockno] == blockEds[blockno]) return;
+      value_type buf[num_chns][padded_size];
+      for (int c = 0; c != num_chns; ++c)
+        for (int i = 0; i != padded_size; ++i) buf[c][i] = 0;
+      const ivec blockOrigin = transfer.partition._activeKeys[blockno] * side_length;
+      const auto dx = transfer.grids._dx;
+
+      for (auto i = blockSts[blockno]; i != blockEds[blockno]; ++i) {
+        const auto parid = presorted ? i : indices[i];
+        vec3 vel{transfer.particles.vel(parid)};
+        float mass = transfer.particles.mass(parid);
+        vec9 C{transfer.particles.C(parid)};
+        vec9 contrib = transfer.stress_contrib(parid);
+
+        auto arena = make_local_arena(dx, vec3{transfer.particles.pos(parid)});
+        for (auto loc : arena.range()) {
+          const auto local = arena.coord(loc) - blockOrigin;
+          int offset = 0;
+          for (int d = 0; d != dim; ++d) offset = offset * padded_side + local[d];
+          auto xixp = arena.diff(loc);
+          value_type W = arena.weight(loc);
+          buf[0][offset] += mass * W;
+          for (int d = 0; d != dim; ++d) {
+            buf[1 + d][offset]
+                += W * mass * (vel[d] + (C[d] * xixp[0] + C[3 + d] * xixp[1] + C[6 + d] * xixp[2]));
+            buf[1 + dim + d][offset]
+                += (contrib[d] * xixp[0] + contrib[3 + d] * xixp[1] + contrib[6 + d] * xixp[2]) * W;
+          }
+        }
+      }
+
+      auto block = transfer.grids.block(blockno);
+      auto stash = halos.data() + (size_t)haloIds[blockno] * num_chns * padded_size;
+      for (int offset = 0; offset != padded_size; ++offset) {
+        ivec local{};
+        bool interior = true;
+        for (int d = dim - 1, o = offset; d >= 0; --d, o /= padded_side) {
+          local[d] = o % padded_side;
+          if (local[d] >= side_length) interior = false;
+        }
+        if (interior) {
+          const auto cellid = grids_t::coord_to_cellid(local);
+          for (int c = 0; c != num_chns; ++c) block(c, cellid) += buf[c][offset];
+        } else
+          for (int c = 0; c != num_chns; ++c) stash[c * padded_size + offset] = buf[c][offset];
+      }
+    });
+
+    /// merge halos into the (+) neighbor blocks, one block color at a time
+    Vector<size_type> cellDrops{allocator, nbs};
+    cellDrops.reset(0);
+    for (int color = 0; color != num_colors; ++color)
+      pol(range(nbs), [transfer, halos = view<space>(halos), cellDrops = view<space>(cellDrops),
+                       blockSts = view<space>(blockSts), blockEds = view<space>(blockEds),
+                       haloIds = view<space>(haloIds), color](size_type blockno) mutable {
+        if (blockSts[blockno] == blockEds[blockno]) return;
+        const ivec blockKey = transfer.partition._activeKeys[blockno];
+        int blockColor = 0;
+        for (int d = 0; d != dim; ++d) blockColor = (blockColor << 1) | (blockKey[d] & 1);
+        if (blockColor != color) return;
+        const auto stash = halos.data() + (size_t)haloIds[blockno] * num_chns * padded_size;
+        size_type numDropped = 0;
+        for (int nb = 1; nb != num_colors; ++nb) {
+          ivec dir{};
+          for (int d = 0; d != dim; ++d) dir[d] = (nb >> (dim - 1 - d)) & 1;
+          // cells of the padded buffer that land in this neighbor
+          ivec lo{}, hi{};
+          for (int d = 0; d != dim; ++d) {
+            lo[d] = dir[d] ? side_length : 0;
+            hi[d] = dir[d] ? padded_side : side_length;
+          }
+          const auto neighborNo = transfer.partition.query(blockKey + dir);
+          if (neighborNo < 0) {
+            for (int i = lo[0]; i != hi[0]; ++i)
+              for (int j = lo[1]; j != hi[1]; ++j)
+                for (int k = lo[2]; k != hi[2]; ++k)
+                  if (stash[(i * padded_side + j) * padded_side + k] != 0) ++numDropped;
+            continue;
+          }
+          auto block = transfer.grids.block(neighborNo);
+          for (int i = lo[0]; i != hi[0]; ++i)
+            for (int j = lo[1]; j != hi[1]; ++j)
+              for (int k = lo[2]; k != hi[2]; ++k) {
+                const int offset = (i * padded_side + j) * padded_side + k;
+                const auto cellid = grids_t::coord_to_cellid(
+                    ivec{i - dir[0] * side_length, j - dir[1] * side_length,
+                         k - dir[2] * side_length});
+                for (int c = 0; c != num_chns; ++c)
+                  block(c, cellid) += stash[c * padded_size + offset];
+              }
+        }
+        cellDrops[blockno] = numDropped;
+      });
+    Vector<size_type> numDropped{allocator, 1};
+    reduce(pol, std::begin(cellDrops), std::end(cellDrops), std::begin(numDropped),
+           (size_type)0);
+    drops.numHaloCells = numDropped.getVal();
+    return drops;
+  }
+
 }  // namespace zs
\ No newline at end of file
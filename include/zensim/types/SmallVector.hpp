@@ -111,6 +111,24 @@ namespace zs {
     int numChannels;
   };
 
+  /// resolved property (channel offset and channel count)
+  /// @note obtained once on host through resolve(name), then captured by kernels in place of the
+  /// property name to skip the per-access name lookup
+  struct PropertyHandle {
+    int offset{-1};
+    int size{0};
+    constexpr bool valid() const noexcept { return offset >= 0; }
+    constexpr explicit operator bool() const noexcept { return valid(); }
+  };
+
+/// name-based element access performs a linear search over the property names on every call
+#if ZS_WARN_NAMED_PROPERTY_ACCESS
+#  define ZS_NAMED_PROPERTY_ACCESS \
+    [[deprecated("resolve the property once (resolve(name)) and access by PropertyHandle")]]
+#else
+#  define ZS_NAMED_PROPERTY_ACCESS
+#endif
+
 #if ZS_ENABLE_SERIALIZATION
   template <typename S> void serialize(S &s, PropertyTag &tag) {
     tag.name.serialize(s);
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/BarrierAssembly.hpp"
+
+int main() {
+  using namespace zs;
+  DEF_POLICY
+  using vec3 = vec<double, 3>;
+  using ivec4 = vec<int, 4>;
+  using mat3 = vec<double, 3, 3>;
+  using spmat_t = SparseMatrix<mat3, true, int, int>;
+
+  /// a triangle with a point above its interior and one next to an edge, two crossing edges and
+  /// two nearly parallel edges (mollified)
+  const std::vector<vec3> positions{{0, 0, 0},          {1, 0, 0},         {0, 1, 0},
+                                    {0.2, 0.2, 0.05},   {0.5, -0.05, 0.03}, {0.3, 0.3, 0.1},
+                                    {0.3, 0.6, 0.12},   {0.1, 0.45, 0.15}, {0.6, 0.45, 0.16},
+                                    {2, 0, 0},          {3, 0, 0},         {2.2, 0.0005, 0.04},
+                                    {3.1, 0.0015, 0.04}};
+  const int nv = (int)positions.size();
+  Vector<vec3> xs{(size_t)nv};
+  for (int i = 0; i != nv; ++i) xs[i] = positions[i];
+  const auto xsRest = xs.clone(xs.get_allocator());
+  Vector<ivec4> PT{2}, EE{2};
+  PT[0] = ivec4{3, 0, 1, 2};
+  PT[1] = ivec4{4, 0, 1, 2};
+  EE[0] = ivec4{5, 6, 7, 8};
+  EE[1] = ivec4{9, 10, 11, 12};
+  const double dHat = 0.1, kappa = 1;
+
+  BarrierContacts<double> contacts{};
+  contacts.classify(pol, xs, xsRest, PT, EE, dHat);
+  const auto numMollified = contacts.size(barrier_contact_e::ppm)
+                            + contacts.size(barrier_contact_e::pem)
+                            + contacts.size(barrier_contact_e::eem);
+  if (contacts.size() != 4 || contacts.size(barrier_contact_e::pt) != 1
+      || contacts.size(barrier_contact_e::pe) != 1 || contacts.size(barrier_contact_e::ee) != 1
+      || numMollified != 1)
+    throw std::runtime_error("barrier contacts misclassified");
+
+  /// dense block pattern over all vertices
+  std::vector<int> is, js;
+  for (int i = 0; i != nv; ++i)
+    for (int j = 0; j != nv; ++j) {
+      is.push_back(i);
+      js.push_back(j);
+    }
+  spmat_t spmat{nv, nv};
+  spmat.build(pol, nv, nv, range(is.data(), is.data() + is.size()),
+              range(js.data(), js.data() + js.size()));
+  spmat._vals.resize(spmat.nnz());
+  contacts.build_scatter_map(pol, spmat);
+
+  /// exact (unprojected) derivatives, the classification stays fixed under the perturbation
+  auto energy = [&](const Vector<vec3> &x) {
+    return contacts.evaluate(pol, x, dHat, kappa, wrapv<false>{});
+  };
+  auto gradient = [&](const Vector<vec3> &x, Vector<vec3> &g) {
+    contacts.evaluate(pol, x, dHat, kappa, wrapv<false>{});
+    g.reset(0);
+    spmat._vals.reset(0);
+    contacts.scatter(pol, g, spmat);
+  };
+  Vector<vec3> g{(size_t)nv}, gp{(size_t)nv}, gm{(size_t)nv};
+  gradient(xs, g);
+  // scatter() accumulated the hessian of the unperturbed positions
+  const auto H = spmat._vals.clone(spmat._vals.get_allocator());
+  const auto spv = view<execspace_e::host>(spmat);
+
+  const double h = 1e-6;
+  double gradErr = 0, gradMax = 0, hessErr = 0, hessMax = 0;
+  auto xp = xs.clone(xs.get_allocator());
+  auto xm = xs.clone(xs.get_allocator());
+  for (int vj = 0; vj != nv; ++vj)
+    for (int d = 0; d != 3; ++d) {
+      xp[vj] = xs[vj];
+      xm[vj] = xs[vj];
+      xp[vj].val(d) += h;
+      xm[vj].val(d) -= h;
+      const double fd = (energy(xp) - energy(xm)) / (2 * h);
+      gradErr = std::max(gradErr, std::abs(fd - g[vj].val(d)));
+      gradMax = std::max(gradMax, std::abs(g[vj].val(d)));
+      // column (vj, d) of the hessian
+      gradient(xp, gp);
+      gradient(xm, gm);
+      for (int vi = 0; vi != nv; ++vi)
+        for (int c = 0; c != 3; ++c) {
+          const double fdH = (gp[vi].val(c) - gm[vi].val(c)) / (2 * h);
+          const double a = H[spv.locate(vi, vj)](c, d);
+          hessErr = std::max(hessErr, std::abs(fdH - a));
+          hessMax = std::max(hessMax, std::abs(a));
+        }
+      xp[vj] = xs[vj];
+      xm[vj] = xs[vj];
+    }
+  std::printf("gradient error %g (max %g), hessian error %g (max %g)\n", gradErr, gradMax,
+              hessErr, hessMax);
+  if (gradMax == 0 || gradErr > 1e-6 * gradMax)
+    throw std::runtime_error("barrier gradient does not match the energy");
+  if (hessMax == 0 || hessErr > 1e-5 * hessMax)
+    throw std::runtime_error("barrier hessian does not match the gradient");
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "utils/initialization.hpp"
+#include "zensim/math/matrix/BatchedSVD.hpp"
+#include "zensim/math/matrix/QRSVD.hpp"
+
+int main() {
+  using namespace zs;
+  DEF_POLICY
+  using mat3 = vec<float, 3, 3>;
+  using vec3 = vec<float, 3>;
+  const size_t n = 1 << 18;
+
+  TileVector<float, 32> tv{{{"F", 9}, {"U", 9}, {"S", 3}, {"V", 9}}, n};
+  {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-1, 1);
+    auto tvv = view<execspace_e::host>({}, tv);
+    for (size_t i = 0; i != n; ++i) {
+      mat3 F;
+      for (int k = 0; k != 9; ++k) F(k / 3, k % 3) = u(rng);
+      // include a few near-identity (deformation gradient like) and rank deficient matrices
+      if (i % 4 == 1) F = mat3::identity() + F * 0.05f;
+      if (i % 64 == 2)
+        for (int k = 0; k != 3; ++k) F(2, k) = F(0, k) + F(1, k);
+      tvv.tuple(dim_c<3, 3>, "F", i) = F;
+    }
+  }
+
+  /// batched_svd against the per-matrix math::svd kernel it replaces, with the same policy
+  using clock = std::chrono::steady_clock;
+  auto secs = [](auto d) { return std::chrono::duration<double>(d).count(); };
+  TileVector<float, 32> ref{{{"U", 9}, {"S", 3}, {"V", 9}}, n};
+  auto t0 = clock::now();
+  batched_svd(pol, tv, "F", "U", "S", "V");
+  auto t1 = clock::now();
+  pol(range(n), [tv = view<space>({}, tv), ref = view<space>({}, ref)](size_t i) mutable {
+    auto [U, S, V] = math::svd(tv.pack(dim_c<3, 3>, "F", i));
+    ref.tuple(dim_c<3, 3>, "U", i) = U;
+    ref.tuple(dim_c<3>, "S", i) = S;
+    ref.tuple(dim_c<3, 3>, "V", i) = V;
+  });
+  auto t2 = clock::now();
+  std::vector<vec3> Sq(n);
+  pol(range(n), [tv = view<space>({}, tv), &Sq](size_t i) mutable {
+    auto [U, S, V] = math::qr_svd(tv.pack(dim_c<3, 3>, "F", i));
+    Sq[i] = S;
+  });
+  auto t3 = clock::now();
+  std::printf("batched_svd %.3g, math::svd %.3g, math::qr_svd %.3g matrices/s\n",
+              n / secs(t1 - t0), n / secs(t2 - t1), n / secs(t3 - t2));
+
+  auto tvv = view<execspace_e::host>({}, tv);
+  auto refv = view<execspace_e::host>({}, ref);
+  double maxRecon = 0, maxOrtho = 0, maxDiff = 0;
+  for (size_t i = 0; i != n; ++i) {
+    const auto F = tvv.pack(dim_c<3, 3>, "F", i);
+    const auto U = tvv.pack(dim_c<3, 3>, "U", i);
+    const auto S = tvv.pack(dim_c<3>, "S", i);
+    const auto V = tvv.pack(dim_c<3, 3>, "V", i);
+    // lanes execute the scalar svd_3d instruction sequence
+    if (!(U == refv.pack(dim_c<3, 3>, "U", i)) || !(S == refv.pack(dim_c<3>, "S", i))
+        || !(V == refv.pack(dim_c<3, 3>, "V", i)))
+      throw std::runtime_error("batched_svd differs from math::svd");
+    const double scale = math::max(std::abs(Sq[i][0]), 1.f);
+    // reconstruction and orthonormality
+    const auto recon = diag_mul(U, S) * V.transpose();
+    maxRecon = math::max(maxRecon, (double)(recon - F).abs().max() / scale);
+    maxOrtho = math::max(maxOrtho, (double)(U.transpose() * U - mat3::identity()).abs().max());
+    maxOrtho = math::max(maxOrtho, (double)(V.transpose() * V - mat3::identity()).abs().max());
+    // U, V are rotations, the sign only goes to the smallest singular value
+    if (determinant(U) < 0 || determinant(V) < 0)
+      throw std::runtime_error("batched_svd produced a reflection");
+    if (!(S[0] >= S[1] && S[1] >= std::abs(S[2])))
+      throw std::runtime_error("batched_svd singular values are not ordered");
+    // singular values (with sign) agree with qr_svd
+    for (int d = 0; d != 3; ++d)
+      maxDiff = math::max(maxDiff, (double)std::abs(S[d] - Sq[i][d]) / scale);
+  }
+  std::printf("max reconstruction error %g, orthogonality error %g, singular value diff %g\n",
+              maxRecon, maxOrtho, maxDiff);
+  // svd_3d runs a fixed number of jacobi sweeps, it is less accurate than qr_svd
+  if (maxRecon > 5e-2 || maxOrtho > 1e-4 || maxDiff > 1e-3)
+    throw std::runtime_error("batched_svd disagrees with qr_svd");
+  return 0;
+}
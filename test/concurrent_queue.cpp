@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "zensim/execution/Concurrency.h"
+#include "zensim/io/IO.h"
+
+int main() {
+  using namespace zs;
+  constexpr int numProducers = 4, numConsumers = 4, numPerProducer = 100000;
+  constexpr int total = numProducers * numPerProducer;
+
+  /// every pushed item is popped exactly once, in push order per producer
+  auto checkMPMC = [&](auto &q, const char *name) {
+    std::vector<std::atomic<int>> seen(total);
+    for (auto &s : seen) s.store(0, std::memory_order_relaxed);
+    std::atomic<int> numPopped{0}, numDisorders{0};
+    std::vector<std::thread> ths;
+    for (int p = 0; p != numProducers; ++p)
+      ths.emplace_back([&, p]() {
+        for (int i = 0; i != numPerProducer; ++i) q.push(p * numPerProducer + i);
+      });
+    for (int c = 0; c != numConsumers; ++c)
+      ths.emplace_back([&]() {
+        std::vector<int> last(numProducers, -1);
+        for (;;) {
+          if (numPopped.load(std::memory_order_relaxed) >= total) break;
+          int v;
+          if (!q.try_pop(v)) {
+            std::this_thread::yield();
+            continue;
+          }
+          seen[v].fetch_add(1, std::memory_order_relaxed);
+          const int p = v / numPerProducer, i = v % numPerProducer;
+          if (i <= last[p]) numDisorders.fetch_add(1, std::memory_order_relaxed);
+          last[p] = i;
+          numPopped.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    for (auto &th : ths) th.join();
+    for (int i = 0; i != total; ++i)
+      if (seen[i].load() != 1) {
+        std::printf("%s: item %d popped %d times\n", name, i, seen[i].load());
+        std::fflush(stdout);
+        throw std::runtime_error("concurrent queue lost or duplicated an item");
+      }
+    if (numDisorders.load() != 0 || !q.empty())
+      throw std::runtime_error("concurrent queue reordered items of a producer");
+  };
+  {
+    // a small first segment exercises the segment growth
+    concurrent_queue<int> q{16};
+    checkMPMC(q, "concurrent_queue");
+  }
+  {
+    bounded_mpmc_queue<int> q{256};
+    checkMPMC(q, "bounded_mpmc_queue");
+  }
+
+  /// blocking pops across threads
+  {
+    threadsafe_queue<int> q;
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> ths;
+    for (int c = 0; c != numConsumers; ++c)
+      ths.emplace_back([&]() {
+        // a negative item is the signal to quit
+        for (int v = q.wait_and_pop(); v >= 0; v = q.wait_and_pop()) sum += v;
+      });
+    for (int i = 0; i != total; ++i) q.push(i);
+    for (int c = 0; c != numConsumers; ++c) q.push(-1);
+    for (auto &th : ths) th.join();
+    if (sum.load() != (long long)total * (total - 1) / 2)
+      throw std::runtime_error("concurrent queue wait_and_pop failed");
+  }
+
+  /// copies hold the queued items in order and leave the source untouched
+  {
+    concurrent_queue<int> q{4};
+    for (int i = 0; i != 100; ++i) q.push(i);
+    concurrent_queue<int> copy{q};
+    if (copy.size() != 100 || q.size() != 100)
+      throw std::runtime_error("concurrent queue copy has a wrong size");
+    for (int i = 0; i != 100; ++i)
+      if (copy.wait_and_pop() != i || q.wait_and_pop() != i)
+        throw std::runtime_error("concurrent queue copy is out of order");
+  }
+
+  /// IO::flush returns only after every inserted job has run
+  {
+    std::atomic<int> numDone{0};
+    for (int round = 0; round != 3; ++round) {
+      for (int i = 0; i != 8; ++i)
+        IO::insert_job([&numDone]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          numDone.fetch_add(1, std::memory_order_relaxed);
+        });
+      IO::flush();
+      if (numDone.load() != 8 * (round + 1))
+        throw std::runtime_error("IO::flush returned before the queued jobs finished");
+    }
+    // nothing pending
+    IO::flush();
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/FilteredCCD.hpp"
+
+int main() {
+  using namespace zs;
+  using vec3 = vec<double, 3>;
+  double toi = 0;
+  const vec3 f0{0, 0, 0}, f1{4, 0, 0}, f2{0, 4, 0};
+
+  /// a vertex crossing the face plane outside of the triangle
+  const vec3 vs{3, 3, 2}, ve{3, 3, -2};
+  if (vertexFaceFilteredCCD(vs, f0, f1, f2, ve, f0, f1, f2, toi))
+    throw std::runtime_error("vertex-face: separated query reported as a collision");
+  // too few box checks leave the query unresolved, the exact test still separates it
+  if (vertexFaceFilteredCCD(vs, f0, f1, f2, ve, f0, f1, f2, toi, 1., 1e-6, 4))
+    throw std::runtime_error("vertex-face: the exact fallback was not taken");
+  // coordinates beyond the exact path are reported conservatively
+  const vec3 offset{0.1, 0.1, 0.1};
+  if (!vertexFaceFilteredCCD(vs + offset, f0 + offset, f1 + offset, f2 + offset, ve + offset,
+                             f0 + offset, f1 + offset, f2 + offset, toi, 1., 1e-6, 4)
+      || toi != 0)
+    throw std::runtime_error("vertex-face: unresolved query not reported as a collision");
+
+  /// a vertex crossing the triangle at t = 0.5
+  const vec3 hs{1, 1, 2}, he{1, 1, -2};
+  if (!vertexFaceFilteredCCD(hs, f0, f1, f2, he, f0, f1, f2, toi) || toi > 0.5 || toi < 0.49)
+    throw std::runtime_error("vertex-face: missed the collision");
+  if (!vertexFaceFilteredCCD(hs, f0, f1, f2, he, f0, f1, f2, toi, 1., 1e-6, 4) || toi > 0.5)
+    throw std::runtime_error("vertex-face: unresolved collision not reported");
+
+  /// edge-edge, the moving edge crosses the static one at t = 0.5, or passes beyond its end
+  const vec3 a0{0, 0, 0}, a1{4, 0, 0};
+  for (double x : {1., 6.}) {
+    const vec3 b0s{x, -2, 1}, b1s{x, 2, 1}, b0e{x, -2, -1}, b1e{x, 2, -1};
+    const bool expected = x < 4;
+    for (int maxChecks : {100000, 4})
+      if (edgeEdgeFilteredCCD(a0, a1, b0s, b1s, a0, a1, b0e, b1e, toi, 1., 1e-6, maxChecks)
+              != expected
+          || (expected && toi > 0.5))
+        throw std::runtime_error(
+            fmt::format("edge-edge: wrong result for x = {} and {} checks", x, maxChecks));
+  }
+
+  /// batched minimum over candidate pairs
+  DEF_POLICY
+  Vector<vec3> xs{7}, xe{7};
+  const vec3 starts[7] = {f0, f1, f2, vs, hs, vec3{1, 1, 3}, vec3{9, 9, 9}};
+  const vec3 ends[7] = {f0, f1, f2, ve, he, vec3{1, 1, -1}, vec3{9, 9, 9}};
+  for (int i = 0; i != 7; ++i) {
+    xs[i] = starts[i];
+    xe[i] = ends[i];
+  }
+  Vector<vec<int, 4>> PT{3}, EE{0};
+  PT[0] = vec<int, 4>{3, 0, 1, 2};
+  PT[1] = vec<int, 4>{4, 0, 1, 2};
+  PT[2] = vec<int, 4>{5, 0, 1, 2};
+  const double minToi = ccd_min_toi(pol, xs, xe, PT, EE);
+  std::printf("ccd_min_toi %g\n", minToi);
+  // the third vertex reaches the face at t = 0.75, the second one at t = 0.5
+  if (minToi > 0.5 || minToi < 0.49) throw std::runtime_error("ccd_min_toi failed");
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "zensim/execution/ConcurrencyPrimitive.hpp"
+
+int main() {
+  using namespace zs;
+  constexpr int numWaiters = 8;
+
+  /// waiters parked on one address are woken one at a time, none is lost
+  for (int round = 0; round != 20; ++round) {
+    std::atomic<u32> word{0};
+    std::atomic<int> numReturned{0};
+    std::vector<std::thread> ths;
+    for (int i = 0; i != numWaiters; ++i)
+      ths.emplace_back([&]() {
+        Futex::wait(&word, 0);
+        numReturned.fetch_add(1);
+      });
+    int numWoken = 0;
+    // waiters not parked yet are not counted, keep waking until all of them were
+    while (numWoken != numWaiters) {
+      numWoken += Futex::wake(&word, 1);
+      std::this_thread::yield();
+    }
+    for (auto &th : ths) th.join();
+    if (numReturned.load() != numWaiters)
+      throw std::runtime_error("futex waiters were not all woken");
+  }
+
+  /// only waiters whose mask overlaps the wake mask are woken
+  {
+    std::atomic<u32> word{0};
+    std::atomic<int> numOdd{0}, numEven{0};
+    std::vector<std::thread> ths;
+    for (int i = 0; i != numWaiters; ++i)
+      ths.emplace_back([&, i]() {
+        Futex::wait(&word, 0, i % 2 ? 0b10 : 0b01);
+        (i % 2 ? numOdd : numEven).fetch_add(1);
+      });
+    int numWoken = 0;
+    while (numWoken != numWaiters / 2) {
+      numWoken += Futex::wake(&word, numWaiters, 0b10);
+      std::this_thread::yield();
+    }
+    if (numEven.load() != 0) throw std::runtime_error("futex woke a waiter of another mask");
+    while (numWoken != numWaiters) {
+      numWoken += Futex::wake(&word, numWaiters, 0b01);
+      std::this_thread::yield();
+    }
+    for (auto &th : ths) th.join();
+    if (numOdd.load() != numWaiters / 2 || numEven.load() != numWaiters / 2)
+      throw std::runtime_error("futex woke the wrong waiters");
+  }
+
+  /// timed waits racing against wakes, timed out waiters leave the queue intact
+  {
+    std::atomic<u32> word{0};
+    std::atomic<bool> stop{false};
+    std::atomic<int> numAwoken{0}, numTimedOut{0};
+    std::vector<std::thread> ths;
+    for (int i = 0; i != numWaiters; ++i)
+      ths.emplace_back([&]() {
+        for (int j = 0; j != 200; ++j) {
+          const auto res = Futex::wait_for(&word, 0, 1);
+          if (res == FutexResult::awoken)
+            numAwoken.fetch_add(1);
+          else if (res == FutexResult::timedout)
+            numTimedOut.fetch_add(1);
+        }
+      });
+    std::thread waker([&]() {
+      while (!stop.load()) {
+        Futex::wake(&word, 1);
+        std::this_thread::yield();
+      }
+    });
+    for (auto &th : ths) th.join();
+    stop.store(true);
+    waker.join();
+    std::printf("timed waits: %d awoken, %d timed out\n", numAwoken.load(), numTimedOut.load());
+    if (numAwoken.load() + numTimedOut.load() == 0)
+      throw std::runtime_error("futex timed waits did not return");
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <tuple>
+
+#include "utils/initialization.hpp"
+#include "zensim/io/GridIO.hpp"
+
+namespace {
+  using namespace zs;
+
+  /// largest decoding error of a channel spanning [range] under [quant]
+  double quant_tolerance(grid_quantization_e quant, double range) {
+    if (quant == grid_quantization_e::none) return 0;
+    const double maxq = quant == grid_quantization_e::q16 ? 65535. : 255.;
+    return range / maxq * 0.5 + 1e-6 * (1 + range);
+  }
+
+  /// every block overlapping the (inclusive) box is loaded with its values, others are absent
+  template <typename TableV, typename ValueF, typename LoadedTableV, typename LoadedValueF>
+  void check_layer(const char *name, size_t nbs, TableV table, ValueF value, size_t loadedNbs,
+                   LoadedTableV loadedTable, LoadedValueF loadedValue, int numChns, int blockSize,
+                   int extent, const vec<int, 3> *box, double tol) {
+    size_t numExpected = 0;
+    double maxErr = 0;
+    for (size_t bno = 0; bno != nbs; ++bno) {
+      const auto origin = table._activeKeys[bno];
+      bool expected = true;
+      for (int d = 0; d != 3 && box; ++d)
+        if (origin[d] + extent - 1 < box[0][d] || origin[d] > box[1][d]) expected = false;
+      const auto loaded = loadedTable.query(origin);
+      if ((loaded >= 0) != expected)
+        throw std::runtime_error(fmt::format("{}: block ({}, {}, {}) wrongly {}", name, origin[0],
+                                             origin[1], origin[2],
+                                             expected ? "dropped" : "loaded"));
+      if (!expected) continue;
+      ++numExpected;
+      for (int chn = 0; chn != numChns; ++chn)
+        for (int cno = 0; cno != blockSize; ++cno)
+          maxErr = std::max(maxErr, (double)std::abs(value(chn, bno, cno)
+                                                     - loadedValue(chn, loaded, cno)));
+    }
+    std::printf("%s: %zu of %zu blocks, max error %g (tolerance %g)\n", name, numExpected, nbs,
+                maxErr, tol);
+    if (numExpected != loadedNbs)
+      throw std::runtime_error(fmt::format("{}: {} blocks loaded, {} expected", name, loadedNbs,
+                                           numExpected));
+    if (maxErr > tol) throw std::runtime_error(fmt::format("{}: values not restored", name));
+  }
+}  // namespace
+
+int main() {
+  using namespace zs;
+  auto pol = omp_exec().threads(4);
+  using spg_t = SparseGrid<3, f32, 8>;
+  using ag_t = AdaptiveGridImpl<3, f32, index_sequence<2, 2, 2>, index_sequence<1, 1, 1>>;
+  using ivec3 = vec<int, 3>;
+  const std::vector<PropertyTag> tags{{"sdf", 1}, {"v", 3}};
+  constexpr int numChns = 4;
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> u(-1, 1);
+  // half of the cells are active, values span [-1, 1]
+  auto randomValue = [&]() { return rng() % 2 ? u(rng) : 0.f; };
+  const ivec3 box[2] = {ivec3{-8, 0, -8}, ivec3{7, 15, 7}};
+  const std::string filename = "grid_io_test.zsg";
+  const grid_quantization_e quants[]
+      = {grid_quantization_e::none, grid_quantization_e::q16, grid_quantization_e::q8};
+
+  /// sparse grid
+  {
+    std::set<std::tuple<int, int, int>> keys;
+    while (keys.size() != 300) keys.insert({(int)(rng() % 8) - 4, (int)(rng() % 8) - 4,
+                                            (int)(rng() % 8) - 4});
+    spg_t spg{tags, keys.size()};
+    {
+      auto sv = proxy<execspace_e::host>(spg);
+      for (auto &[x, y, z] : keys) {
+        const auto bno = sv._table.insert(ivec3{x, y, z} * spg_t::side_length);
+        for (int chn = 0; chn != numChns; ++chn)
+          for (int cno = 0; cno != spg_t::block_size; ++cno) sv._grid(chn, bno, cno) = 0;
+        for (int cno = 0; cno != spg_t::block_size; ++cno)
+          if (auto v = randomValue(); v != 0)
+            for (int chn = 0; chn != numChns; ++chn) sv._grid(chn, bno, cno) = v * (chn + 1);
+      }
+    }
+    auto sv = proxy<execspace_e::host>(spg);
+    for (auto quant : quants)
+      for (bool boxed : {false, true}) {
+        write_grid(pol, spg, filename, std::vector<grid_quantization_e>(numChns, quant), 16);
+        spg_t loaded{};
+        if (boxed)
+          read_grid(pol, loaded, filename, box[0], box[1]);
+        else
+          read_grid(pol, loaded, filename);
+        if (loaded.numChannels() != numChns)
+          throw std::runtime_error("sparse grid channels not restored");
+        auto lv = proxy<execspace_e::host>(loaded);
+        // the last channel spans [-4, 4]
+        check_layer(
+            "sparse grid", spg.numBlocks(), sv._table,
+            [&sv](int chn, size_t bno, int cno) { return sv._grid(chn, bno, cno); },
+            loaded.numBlocks(), lv._table,
+            [&lv](int chn, size_t bno, int cno) { return lv._grid(chn, bno, cno); }, numChns,
+            spg_t::block_size, spg_t::side_length, boxed ? box : nullptr,
+            quant_tolerance(quant, 8));
+      }
+  }
+
+  /// adaptive grid, leaf blocks plus coarse tiles
+  {
+    ag_t ag{};
+    auto allocator = get_memory_source(memsrc_e::host, -1);
+    std::set<std::tuple<int, int, int>> keys;
+    while (keys.size() != 400) keys.insert({(int)(rng() % 16) - 8, (int)(rng() % 16) - 8,
+                                            (int)(rng() % 16) - 8});
+    using leaf_t = typename ag_t::template Level<0>;
+    ag.level(wrapv<0>{}) = leaf_t{allocator, tags, keys.size()};
+    ag.level(wrapv<1>{}) = typename ag_t::template Level<1>{allocator, tags, 0};
+    ag.level(wrapv<2>{}) = typename ag_t::template Level<2>{allocator, tags, 0};
+    {
+      auto lv = proxy<execspace_e::host>(ag).level(wrapv<0>{});
+      for (auto &[x, y, z] : keys) {
+        const auto bno = lv.table.insert(ivec3{x, y, z} * (int)(leaf_t::cell_mask + 1));
+        for (int cno = 0; cno != leaf_t::block_size; ++cno) {
+          const auto v = randomValue();
+          if (v != 0) lv.valueMask[bno].setOn(cno);
+          for (int chn = 0; chn != numChns; ++chn) lv.grid(chn, bno, cno) = v * (chn + 1);
+        }
+      }
+    }
+    ag.complementTopo(pol);
+    {
+      auto agv = proxy<execspace_e::host>(ag);
+      auto l1 = agv.level(wrapv<1>{});
+      for (size_t bno = 0; bno != ag.numBlocks(wrapv<1>{}); ++bno)
+        for (int chn = 0; chn != numChns; ++chn) l1.grid(chn, bno, 0) = 0.5f * (chn + 1);
+    }
+    auto agv = proxy<execspace_e::host>(ag);
+    for (auto quant : quants)
+      for (bool boxed : {false, true}) {
+        write_grid(pol, ag, filename, std::vector<grid_quantization_e>(numChns, quant), 16);
+        ag_t loaded{};
+        if (boxed)
+          read_grid(pol, loaded, filename, box[0], box[1]);
+        else
+          read_grid(pol, loaded, filename);
+        auto lagv = proxy<execspace_e::host>(loaded);
+        const double tol = quant_tolerance(quant, 8);
+        auto checkLevel = [&](auto lNo) {
+          using level_t = typename ag_t::template Level<RM_CVREF_T(lNo)::value>;
+          auto lv = agv.level(lNo);
+          auto llv = lagv.level(lNo);
+          check_layer(
+              "adaptive grid", ag.numBlocks(lNo), lv.table,
+              [&lv](int chn, size_t bno, int cno) { return lv.grid(chn, bno, cno); },
+              loaded.numBlocks(lNo), llv.table,
+              [&llv](int chn, size_t bno, int cno) { return llv.grid(chn, bno, cno); }, numChns,
+              level_t::block_size, (int)(level_t::cell_mask + 1), boxed ? box : nullptr, tol);
+          // the topology masks are restored as well
+          for (size_t bno = 0; bno != ag.numBlocks(lNo) && !boxed; ++bno) {
+            const auto lbno = llv.table.query(lv.table._activeKeys[bno]);
+            if (std::memcmp(&lv.valueMask[bno], &llv.valueMask[lbno], sizeof(lv.valueMask[bno]))
+                || std::memcmp(&lv.childMask[bno], &llv.childMask[lbno],
+                               sizeof(lv.childMask[bno])))
+              throw std::runtime_error("adaptive grid topology not restored");
+          }
+        };
+        checkLevel(wrapv<0>{});
+        checkLevel(wrapv<1>{});
+        checkLevel(wrapv<2>{});
+      }
+  }
+  std::remove(filename.c_str());
+  return 0;
+}
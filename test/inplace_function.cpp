@@ -0,0 +1,89 @@
+#include <memory>
+#include <stdexcept>
+
+#include "zensim/ZpcFunction.hpp"
+
+namespace {
+  int g_numAlive = 0;
+  /// callable counting its live instances
+  template <size_t N> struct Counted {
+    Counted() { ++g_numAlive; }
+    Counted(const Counted &o) noexcept : value{o.value} { ++g_numAlive; }
+    Counted(Counted &&o) noexcept : value{o.value} { ++g_numAlive; }
+    ~Counted() { --g_numAlive; }
+    int operator()(int v) const { return v + value; }
+    int value{1};
+    char padding[N - sizeof(int)]{};
+  };
+  struct ThrowingMove {
+    ThrowingMove() = default;
+    ThrowingMove(const ThrowingMove &) {}
+    ThrowingMove(ThrowingMove &&) noexcept(false) {}
+    int operator()(int v) const { return v; }
+  };
+  struct MoveOnly {
+    std::unique_ptr<int> p{};
+    int operator()(int v) const { return v; }
+  };
+}  // namespace
+
+int main() {
+  using namespace zs;
+  using small_fn = inplace_function<int(int)>;
+  using unique_fn = unique_function<int(int)>;
+  using Small = Counted<8>;
+  using Big = Counted<256>;
+
+  /// callables that do not fit inline are rejected instead of failing deep inside emplace
+  static_assert(is_constructible_v<small_fn, Small>, "a small callable should fit");
+  static_assert(!is_constructible_v<small_fn, Big>, "an oversized callable should be rejected");
+  static_assert(!is_constructible_v<small_fn, ThrowingMove>,
+                "a callable with a throwing move should be rejected");
+  static_assert(is_constructible_v<unique_fn, Big>, "unique_function allocates large callables");
+  static_assert(!is_nothrow_constructible_v<Big, int *>, "not constructible is not nothrow");
+  static_assert(is_nothrow_move_constructible_v<Small>, "noexcept move should be detected");
+  static_assert(!is_nothrow_move_constructible_v<ThrowingMove>,
+                "a throwing move should be detected");
+
+  /// move-only callables
+  static_assert(is_copy_constructible_v<small_fn> && !is_copy_constructible_v<unique_fn>,
+                "only inplace_function is copyable");
+  static_assert(!is_constructible_v<small_fn, MoveOnly>,
+                "inplace_function requires copyable callables");
+  {
+    unique_fn f{[p = std::make_unique<int>(3)](int v) { return v + *p; }};
+    unique_fn g{zs::move(f)};
+    if (f || !g || g(1) != 4) throw std::runtime_error("unique_function move failed");
+    unique_fn h{};
+    h = zs::move(g);
+    if (g || h(2) != 5) throw std::runtime_error("unique_function move assignment failed");
+  }
+
+  /// every constructed callable is destroyed, inline or on the heap
+  {
+    small_fn a{Small{}}, b{Small{}};
+    if (g_numAlive != 2) throw std::runtime_error("inplace_function construction miscounted");
+    a = b;
+    if (g_numAlive != 2 || a(1) != 2) throw std::runtime_error("copy assignment leaked");
+    a = zs::move(b);
+    if (g_numAlive != 1 || b) throw std::runtime_error("move assignment leaked");
+    b = a;
+    a = Small{};
+    if (g_numAlive != 2) throw std::runtime_error("callable assignment leaked");
+    a = nullptr;
+    if (g_numAlive != 1) throw std::runtime_error("reset leaked");
+    small_fn c{b};
+    c.swap(a);
+    if (g_numAlive != 2 || c || !a) throw std::runtime_error("swap miscounted");
+  }
+  if (g_numAlive != 0) throw std::runtime_error("inplace_function leaked callables");
+  {
+    unique_fn a{Big{}}, b{Small{}};
+    a = zs::move(b);
+    b = Big{};
+    unique_fn c{zs::move(b)};
+    if (g_numAlive != 2 || c(0) != 1) throw std::runtime_error("unique_function miscounted");
+  }
+  if (g_numAlive != 0) throw std::runtime_error("unique_function leaked callables");
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <tuple>
+
+#include "utils/initialization.hpp"
+#include "zensim/simulation/transfer/P2G.hpp"
+
+int main() {
+  using namespace zs;
+  DEF_POLICY
+  using particles_t = Particles<f32, 3>;
+  using grids_t = Grids<f32, 3, 4>;
+  constexpr int side_length = grids_t::side_length;
+  const size_t n = 100000;
+  const float dx = 1.f / 128;
+
+  particles_t pars{n};
+  pars.addAttr("m", attrib_e::scalar);
+  pars.addAttr("v", attrib_e::vector);
+  pars.addAttr("C", attrib_e::matrix);
+  pars.addAttr("F", attrib_e::matrix);
+  auto &X = pars.attrVector("x");
+  auto &V = pars.attrVector("v");
+  auto &M = pars.attrScalar("m");
+  auto &C = pars.attrMatrix("C");
+  auto &F = pars.attrMatrix("F");
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> u(0, 1);
+  for (size_t i = 0; i != n; ++i) {
+    X[i] = vec<float, 3>{0.2f + 0.5f * u(rng), 0.2f + 0.5f * u(rng), 0.2f + 0.5f * u(rng)};
+    V[i] = vec<float, 3>{u(rng), u(rng), u(rng)};
+    M[i] = 1e-3f;
+    vec<float, 9> c, f{1, 0, 0, 0, 1, 0, 0, 0, 1};
+    for (int k = 0; k != 9; ++k) {
+      c[k] = 0.1f * (u(rng) - 0.5f);
+      f[k] += 0.05f * (u(rng) - 0.5f);
+    }
+    C[i] = c;
+    F[i] = f;
+  }
+
+  /// blocks touched by the stencils
+  std::set<std::tuple<int, int, int>> blockKeys;
+  for (size_t i = 0; i != n; ++i) {
+    auto arena = make_local_arena(dx, vec<float, 3>{X[i]});
+    for (auto loc : arena.range()) {
+      auto [blockKey, local] = unpack_coord_in_grid(arena.coord(loc), side_length);
+      blockKeys.insert({blockKey[0], blockKey[1], blockKey[2]});
+    }
+  }
+  /// all touched blocks except [skipped]
+  auto build = [&](HashTable<int, 3, int> &table, std::tuple<int, int, int> skipped) {
+    table.reset(pol, true);
+    auto tv = proxy<execspace_e::host>(table);
+    for (auto &[a, b, c] : blockKeys)
+      if (std::make_tuple(a, b, c) != skipped) tv.insert(vec<int, 3>{a, b, c});
+  };
+  const std::tuple<int, int, int> none{-1, -1, -1};
+  HashTable<int, 3, int> table{blockKeys.size(), memsrc_e::host, -1};
+  build(table, none);
+  const auto nbs = (size_t)table.size();
+  const std::vector<PropertyTag> tags{{"m", 1}, {"v", 3}, {"f", 3}};
+  grids_t ref{tags, dx, nbs}, blocked{tags, dx, nbs};
+  FixedCorotatedConfig model{};
+
+  using clock = std::chrono::steady_clock;
+  auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+  for (int rep = 0; rep != 3; ++rep) {
+    ref.grid().blocks.reset(0);
+    blocked.grid().blocks.reset(0);
+    auto t0 = clock::now();
+    pol(range(n), P2GTransfer{wrapv<space>{}, wrapv<transfer_scheme_e::apic>{}, 1e-4f, model,
+                              pars, table, ref});
+    auto t1 = clock::now();
+    auto numDropped = p2g_transfer_blocked(pol, wrapv<transfer_scheme_e::apic>{}, 1e-4f, model,
+                                           pars, table, blocked);
+    auto t2 = clock::now();
+    if (numDropped) throw std::runtime_error("p2g_transfer_blocked dropped contributions");
+
+    auto refv = proxy<execspace_e::host>({}, ref.grid().blocks);
+    auto blockedv = proxy<execspace_e::host>({}, blocked.grid().blocks);
+    double maxErr = 0, maxVal = 0;
+    for (size_t i = 0; i != ref.grid().blocks.size(); ++i)
+      for (int c = 0; c != 7; ++c) {
+        maxErr = std::max(maxErr, (double)std::abs(refv(c, i) - blockedv(c, i)));
+        maxVal = std::max(maxVal, (double)std::abs(refv(c, i)));
+      }
+    std::printf("P2GTransfer %.1f ms, p2g_transfer_blocked %.1f ms, max error %g (max value %g)\n",
+                ms(t1 - t0), ms(t2 - t1), maxErr, maxVal);
+    if (maxErr > 1e-5 * maxVal) throw std::runtime_error("p2g_transfer_blocked mismatch");
+  }
+
+  /// particles already in block order pass their block numbers and skip the sort
+  {
+    auto tv = proxy<execspace_e::host>(table);
+    std::vector<std::pair<u32, size_t>> order(n);
+    for (size_t i = 0; i != n; ++i) {
+      auto arena = make_local_arena(dx, vec<float, 3>{X[i]});
+      auto [blockno, local] = unpack_coord_in_grid(arena.corner, side_length, tv);
+      order[i] = {(u32)blockno, i};
+    }
+    std::stable_sort(order.begin(), order.end());
+    particles_t sorted = pars;
+    Vector<u32> sortedBlockKeys{n};
+    for (size_t i = 0; i != n; ++i) {
+      const auto j = order[i].second;
+      sortedBlockKeys[i] = order[i].first;
+      sorted.attrVector("x")[i] = X[j];
+      sorted.attrVector("v")[i] = V[j];
+      sorted.attrScalar("m")[i] = M[j];
+      sorted.attrMatrix("C")[i] = C[j];
+      sorted.attrMatrix("F")[i] = F[j];
+    }
+    blocked.grid().blocks.reset(0);
+    if (p2g_transfer_blocked(pol, wrapv<transfer_scheme_e::apic>{}, 1e-4f, model, sorted, table,
+                             blocked, &sortedBlockKeys))
+      throw std::runtime_error("presorted p2g_transfer_blocked dropped contributions");
+    auto refv = proxy<execspace_e::host>({}, ref.grid().blocks);
+    auto blockedv = proxy<execspace_e::host>({}, blocked.grid().blocks);
+    double maxErr = 0, maxVal = 0;
+    for (size_t i = 0; i != ref.grid().blocks.size(); ++i)
+      for (int c = 0; c != 7; ++c) {
+        maxErr = std::max(maxErr, (double)std::abs(refv(c, i) - blockedv(c, i)));
+        maxVal = std::max(maxVal, (double)std::abs(refv(c, i)));
+      }
+    if (maxErr > 1e-5 * maxVal)
+      throw std::runtime_error("presorted p2g_transfer_blocked mismatch");
+  }
+
+  /// a missing (+) neighbor block is reported
+  build(table, *blockKeys.rbegin());
+  grids_t partial{tags, dx, (size_t)table.size()};
+  partial.grid().blocks.reset(0);
+  auto drops = p2g_transfer_blocked(pol, wrapv<transfer_scheme_e::apic>{}, 1e-4f, model, pars,
+                                    table, partial);
+  if (drops.numHaloCells == 0 || drops.numParticles != 0)
+    throw std::runtime_error("p2g_transfer_blocked did not report dropped halo cells");
+
+  /// particles whose stencil corner block is missing are counted
+  const auto corner = [&](size_t i) {
+    auto arena = make_local_arena(dx, vec<float, 3>{X[i]});
+    auto [blockKey, local] = unpack_coord_in_grid(arena.corner, side_length);
+    return std::make_tuple(blockKey[0], blockKey[1], blockKey[2]);
+  };
+  const auto missing = corner(0);
+  size_t numOutside = 0;
+  for (size_t i = 0; i != n; ++i) numOutside += corner(i) == missing ? 1 : 0;
+  build(table, missing);
+  partial.grid().blocks.reset(0);
+  drops = p2g_transfer_blocked(pol, wrapv<transfer_scheme_e::apic>{}, 1e-4f, model, pars, table,
+                               partial);
+  std::printf("%zu of %zu particles outside of the partition\n", (size_t)drops.numParticles, n);
+  if (drops.numParticles != numOutside)
+    throw std::runtime_error("p2g_transfer_blocked miscounted the particles outside");
+  return 0;
+}
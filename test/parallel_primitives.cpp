@@ -1,3 +1,5 @@
+#include <random>
+
 #include "utils/parallel_primitives.hpp"
 
 #include "utils/initialization.hpp"
@@ -27,5 +29,48 @@ int main() {
     reduction(1024);
     reduction(2000000);
   }
+
+  /// segmented primitives, compaction and reduce_by_key
+  auto segmented = [](auto &&pol, std::mt19937 &rng, size_t n, size_t maxSegment) {
+    std::vector<i64> vals(n), maps(n);
+    for (auto &v : vals) v = (i64)(rng() % 100) - 50;
+    for (auto &v : maps)
+      v = (i64)(rng() % affine_compose::P) * affine_compose::P + (i64)(rng() % affine_compose::P);
+    // empty segments, segments spanning several threads' blocks and trailing empty segments
+    std::vector<size_t> offsets{0};
+    while (offsets.back() < n) {
+      size_t len = rng() % (maxSegment + 1);
+      if (rng() % 50 == 0) len = n / 3 + 1;
+      offsets.push_back(std::min(n, offsets.back() + len));
+    }
+    offsets.insert(offsets.end(), 3, n);
+    if (!test_segmented_primitives(pol, vals, offsets, (i64)7, plus<i64>()))
+      throw std::runtime_error("segmented plus<i64> failed");
+    if (!test_segmented_primitives(pol, maps, offsets, affine_compose::identity,
+                                   affine_compose{}))
+      throw std::runtime_error("segmented non-commutative op failed");
+    if (!test_compaction(pol, vals, [](i64 v) { return v % 3 == 0; }))
+      throw std::runtime_error("compaction failed");
+
+    // sorted keys with runs of every length, including one run crossing many blocks
+    std::vector<int> keys(n);
+    for (auto &k : keys) k = rng() % (n / 4 + 1);
+    if (rng() % 2) std::fill(keys.begin() + n / 4, keys.begin() + n / 2, -1);
+    std::sort(keys.begin(), keys.end());
+    if (!test_compaction(pol, keys, [](int k) { return k % 2 == 0; }))
+      throw std::runtime_error("compaction of sorted keys failed");
+    if (!test_reduce_by_key(pol, keys, maps, affine_compose{}))
+      throw std::runtime_error("reduce_by_key with a non-commutative op failed");
+  };
+  std::mt19937 rng(3);
+  for (size_t n : {1, 2, 5, 33, 1000, 100003})
+    for (size_t maxSegment : {0, 1, 3, 40, 5000}) {
+      segmented(seq_exec(), rng, n, maxSegment);
+#if ZS_ENABLE_OPENMP
+      // uneven thread counts leave segments and runs across block boundaries
+      for (int numThreads : {1, 2, 3, 4, 7})
+        segmented(omp_exec().threads(numThreads), rng, n, maxSegment);
+#endif
+    }
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/AnalyticLevelSet.h"
+#include "zensim/geometry/PoissonDisk.hpp"
+
+namespace {
+  using namespace zs;
+
+  template <int dim> std::vector<vec<float, dim>> gather(const TileVector<float, 32> &tv) {
+    std::vector<vec<float, dim>> xs(tv.size());
+    auto tvv = view<execspace_e::host>({}, tv);
+    for (size_t i = 0; i != xs.size(); ++i) xs[i] = tvv.template pack<dim>("x", i);
+    return xs;
+  }
+
+  /// samples are inside [ls] and no two of them are closer than [r]
+  template <int dim, typename LS>
+  void check_samples(const std::vector<vec<float, dim>> &xs, const LS &ls, float r) {
+    for (auto &x : xs)
+      if (!(ls.getSignedDistance(x) < 0))
+        throw std::runtime_error("sample outside of the level set");
+    // sweep along x, only pairs within r along x are compared
+    auto sorted = xs;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &a, const auto &b) { return a[0] < b[0]; });
+    float minDist2 = limits<float>::max();
+    for (size_t i = 0; i != sorted.size(); ++i)
+      for (size_t j = i + 1; j != sorted.size() && sorted[j][0] - sorted[i][0] < r; ++j)
+        minDist2 = std::min(minDist2, (sorted[j] - sorted[i]).l2NormSqr());
+    std::printf("%zu samples, min distance %g (radius %g)\n", xs.size(), std::sqrt(minDist2), r);
+    // samples are generated in double precision and stored as float
+    if (minDist2 < r * r * (1 - 1e-5f)) throw std::runtime_error("samples closer than the radius");
+  }
+
+  template <int dim, typename LS>
+  void test(const LS &ls, float radius, float dx, float ppc) {
+    PoissonDisk<float, dim> pd{};
+    pd.setDistanceByPpc(dx, ppc);
+    const float r = pd.minDistance;
+    // the disks of radius r around the samples of a maximal sampling cover the interior
+    const double ball = dim == 2 ? g_pi * r * r : 4. / 3 * g_pi * r * r * r;
+    const double volume
+        = dim == 2 ? g_pi * radius * radius : 4. / 3 * g_pi * radius * radius * radius;
+    const size_t minSamples = (size_t)(volume / ball);
+    const std::vector<PropertyTag> tags{{"x", dim}};
+
+    /// the samples only depend on the seed, not on the policy or the number of threads
+    TileVector<float, 32> ref{tags, 0};
+    const auto n = sample_from_levelset(seq_exec(), ls, dx, ppc, ref, 7);
+    const auto xs = gather<dim>(ref);
+    if (n != xs.size() || n < minSamples)
+      throw std::runtime_error(fmt::format("{} samples, at least {} expected", n, minSamples));
+    check_samples<dim>(xs, ls, r);
+    for (int numThreads : {1, 3, 4}) {
+      TileVector<float, 32> tv{tags, 0};
+      sample_from_levelset(omp_exec().threads(numThreads), ls, dx, ppc, tv, 7);
+      const auto ys = gather<dim>(tv);
+      if (ys.size() != xs.size())
+        throw std::runtime_error(fmt::format("{} threads: {} samples instead of {}", numThreads,
+                                             ys.size(), xs.size()));
+      for (size_t i = 0; i != xs.size(); ++i)
+        if ((ys[i] - xs[i]).l2NormSqr() != 0)
+          throw std::runtime_error(
+              fmt::format("{} threads: sample {} differs from the sequential one", numThreads, i));
+    }
+    /// another seed gives another distribution of the same quality
+    TileVector<float, 32> other{tags, 0};
+    sample_from_levelset(omp_exec(), ls, dx, ppc, other, 8);
+    const auto others = gather<dim>(other);
+    check_samples<dim>(others, ls, r);
+    auto same = [](const auto &a, const auto &b) { return (a - b).l2NormSqr() == 0; };
+    if (others.size() == xs.size() && std::equal(others.begin(), others.end(), xs.begin(), same))
+      throw std::runtime_error("different seeds gave the same samples");
+  }
+}  // namespace
+
+int main() {
+  using namespace zs;
+  test<3>(AnalyticLevelSet<analytic_geometry_e::Sphere, float, 3>{vec<float, 3>{0.5f, 0.5f, 0.5f},
+                                                                  0.3f},
+          0.3f, 1.f / 32, 8.f);
+  test<2>(AnalyticLevelSet<analytic_geometry_e::Sphere, float, 2>{vec<float, 2>{0.5f, 0.5f},
+                                                                  0.4f},
+          0.4f, 1.f / 256, 4.f);
+  return 0;
+}
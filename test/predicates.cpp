@@ -0,0 +1,130 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/geometry/Geometry.hpp"
+
+namespace {
+  using namespace zs;
+
+  int sign_of(double v) noexcept { return v > 0 ? 1 : (v < 0 ? -1 : 0); }
+
+  /// structure-of-arrays coordinates of [numPoints] points per query
+  template <typename T> struct Queries {
+    Queries(int numPoints, int dim) : coords(numPoints * dim) {}
+    void push(const std::vector<std::vector<double>> &pts) {
+      for (size_t v = 0; v != pts.size(); ++v)
+        for (size_t d = 0; d != pts[v].size(); ++d)
+          coords[v * pts[v].size() + d].push_back(pts[v][d]);
+    }
+    std::vector<std::vector<T>> coords;
+  };
+
+  /// random points, exactly degenerate ones (integer collinear/coplanar combinations) and nearly
+  /// degenerate ones (collinear/coplanar up to rounding), in equal shares
+  template <int D> std::vector<std::vector<double>> make_query(std::mt19937 &rng, int kind) {
+    std::uniform_real_distribution<double> u(-1, 1);
+    std::uniform_int_distribution<int> ui(-8, 8);
+    std::vector<std::vector<double>> pts(D + 1, std::vector<double>(D));
+    const int numFree = kind == 0 ? D + 1 : D;
+    for (int v = 0; v != numFree; ++v)
+      for (int d = 0; d != D; ++d) pts[v][d] = kind == 1 ? ui(rng) : u(rng);
+    if (kind == 0) return pts;
+    // the last point is an affine combination of the others
+    double w[D];
+    double rest = 1;
+    for (int v = 0; v != D - 1; ++v) {
+      w[v] = kind == 1 ? ui(rng) : u(rng);
+      rest -= w[v];
+    }
+    w[D - 1] = rest;
+    for (int d = 0; d != D; ++d) {
+      double c = 0;
+      for (int v = 0; v != D; ++v) c += w[v] * pts[v][d];
+      pts[D][d] = c;
+    }
+    return pts;
+  }
+
+  template <int D, typename T> void check(std::mt19937 &rng, size_t n) {
+    Queries<double> qd{D + 1, D};
+    Queries<T> qt{D + 1, D};
+    for (size_t i = 0; i != n; ++i) {
+      auto pts = make_query<D>(rng, (int)(i % 3));
+      for (auto &p : pts)
+        for (auto &c : p) c = (double)(T)c;
+      qd.push(pts);
+      qt.push(pts);
+    }
+    const double *pd[D + 1][D];
+    const T *pt[D + 1][D];
+    for (int v = 0; v != D + 1; ++v)
+      for (int d = 0; d != D; ++d) {
+        pd[v][d] = qd.coords[v * D + d].data();
+        pt[v][d] = qt.coords[v * D + d].data();
+      }
+    std::vector<double> det(n);
+    std::vector<orientation_e> ori(n);
+    size_t numAdapt = 0, numZero = 0;
+    if constexpr (D == 2) {
+      numAdapt = orient2d_lanes(n, pd[0], pd[1], pd[2], det.data());
+      orient2d(n, pt[0], pt[1], pt[2], ori.data());
+    } else {
+      numAdapt = orient3d_lanes(n, pd[0], pd[1], pd[2], pd[3], det.data());
+      orient3d(n, pt[0], pt[1], pt[2], pt[3], ori.data());
+    }
+    for (size_t i = 0; i != n; ++i) {
+      double p[D + 1][D];
+      for (int v = 0; v != D + 1; ++v)
+        for (int d = 0; d != D; ++d) p[v][d] = pd[v][d][i];
+      double ref;
+      if constexpr (D == 2)
+        ref = orient2d(p[0], p[1], p[2]);
+      else
+        ref = orient3d(p[0], p[1], p[2], p[3]);
+      if (sign_of(det[i]) != sign_of(ref) || (int)ori[i] != sign_of(ref))
+        throw std::runtime_error(fmt::format("orient{}d lanes ({}) disagree with the scalar "
+                                             "predicate on query {}: {} vs {}",
+                                             D, sizeof(T) * 8, i, det[i], ref));
+      numZero += ref == 0 ? 1 : 0;
+    }
+    std::printf("orient%dd (%zu bit): %zu queries, %zu adaptive, %zu degenerate\n", D,
+                sizeof(T) * 8, n, numAdapt, numZero);
+    if (numZero < n / 3) throw std::runtime_error("degenerate queries not detected");
+  }
+}  // namespace
+
+int main() {
+  using namespace zs;
+  std::mt19937 rng(11);
+  for (size_t n : {(size_t)1, (size_t)63, (size_t)64, (size_t)65, (size_t)10000}) {
+    check<2, double>(rng, n);
+    check<2, float>(rng, n);
+    check<3, double>(rng, n);
+    check<3, float>(rng, n);
+  }
+
+  /// callers of the batched form
+  using vec3 = vec<double, 3>;
+  const vec3 t1{0, 0, 0}, t2{1, 0, 0}, t3{0, 1, 0};
+  if (ray_triangle_intersection(vec3{0.2, 0.2, 1}, vec3{0.2, 0.2, 0}, vec3{0, 0, -1}, t1, t2, t3,
+                                false)
+      != 1)
+    throw std::runtime_error("ray through the triangle interior missed");
+  if (ray_triangle_intersection(vec3{2, 2, 1}, vec3{2, 2, 0}, vec3{0, 0, -1}, t1, t2, t3, false)
+      != 0)
+    throw std::runtime_error("ray beside the triangle hit");
+  if (point_inter_triangle(vec3{0.2, 0.2, 0}, t1, t2, t3, false, false) != 1
+      || point_inter_triangle(vec3{0.5, 0, 0}, t1, t2, t3, false, false) != 2
+      || point_inter_triangle(vec3{1, 1, 0}, t1, t2, t3, false, false) != 0)
+    throw std::runtime_error("point_inter_triangle misclassified a coplanar point");
+  if (ray_segment_intersection(vec3{0, 0, 0}, vec3{1, 0, 0}, vec3{1, 0, 0}, vec3{2, -1, 0},
+                               vec3{2, 1, 0})
+          != 1
+      || ray_segment_intersection(vec3{0, 0, 0}, vec3{1, 0, 0}, vec3{1, 0, 0}, vec3{-2, -1, 0},
+                                  vec3{-2, 1, 0})
+             != 0)
+    throw std::runtime_error("ray_segment_intersection misclassified a segment");
+  return 0;
+}
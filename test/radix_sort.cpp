@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/execution/ExecutionPolicy.hpp"
+
+#if ZS_ENABLE_OPENMP
+namespace {
+  using namespace zs;
+
+  /// sorts [keys] by the bits [sbit, ebit) and compares against std::stable_sort
+  /// @note signed keys are ordered with their sign bit flipped
+  template <typename Pol, typename K>
+  bool test_radix_sort(Pol &pol, const std::vector<K> &keys, int sbit, int ebit) {
+    using U = std::make_unsigned_t<K>;
+    constexpr int numBits = sizeof(K) * 8;
+    constexpr U signBit = std::is_signed_v<K> ? (U)1 << (numBits - 1) : (U)0;
+    const U mask = (ebit >= numBits ? ~(U)0 : (((U)1 << ebit) - 1)) & (~(U)0 << sbit);
+    const size_t n = keys.size();
+    std::vector<std::pair<U, int>> ref(n);
+    for (size_t i = 0; i != n; ++i) ref[i] = {((U)keys[i] ^ signBit) & mask, (int)i};
+    std::stable_sort(ref.begin(), ref.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    std::vector<K> in = keys, out(n), pairedOut(n);
+    std::vector<int> vals(n), valsOut(n);
+    for (size_t i = 0; i != n; ++i) vals[i] = (int)i;
+    radix_sort(pol, keys.begin(), keys.end(), out.begin(), sbit, ebit);
+    radix_sort_pair(pol, in.begin(), vals.begin(), pairedOut.begin(), valsOut.begin(), n, sbit,
+                    ebit);
+    for (size_t i = 0; i != n; ++i) {
+      if ((((U)out[i] ^ signBit) & mask) != ref[i].first) return false;
+      // pairs are sorted stably
+      if (valsOut[i] != ref[i].second || pairedOut[i] != keys[ref[i].second]) return false;
+    }
+    return true;
+  }
+
+  /// every segment is sorted, the pair variant keeps equal keys in their input order
+  template <typename Pol> bool test_segmented_sort(Pol &pol, const std::vector<int> &offsets,
+                                                   const std::vector<float> &keys) {
+    const size_t numSegments = offsets.size() - 1;
+    std::vector<float> sorted = keys, pairedKeys = keys;
+    std::vector<int> vals(keys.size());
+    for (size_t i = 0; i != vals.size(); ++i) vals[i] = (int)i;
+    pol.segmented_sort(sorted.begin(), offsets.begin(), numSegments);
+    pol.segmented_sort_pair(pairedKeys.begin(), vals.begin(), offsets.begin(), numSegments);
+    for (size_t s = 0; s != numSegments; ++s) {
+      const int st = offsets[s], ed = offsets[s + 1];
+      std::vector<std::pair<float, int>> ref(ed - st);
+      for (int j = st; j != ed; ++j) ref[j - st] = {keys[j], j};
+      std::stable_sort(ref.begin(), ref.end(),
+                       [](const auto &a, const auto &b) { return a.first < b.first; });
+      for (int j = st; j != ed; ++j)
+        if (sorted[j] != ref[j - st].first || pairedKeys[j] != ref[j - st].first
+            || vals[j] != ref[j - st].second)
+          return false;
+    }
+    return true;
+  }
+}  // namespace
+#endif
+
+int main() {
+  using namespace zs;
+#if ZS_ENABLE_OPENMP
+  // a fixed thread count keeps the large segment path reachable on any machine
+  auto pol = omp_exec().threads(4);
+  std::mt19937_64 rng(7);
+  for (size_t n : {0, 1, 5, 17, 1000, 70000, 300000}) {
+    std::vector<int> ints(n);
+    for (auto &v : ints) v = (int)rng();
+    std::vector<i64> longs(n);
+    for (auto &v : longs) v = (i64)rng();
+    // 47-bit morton codes, the upper digits are all zero
+    std::vector<u64> mortons(n);
+    for (auto &v : mortons) v = rng() & 0x7fffffffffffull;
+    // identical low and high bits, only the middle digits vary
+    std::vector<u32> middles(n);
+    for (auto &v : middles) v = (u32)(rng() % 1000) << 5 | 3;
+    std::vector<u64> constants(n, 42);
+
+    bool ok = test_radix_sort(pol, ints, 0, 32) && test_radix_sort(pol, ints, 4, 20)
+              && test_radix_sort(pol, longs, 0, 64) && test_radix_sort(pol, longs, 10, 50)
+              && test_radix_sort(pol, mortons, 0, 64) && test_radix_sort(pol, mortons, 3, 47)
+              && test_radix_sort(pol, middles, 0, 32) && test_radix_sort(pol, constants, 0, 64);
+    if (!ok) throw std::runtime_error(fmt::format("radix sort of {} keys failed", n));
+  }
+
+  std::vector<int> offsets{0};
+  std::vector<float> keys;
+  for (int s = 0; s != 5000; ++s) {
+    // empty and single element segments, and one segment above the large size (a quarter of
+    // all keys with four threads)
+    int len = s % 100 == 0 ? 0 : (s % 100 == 1 ? 1 : (int)(rng() % 40));
+    if (s == 77) len = 100000;
+    // few distinct keys, so that stability is observable
+    for (int j = 0; j != len; ++j) keys.push_back((float)(rng() % 100));
+    offsets.push_back((int)keys.size());
+  }
+  if (!test_segmented_sort(pol, offsets, keys))
+    throw std::runtime_error("segmented sort failed");
+#endif
+  return 0;
+}
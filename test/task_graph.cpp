@@ -0,0 +1,104 @@
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "zensim/execution/TaskGraph.hpp"
+
+int main() {
+  using namespace zs;
+  TaskScheduler scheduler{3};
+
+  /// a random dag, every task starts after all of its predecessors finished
+  {
+    constexpr int n = 200;
+    std::mt19937 rng(7);
+    std::vector<std::vector<int>> preds(n);
+    std::vector<std::atomic<int>> finished(n);
+    std::atomic<int> numViolations{0};
+    TaskGraph graph{};
+    std::vector<TaskHandle> tasks;
+    for (int i = 0; i != n; ++i) {
+      finished[i] = 0;
+      tasks.push_back(graph.emplace([&, i]() {
+        for (int p : preds[i])
+          if (finished[p].load() != finished[i].load() + 1) numViolations.fetch_add(1);
+        finished[i].fetch_add(1);
+      }));
+    }
+    for (int i = 1; i != n; ++i)
+      for (int k = rng() % 4; k != 0; --k) {
+        const int p = rng() % i;
+        preds[i].push_back(p);
+        tasks[p].precede(tasks[i]);
+      }
+    /// the same graph runs repeatedly
+    for (int rep = 0; rep != 3; ++rep) graph.run(scheduler);
+    if (numViolations.load()) throw std::runtime_error("task graph ran a task before its inputs");
+    for (int i = 0; i != n; ++i)
+      if (finished[i].load() != 3) throw std::runtime_error("task graph did not rerun every task");
+  }
+
+  /// loops recorded through a policy keep their order
+  {
+    constexpr size_t n = 100000;
+    std::vector<int> a(n), b(n);
+    std::atomic<long long> sum{0};
+    TaskGraph graph{};
+    auto pol = graph.policy();
+    pol(range(n), [&](size_t i) { a[i] = (int)i; });
+    pol.grain(1000);
+    pol(range(n), [&](size_t i) { b[i] = 2 * a[i]; });
+    auto first = pol.last();
+    auto reducer = graph.policy(pol);
+    reducer(range(n), [&](size_t i) { sum.fetch_add(b[i], std::memory_order_relaxed); });
+    if (reducer.last().num_predecessors() != 1 || first.num_successors() != 1)
+      throw std::runtime_error("task graph policy did not link the loops");
+    graph.run(scheduler);
+    if (sum.load() != (long long)n * (n - 1))
+      throw std::runtime_error("task graph policy loops overlapped");
+  }
+
+  /// the first exception is rethrown, successors are skipped and the graph stays reusable
+  {
+    std::atomic<bool> shouldThrow{true};
+    std::atomic<int> numSuccessors{0};
+    TaskGraph graph{};
+    auto thrower = graph.emplace([&]() {
+      if (shouldThrow.load()) throw std::runtime_error("expected failure");
+    });
+    auto successor = graph.emplace([&]() { numSuccessors.fetch_add(1); });
+    thrower.precede(successor);
+    std::string what{};
+    try {
+      graph.run(scheduler);
+    } catch (const std::runtime_error &e) {
+      what = e.what();
+    }
+    if (what != "expected failure") throw std::runtime_error("task exception was not rethrown");
+    if (numSuccessors.load() != 0) throw std::runtime_error("successor of a failed task ran");
+    if (!graph.done()) throw std::runtime_error("failed task graph did not complete");
+    shouldThrow = false;
+    graph.run(scheduler);
+    if (numSuccessors.load() != 1) throw std::runtime_error("task graph not reusable after error");
+  }
+
+  /// graphs without a source task are rejected
+  {
+    TaskGraph graph{};
+    auto a = graph.emplace([]() {});
+    auto b = graph.emplace([]() {});
+    a.precede(b);
+    b.precede(a);
+    bool rejected = false;
+    try {
+      graph.run(scheduler);
+    } catch (const std::runtime_error &) {
+      rejected = true;
+    }
+    if (!rejected) throw std::runtime_error("cyclic task graph was not rejected");
+  }
+  return 0;
+}
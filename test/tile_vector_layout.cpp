@@ -0,0 +1,73 @@
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVectorLayout.hpp"
+
+int main() {
+  using namespace zs;
+  const std::vector<PropertyTag> tags{{"x", 3}, {"m", 1}, {"id", 1}};
+  constexpr int numChns = 5;
+  auto value = [](size_t i, int chn) { return (float)(i * numChns + chn); };
+
+  auto test = [&](auto &&pol, size_t n) {
+    TileVector<float, 8> tv{tags, n};
+    {
+      auto tvv = view<execspace_e::host>({}, tv);
+      for (size_t i = 0; i != n; ++i)
+        for (int chn = 0; chn != numChns; ++chn) tvv(chn, i) = value(i, chn);
+    }
+    /// every channel of every element keeps its value
+    auto check = [&](const auto &res, const char *msg) {
+      if (res.size() != n || res.numChannels() != numChns)
+        throw std::runtime_error(fmt::format("{}: wrong shape for {} elements", msg, n));
+      auto rv = view<execspace_e::host>({}, res);
+      for (size_t i = 0; i != n; ++i)
+        for (int chn = 0; chn != numChns; ++chn)
+          if (rv(chn, i) != value(i, chn))
+            throw std::runtime_error(
+                fmt::format("{}: channel {} of element {} (of {}) changed", msg, chn, i, n));
+    };
+
+    /// copying retile, also converting the value type
+    auto wide = retile<32, double>(pol, tv);
+    check(wide, "copying retile");
+    check(tv, "copying retile source");
+
+    /// in-place retile 8 -> 32 and back
+    auto tv32 = retile<32>(pol, zs::move(tv));
+    if (tv.size() != 0) throw std::runtime_error("in-place retile left its source populated");
+    check(tv32, "in-place retile 8 -> 32");
+    auto tv8 = retile<8>(pol, zs::move(tv32));
+    check(tv8, "in-place retile 32 -> 8");
+    auto tv12 = retile<12>(pol, zs::move(tv8));
+    check(tv12, "in-place retile 8 -> 12");
+
+    /// a property to an AoS array and back, and between tile vectors of other lane widths
+    Vector<vec<float, 3>> xs{0};
+    copy_property(pol, tv12, "x", xs);
+    if (xs.size() != n) throw std::runtime_error("copy_property did not resize the array");
+    for (size_t i = 0; i != n; ++i)
+      for (int d = 0; d != 3; ++d)
+        if (xs[i][d] != value(i, d)) throw std::runtime_error("copy_property to AoS failed");
+    TileVector<double, 32> dst{{{"id", 1}, {"x", 3}}, 0};
+    copy_property(pol, xs, dst, "x");
+    copy_properties(pol, tv12, dst, {"id"});
+    auto dv = view<execspace_e::host>({}, dst);
+    for (size_t i = 0; i != n; ++i) {
+      if (dv("id", i) != value(i, 4)) throw std::runtime_error("copy_properties failed");
+      for (int d = 0; d != 3; ++d)
+        if (dv("x", d, i) != value(i, d)) throw std::runtime_error("copy_property from AoS failed");
+    }
+    /// a property to an external SoA buffer
+    std::vector<float> soa(n * 3);
+    copy_property(pol, tv12, "x", make_soa_layout(soa.data(), 3, n));
+    for (size_t i = 0; i != n; ++i)
+      for (int d = 0; d != 3; ++d)
+        if (soa[d * n + i] != value(i, d)) throw std::runtime_error("copy_property to SoA failed");
+  };
+  for (size_t n : {(size_t)0, (size_t)5, (size_t)1000, (size_t)100003}) {
+    test(seq_exec(), n);
+    test(omp_exec(), n);
+  }
+  return 0;
+}
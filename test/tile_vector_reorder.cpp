@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "utils/initialization.hpp"
+#include "zensim/container/TileVectorReorder.hpp"
+
+int main() {
+  using namespace zs;
+
+  /// the hilbert curve visits every cell of an 8^3 grid once, moving to a face neighbor
+  {
+    std::vector<std::pair<u64, int>> cells;
+    for (int x = 0; x != 8; ++x)
+      for (int y = 0; y != 8; ++y)
+        for (int z = 0; z != 8; ++z)
+          cells.push_back({hilbert_3d_index_64(x, y, z, 3), x * 64 + y * 8 + z});
+    std::sort(cells.begin(), cells.end());
+    for (int i = 0; i != 512; ++i) {
+      if (cells[i].first != (u64)i) throw std::runtime_error("hilbert keys are not a bijection");
+      if (i == 0) continue;
+      const int a = cells[i - 1].second, b = cells[i].second;
+      if (std::abs(a / 64 - b / 64) + std::abs(a / 8 % 8 - b / 8 % 8) + std::abs(a % 8 - b % 8)
+          != 1)
+        throw std::runtime_error("consecutive hilbert cells are not adjacent");
+    }
+  }
+
+  std::mt19937 rng(5);
+  auto test = [&rng](auto &&pol, size_t n, sfc_e curve) {
+    constexpr bool isSequential = RM_REF_T(pol)::exec_tag::value == execspace_e::host;
+    TileVector<float, 32> pars{{{"x", 3}, {"v", 3}, {"id", 1}}, n};
+    // reordering reallocates the channels, views are taken anew afterwards
+    auto pv = view<execspace_e::host>({}, pars);
+    for (size_t i = 0; i != n; ++i) {
+      for (int d = 0; d != 3; ++d) {
+        pv("x", d, i) = (rng() % 100000) / 1000.f;
+        pv("v", d, i) = (float)d;
+      }
+      pv("id", i) = (float)i;
+    }
+    Vector<u64> keys{n};
+    Vector<int> newToOld{n}, oldToNew{n};
+    /// newToOld is the stable sorting permutation, oldToNew its inverse, all channels follow
+    auto check = [&](const TileVector<float, 32> &tv, const Vector<u64> &sortedKeys,
+                     const std::vector<u64> &prevKeys) {
+      std::vector<int> ref(n);
+      for (size_t i = 0; i != n; ++i) ref[i] = (int)i;
+      std::stable_sort(ref.begin(), ref.end(),
+                       [&](int a, int b) { return prevKeys[a] < prevKeys[b]; });
+      auto tvv = view<execspace_e::host>({}, tv);
+      for (size_t i = 0; i != n; ++i)
+        if (newToOld[i] != ref[i] || oldToNew[newToOld[i]] != (int)i
+            || tvv("id", i) != (float)newToOld[i] || tvv("v", 2, i) != 2.f
+            || sortedKeys[i] != prevKeys[newToOld[i]])
+          throw std::runtime_error("reorder_by_keys produced a wrong permutation");
+    };
+
+    // full sort of random positions, coarse cells share keys so that stability is observable
+    compute_sfc_keys(pol, pars, "x", vec<float, 3>{0, 0, 0}, 4.f, keys, curve);
+    std::vector<u64> prevKeys(keys.begin(), keys.end());
+    reorder_by_keys(pol, pars, keys, newToOld, oldToNew);
+    check(pars, keys, prevKeys);
+    // sorted keys leave the elements in place
+    if (isSequential && n != 0 && reorder_by_keys(pol, pars, keys, newToOld, oldToNew))
+      throw std::runtime_error("reorder_by_keys moved already sorted elements");
+    pv = view<execspace_e::host>({}, pars);
+    for (size_t i = 0; i != n; ++i) pv("id", i) = (float)i;
+
+    // small motion, the incremental merge and the full sort agree
+    for (size_t i = 0; i != n; ++i)
+      for (int d = 0; d != 3; ++d) pv("x", d, i) += ((int)(rng() % 21) - 10) * 1e-3f;
+    compute_sfc_keys(pol, pars, "x", vec<float, 3>{0, 0, 0}, 4.f, keys, curve);
+    prevKeys.assign(keys.begin(), keys.end());
+    auto fullKeys = keys.clone(keys.get_allocator());
+    auto fullPars = pars.clone(pars.get_allocator());
+    reorder_by_keys(pol, fullPars, fullKeys, newToOld, oldToNew, false);
+    check(fullPars, fullKeys, prevKeys);
+    reorder_by_keys(pol, pars, keys, newToOld, oldToNew, true);
+    check(pars, keys, prevKeys);
+  };
+  for (size_t n : {0, 1, 100, 200003})
+    for (auto curve : {sfc_e::morton, sfc_e::hilbert}) {
+      test(seq_exec(), n, curve);
+#if ZS_ENABLE_OPENMP
+      test(omp_exec().threads(4), n, curve);
+#endif
+    }
+  return 0;
+}
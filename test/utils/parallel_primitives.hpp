@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <vector>
+
 #include "zensim/ZpcBuiltin.hpp"
 #include "zensim/execution/ExecutionPolicy.hpp"
 
@@ -32,4 +35,87 @@ namespace zs {
     return 0;
   }
 
+  /// affine maps x -> a * x + b (mod P) stored as a * P + b, composition is associative but not
+  /// commutative, [identity] is x -> x
+  struct affine_compose {
+    static constexpr i64 P = 10007;
+    static constexpr i64 identity = P;
+    constexpr i64 operator()(i64 f, i64 g) const noexcept {
+      const i64 a1 = f / P, b1 = f % P, a2 = g / P, b2 = g % P;
+      return (a1 * a2 % P) * P + (b1 * a2 + b2) % P;
+    }
+  };
+
+  /// segmented reduce and scans of [policy] against the sequential policy, in-place included
+  template <typename Pol, typename T, typename Op>
+  bool test_segmented_primitives(Pol &&policy, const std::vector<T> &vals,
+                                 const std::vector<size_t> &offsets, T init, Op op) {
+    auto seq = seq_exec();
+    const size_t n = vals.size(), ns = offsets.size() - 1;
+    std::vector<T> ref(ns), res(ns);
+    seq.segmented_reduce(vals.begin(), offsets.begin(), ns, ref.begin(), init, op);
+    segmented_reduce(policy, vals.begin(), offsets.begin(), ns, res.begin(), init, op);
+    if (ref != res) return false;
+
+    ref.resize(n);
+    res.resize(n);
+    std::vector<T> inplace = vals;
+    seq.segmented_inclusive_scan(vals.begin(), offsets.begin(), ns, ref.begin(), op);
+    segmented_inclusive_scan(policy, vals.begin(), offsets.begin(), ns, res.begin(), op);
+    segmented_inclusive_scan(policy, inplace.begin(), offsets.begin(), ns, inplace.begin(), op);
+    if (ref != res || ref != inplace) return false;
+
+    inplace = vals;
+    seq.segmented_exclusive_scan(vals.begin(), offsets.begin(), ns, ref.begin(), init, op);
+    segmented_exclusive_scan(policy, vals.begin(), offsets.begin(), ns, res.begin(), init, op);
+    segmented_exclusive_scan(policy, inplace.begin(), offsets.begin(), ns, inplace.begin(), init,
+                             op);
+    return ref == res && ref == inplace;
+  }
+
+  /// copy_if, partition_copy, partition and unique against std algorithms
+  template <typename Pol, typename T, typename Pred>
+  bool test_compaction(Pol &&policy, const std::vector<T> &vals, Pred pred) {
+    const size_t n = vals.size();
+    std::vector<T> ref(n), res(n), rejected(n);
+    size_t cnt = std::copy_if(vals.begin(), vals.end(), ref.begin(), pred) - ref.begin();
+    if (copy_if(policy, vals.begin(), vals.end(), res.begin(), pred) != cnt
+        || !std::equal(ref.begin(), ref.begin() + cnt, res.begin()))
+      return false;
+    auto refRejected = ref;
+    std::remove_copy_if(vals.begin(), vals.end(), refRejected.begin(), pred);
+    if (partition_copy(policy, vals.begin(), vals.end(), res.begin(), rejected.begin(), pred) != cnt
+        || !std::equal(ref.begin(), ref.begin() + cnt, res.begin())
+        || !std::equal(refRejected.begin(), refRejected.begin() + (n - cnt), rejected.begin()))
+      return false;
+    ref = vals;
+    std::stable_partition(ref.begin(), ref.end(), pred);
+    if (partition(policy, vals.begin(), vals.end(), res.begin(), pred) != cnt || ref != res)
+      return false;
+    ref = vals;
+    cnt = std::unique(ref.begin(), ref.end()) - ref.begin();
+    return unique(policy, vals.begin(), vals.end(), res.begin()) == cnt
+           && std::equal(ref.begin(), ref.begin() + cnt, res.begin());
+  }
+
+  /// unique_by_key and reduce_by_key of [policy] against the sequential policy
+  template <typename Pol, typename K, typename T, typename Op>
+  bool test_reduce_by_key(Pol &&policy, const std::vector<K> &keys, const std::vector<T> &vals,
+                          Op op) {
+    auto seq = seq_exec();
+    const size_t n = keys.size();
+    std::vector<K> refKeys(n), resKeys(n);
+    std::vector<T> refVals(n), resVals(n);
+    size_t cnt = seq.unique_by_key(keys.begin(), vals.begin(), n, refKeys.begin(), refVals.begin());
+    if (unique_by_key(policy, keys.begin(), vals.begin(), n, resKeys.begin(), resVals.begin())
+            != cnt
+        || refKeys != resKeys || refVals != resVals)
+      return false;
+    cnt = seq.reduce_by_key(keys.begin(), vals.begin(), n, refKeys.begin(), refVals.begin(), op);
+    return reduce_by_key(policy, keys.begin(), vals.begin(), n, resKeys.begin(), resVals.begin(),
+                         op)
+               == cnt
+           && refKeys == resKeys && refVals == resVals;
+  }
+
 }  // namespace zs
\ No newline at end of file